@@ -40,9 +40,13 @@ static hpx_action_t _op;
 static int _op_handler(double *lu, int i, double h2, hpx_addr_t u, hpx_addr_t f) {
   double left, right, lf;
 
-  hpx_gas_memget_sync(&left, IDX(u,i-1), sizeof(left));
-  hpx_gas_memget_sync(&right, IDX(u,i+1), sizeof(right));
-  hpx_gas_memget_sync(&lf, IDX(f,i), sizeof(lf));
+  // gather the stencil with a single operation
+  hpx_gas_iovec_t iov[] = {
+    { &left, IDX(u,i-1), sizeof(left) },
+    { &right, IDX(u,i+1), sizeof(right) },
+    { &lf, IDX(f,i), sizeof(lf) }
+  };
+  hpx_gas_memget_vec_sync(iov, 3);
   *lu = left + right + h2*lf/2;
   return HPX_SUCCESS;
 }
@@ -25,6 +25,7 @@
 
 static void _usage(FILE *stream, int error) {
   fprintf(stream, "Usage: seqspawn [options] NUMBER\n"
+          "\t-i, spawn interrupts instead of threads\n"
           "\t-h, this help display\n");
   hpx_print_help();
   fflush(stream);
@@ -32,6 +33,7 @@ static void _usage(FILE *stream, int error) {
 }
 
 static hpx_action_t _nop  = 0;
+static hpx_action_t _nop_interrupt = 0;
 static hpx_action_t _main = 0;
 
 /// The empty action
@@ -40,13 +42,14 @@ static int _nop_action(hpx_addr_t *args, size_t size) {
 }
 
 static int _main_action(int *args, size_t size) {
-  int n = *args;
+  int n = args[0];
+  hpx_action_t nop = (args[1]) ? _nop_interrupt : _nop;
   printf("seqspawn(%d)\n", n); fflush(stdout);
 
   hpx_addr_t and = hpx_lco_and_new(n);
   hpx_time_t now = hpx_time_now();
   for (int i = 0; i < n; i++)
-    hpx_call(HPX_HERE, _nop, and, 0, 0);
+    hpx_call(HPX_HERE, nop, and, 0, 0);
   hpx_lco_wait(and);
   double elapsed = hpx_time_elapsed_ms(now)/1e3;
   hpx_lco_delete(and, HPX_NULL);
@@ -63,6 +66,7 @@ int main(int argc, char *argv[]) {
 
   // register the actions
   HPX_REGISTER_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _nop, _nop_action, HPX_POINTER, HPX_SIZE_T);
+  HPX_REGISTER_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _nop_interrupt, _nop_action, HPX_POINTER, HPX_SIZE_T);
   HPX_REGISTER_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _main, _main_action, HPX_POINTER, HPX_SIZE_T);
 
   if (hpx_init(&argc, &argv)) {
@@ -70,9 +74,13 @@ int main(int argc, char *argv[]) {
     return -1;
   }
 
+  int interrupts = 0;
   int opt = 0;
-  while ((opt = getopt(argc, argv, "h?")) != -1) {
+  while ((opt = getopt(argc, argv, "ih?")) != -1) {
     switch (opt) {
+     case 'i':
+       interrupts = 1;
+       break;
      case 'h':
        _usage(stdout, EXIT_SUCCESS);
      case '?':
@@ -96,7 +104,8 @@ int main(int argc, char *argv[]) {
   }
 
   // run the main action
-  int e = hpx_run(&_main, &n, sizeof(n));
+  int args[2] = { n, interrupts };
+  int e = hpx_run(&_main, args, sizeof(args));
   hpx_finalize();
   return e;
 }
@@ -47,6 +47,14 @@ typedef int (*hpx_vectored_action_handler_t)(int, void*, size_t *);
 /// The type of functions that can be registered with pinned vectored actions.
 typedef int (*hpx_pinned_vectored_action_handler_t)(void *, int, void*, size_t *);
 
+/// The type of trampolines that can be registered with typed actions. The
+/// first parameter is the function that was registered with the trampoline.
+typedef int (*hpx_typed_action_handler_t)(void (*)(void), void*, size_t);
+
+/// The type of trampolines that can be registered with pinned typed actions.
+typedef int (*hpx_pinned_typed_action_handler_t)(void (*)(void), void *, void*,
+                                                 size_t);
+
 /// The equivalent of NULL for HPX actions.
 #define HPX_ACTION_NULL ((hpx_action_t)0u)
 
@@ -87,6 +95,8 @@ typedef enum {
 #define HPX_COALESCED 0x10
 // Action is a compressed action
 #define HPX_COMPRESSED 0x20
+// Action is a compiled trampoline for a function with known argument types
+#define HPX_TYPED      0x40
 //@}
 
 /// Register an HPX action of a given @p type.
@@ -14,6 +14,8 @@
 #ifndef HPX_CXX_ACTION_H
 #define HPX_CXX_ACTION_H
 
+#include <algorithm>
+#include <cstring>
 #include <type_traits>
 
 #include <hpx/addr.h>
@@ -91,6 +93,79 @@ struct _convert_arg_type<T*> {
 template <typename T>
 constexpr decltype(HPX_POINTER) _convert_arg_type<T*>::type;
 
+/// The type that we send over the wire for an argument of type T.
+template <typename T>
+struct _wire {
+  using type = T;
+  static const T& pack(const T& t) { return t; }
+  static const T& unpack(const T& t) { return t; }
+};
+
+// global pointers are sent as their address, just like HPX_ADDR
+template <typename T>
+struct _wire< hpx::global_ptr<T> > {
+  using type = hpx_addr_t;
+  static hpx_addr_t pack(const hpx::global_ptr<T>& gp) { return gp.get(); }
+  static hpx::global_ptr<T> unpack(hpx_addr_t addr) {
+    return hpx::global_ptr<T>(addr);
+  }
+};
+
+/// The packed arguments of a typed action.
+///
+/// Each argument is stored in its own 8-byte aligned slot, which is the layout
+/// that libhpx uses when it packs the arguments of an HPX_TYPED action.
+template <typename... Ts>
+struct _packed {
+};
+
+template <typename T, typename... Ts>
+struct _packed<T, Ts...> {
+  using wire = _wire<T>;
+  static_assert(std::is_trivially_copyable<typename wire::type>::value,
+                "typed action arguments must be trivially copyable");
+  static_assert(alignof(typename wire::type) <= 8,
+                "typed action arguments must be at most 8-byte aligned");
+
+  alignas(8) typename wire::type head;
+  _packed<Ts...> tail;
+};
+
+// unpack the arguments and call the function
+template <typename F, typename... Done>
+int _apply(F f, const _packed<>&, Done&&... done) {
+  return f(std::forward<Done>(done)...);
+}
+
+template <typename F, typename T, typename... Ts, typename... Done>
+int _apply(F f, const _packed<T, Ts...>& p, Done&&... done) {
+  return _apply(f, p.tail, std::forward<Done>(done)...,
+                _packed<T, Ts...>::wire::unpack(p.head));
+}
+
+/// The trampoline that the action table invokes for a typed action.
+///
+/// The parcel buffer may be shorter than the packed arguments when it was
+/// produced by a raw continuation of a single value, so we copy what we got
+/// into a local argument struct.
+template <typename R, typename... Args>
+int _typed_trampoline(void (*f)(void), void *args, size_t n) {
+  _packed<typename std::decay<Args>::type...> packed;
+  std::memcpy(&packed, args, std::min(n, sizeof(packed)));
+  return _apply(reinterpret_cast<R(*)(Args...)>(f), packed);
+}
+
+/// The trampoline for a pinned typed action, @p target is the pinned pointer
+/// passed as the first argument.
+template <typename R, typename P, typename... Args>
+int _pinned_typed_trampoline(void (*f)(void), void *target, void *args,
+                             size_t n) {
+  _packed<typename std::decay<Args>::type...> packed;
+  std::memcpy(&packed, args, std::min(n, sizeof(packed)));
+  return _apply(reinterpret_cast<R(*)(P, Args...)>(f), packed,
+                static_cast<P>(target));
+}
+
 } // namespace detail
 } // namspace hpx
 
@@ -121,13 +196,39 @@ private:
   hpx_action_t _id;
   bool _is_registerd;
 
+  static_assert(!(ATTR & (HPX_MARSHALLED | HPX_VECTORED)),
+                "C++ actions can not be marshalled or vectored");
+
+  // Typed actions are registered with a trampoline generated for the exact
+  // signature of @p f, which bypasses libffi on both ends of the call.
   template <typename R, typename... Args>
-  int _register_helper(R(&f)(Args...)) {
-    return hpx_register_action(HPX_DEFAULT, HPX_ATTR_NONE, __FILE__ ":" _HPX_XSTR(_id),
-                               &(_id), sizeof...(Args) + 1 , f,
+  int _register_helper(R(&f)(Args...), std::false_type) {
+    hpx_typed_action_handler_t trampoline =
+      hpx::detail::_typed_trampoline<R, Args...>;
+    return hpx_register_action(TYPE, ATTR | HPX_TYPED, __FILE__ ":" _HPX_XSTR(_id),
+                               &(_id), sizeof...(Args) + 2, trampoline,
+                               reinterpret_cast<void (*)(void)>(&f),
+                               hpx::detail::_convert_arg_type<Args>::type...);
+  }
+
+  template <typename R, typename P, typename... Args>
+  int _register_helper(R(&f)(P, Args...), std::true_type) {
+    static_assert(std::is_pointer<P>::value,
+                  "first argument of a pinned action must be a pointer");
+    hpx_pinned_typed_action_handler_t trampoline =
+      hpx::detail::_pinned_typed_trampoline<R, P, Args...>;
+    return hpx_register_action(TYPE, ATTR | HPX_TYPED, __FILE__ ":" _HPX_XSTR(_id),
+                               &(_id), sizeof...(Args) + 3, trampoline,
+                               reinterpret_cast<void (*)(void)>(&f), HPX_POINTER,
                                hpx::detail::_convert_arg_type<Args>::type...);
   }
 
+  template <typename R, typename... Args>
+  int _register_helper(R(&f)(Args...)) {
+    using pinned = std::integral_constant<bool, (ATTR & HPX_PINNED) != 0>;
+    return _register_helper(f, pinned());
+  }
+
 public:
 
   Action() : _is_registerd(false) {}
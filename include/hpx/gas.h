@@ -39,6 +39,14 @@ typedef enum {
 extern HPX_PUBLIC const uint64_t HPX_GAS_BLOCK_BYTES_MAX;
 
 /// User-defined GAS distribution function.
+///
+/// A user-defined distribution maps block @p i of an @p n block allocation
+/// with @p bsize bytes per block to a global address. The block is placed at
+/// the locality that owns that address (e.g., HPX_THERE(rank) for a specific
+/// locality). The function is evaluated at the allocating locality during
+/// hpx_gas_alloc(), and the returned global address supports the same
+/// address arithmetic as a cyclic allocation. Global address spaces that can't
+/// place individual blocks (PGAS) use a cyclic distribution instead.
 typedef hpx_addr_t (*hpx_gas_dist_t)(uint32_t i, size_t n, uint32_t bsize);
 
 #define HPX_GAS_DIST_LOCAL   (hpx_gas_dist_t)HPX_DIST_TYPE_LOCAL
@@ -490,6 +498,111 @@ int hpx_gas_memcpy(hpx_addr_t to, hpx_addr_t from, size_t size, hpx_addr_t sync)
 int hpx_gas_memcpy_sync(hpx_addr_t to, hpx_addr_t from, size_t size)
   HPX_PUBLIC;
 
+/// A region for the vectored memget and memput operations.
+///
+/// Each region pairs a local buffer with a global address range of the same
+/// size. As with hpx_gas_memget() and hpx_gas_memput(), the global range must
+/// be within a single block, and the local buffer must be a stack location or
+/// an address allocated with hpx_malloc_registered().
+typedef struct {
+  void        *local;                   //!< the local buffer
+  hpx_addr_t  global;                   //!< the global address
+  size_t        size;                   //!< the number of bytes to copy
+} hpx_gas_iovec_t;
+
+/// This gathers data from a list of global regions into local buffers,
+/// asynchronously.
+///
+/// This has the same semantics as performing an hpx_gas_memget() for each of
+/// the regions in @p iov, except that there is only one completion event for
+/// the whole list, and the network may batch the operations. The regions may
+/// be owned by different localities. The @p iov array itself is not referenced
+/// after this call returns.
+///
+/// @param          iov The regions to copy.
+/// @param            n The number of regions in @p iov.
+/// @param        lsync The address of a zero-sized future that can be used to
+///                       wait for completion of all of the memgets.
+///
+/// @returns HPX_SUCCESS
+int hpx_gas_memget_vec(const hpx_gas_iovec_t *iov, int n, hpx_addr_t lsync)
+  HPX_PUBLIC;
+
+/// Synchronous interface to memget_vec.
+int hpx_gas_memget_vec_sync(const hpx_gas_iovec_t *iov, int n) HPX_PUBLIC;
+
+/// This scatters data from local buffers to a list of global regions,
+/// asynchronously.
+///
+/// This has the same semantics as performing an hpx_gas_memput() for each of
+/// the regions in @p iov, except that there is only one local and one remote
+/// completion event for the whole list. The local buffers are only read.
+///
+/// @param          iov The regions to copy.
+/// @param            n The number of regions in @p iov.
+/// @param        lsync The address of a zero-sized future that can be used to
+///                       wait for local completion of all of the memputs.
+/// @param        rsync The address of a zero-sized future that can be used to
+///                       wait for remote completion of all of the memputs.
+///
+/// @returns  HPX_SUCCESS
+int hpx_gas_memput_vec(const hpx_gas_iovec_t *iov, int n, hpx_addr_t lsync,
+                       hpx_addr_t rsync)
+  HPX_PUBLIC;
+
+/// Fully synchronous interface to memput_vec.
+int hpx_gas_memput_vec_rsync(const hpx_gas_iovec_t *iov, int n) HPX_PUBLIC;
+
+/// This gathers a strided pattern of global regions into a strided local
+/// buffer, asynchronously.
+///
+/// Region i is the @p size bytes at hpx_addr_add(from, i * @p from_stride,
+/// @p bsize), which is copied to @p to + i * @p to_stride. Each region must be
+/// within a single block. This is equivalent to hpx_gas_memget_vec() with the
+/// corresponding list of regions.
+///
+/// @param           to The local address of the first region.
+/// @param    to_stride The local stride between regions, in bytes.
+/// @param         from The global address of the first region.
+/// @param  from_stride The global stride between regions, in bytes.
+/// @param         size The size of each region, in bytes.
+/// @param        count The number of regions.
+/// @param        bsize The block size of the allocation that @p from is in.
+/// @param        lsync The address of a zero-sized future that can be used to
+///                       wait for completion of all of the memgets.
+///
+/// @returns HPX_SUCCESS
+int hpx_gas_memget_strided(void *to, size_t to_stride, hpx_addr_t from,
+                           size_t from_stride, size_t size, int count,
+                           uint32_t bsize, hpx_addr_t lsync)
+  HPX_PUBLIC;
+
+/// This scatters a strided local buffer to a strided pattern of global
+/// regions, asynchronously.
+///
+/// Region i is the @p size bytes at @p from + i * @p from_stride, which is
+/// copied to hpx_addr_add(to, i * @p to_stride, @p bsize). Each region must be
+/// within a single block. This is equivalent to hpx_gas_memput_vec() with the
+/// corresponding list of regions.
+///
+/// @param           to The global address of the first region.
+/// @param    to_stride The global stride between regions, in bytes.
+/// @param         from The local address of the first region.
+/// @param  from_stride The local stride between regions, in bytes.
+/// @param         size The size of each region, in bytes.
+/// @param        count The number of regions.
+/// @param        bsize The block size of the allocation that @p to is in.
+/// @param        lsync The address of a zero-sized future that can be used to
+///                       wait for local completion of all of the memputs.
+/// @param        rsync The address of a zero-sized future that can be used to
+///                       wait for remote completion of all of the memputs.
+///
+/// @returns  HPX_SUCCESS
+int hpx_gas_memput_strided(hpx_addr_t to, size_t to_stride, const void *from,
+                           size_t from_stride, size_t size, int count,
+                           uint32_t bsize, hpx_addr_t lsync, hpx_addr_t rsync)
+  HPX_PUBLIC;
+
 /// GAS collectives (hpx_gas_bcast_with_continuation).
 ///
 /// This is a parallel call (bcast) that performs an @p action with @p
@@ -309,6 +309,92 @@ int hpx_lco_get_all(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
                     hpx_status_t statuses[])
   HPX_PUBLIC;
 
+/// An opaque set of LCOs that can be drained in completion order.
+typedef struct hpx_lco_any hpx_lco_any_t;
+
+/// Start watching a set of LCOs for completion.
+///
+/// This registers a lightweight trigger with each of the LCOs, it does not
+/// block or create a waiting thread per LCO. Entries in @p lcos that are
+/// HPX_NULL are ignored. The LCOs must remain allocated until the set has been
+/// deleted.
+///
+/// @param             n the number of LCOs in @p lcos
+/// @param          lcos an array of @p n global LCO addresses
+///
+/// @returns             the new completion set
+hpx_lco_any_t *hpx_lco_any_new(int n, hpx_addr_t lcos[])
+  HPX_PUBLIC;
+
+/// Wait for the next LCO in a completion set to be set.
+///
+/// Each call returns the index (into the array passed to hpx_lco_any_new()) of
+/// a different LCO, in the order in which the LCOs completed. The calling
+/// thread will block until an LCO that has not yet been returned completes.
+///
+/// @param           any the completion set
+/// @param[out]   status the status of the returned LCO, pass NULL if the
+///                      status is not required
+///
+/// @returns             the index of the completed LCO, or -1 if every
+///                      non-HPX_NULL LCO in the set has already been returned,
+///                      once an index is returned its trigger has run and the
+///                      corresponding LCO may be deleted
+int hpx_lco_any_next(hpx_lco_any_t *any, hpx_status_t *status)
+  HPX_PUBLIC;
+
+/// Delete a completion set.
+///
+/// This detaches the triggers from the LCOs that have not been returned yet,
+/// and waits for any triggers that are already running to finish. Once it
+/// returns, the LCOs in the set may be deleted.
+///
+/// @param           any the completion set
+void hpx_lco_any_delete(hpx_lco_any_t *any)
+  HPX_PUBLIC;
+
+/// Wait for any one of the LCOs to be set.
+///
+/// The calling thread will block until one of the LCOs has been set. Entries
+/// in @p lcos that are HPX_NULL are ignored. Clients that want to process all
+/// of the LCOs in completion order should use hpx_lco_any_new() and
+/// hpx_lco_any_next() rather than calling this in a loop, as every call
+/// registers with each of the LCOs.
+///
+/// The triggers registered with the LCOs that were not returned are detached
+/// before this returns, so any of the LCOs may be deleted afterwards.
+///
+/// @param             n the number of LCOs in @p lcos
+/// @param          lcos an array of @p n global LCO addresses
+/// @param[out]   status the status of the LCO that was set, pass NULL if the
+///                      status is not required
+///
+/// @returns             the index of the LCO that was set, or -1 if all of the
+///                      entries in @p lcos are HPX_NULL
+int hpx_lco_wait_any(int n, hpx_addr_t lcos[], hpx_status_t *status)
+  HPX_PUBLIC;
+
+/// Get the value of any one of the LCOs.
+///
+/// This waits like hpx_lco_wait_any() and then gets the value of the LCO that
+/// was set into its corresponding buffer in @p values. No other buffer is
+/// written to.
+///
+/// @param             n the number of LCOs
+/// @param          lcos an array of @p n global LCO addresses
+/// @param         sizes an @p n element array of sizes that must correspond to
+///                      @p lcos and @p values
+/// @param[out]   values an array of @p n local buffers with sizes corresponding
+///                      to @p sizes
+/// @param[out]   status the status of the LCO that was set, pass NULL if the
+///                      status is not required
+///
+/// @returns             the index of the LCO that was read, or -1 if all of
+///                      the entries in @p lcos are HPX_NULL
+int hpx_lco_get_any(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
+                    hpx_status_t *status)
+  HPX_PUBLIC;
+
 /// Semaphores are builtin LCOs that represent resource usage.
 ///
 /// @param init initial value semaphore will be created with
@@ -680,6 +766,26 @@ hpx_status_t hpx_lco_gather_setid(hpx_addr_t gather, unsigned id,
                                   hpx_addr_t lsync, hpx_addr_t rsync)
   HPX_PUBLIC;
 
+/// Set a contiguous range of ids in a gather.
+///
+/// This sets ids [@p id, @p id + @p n) with a single operation (and a single
+/// parcel if the gather is remote), reading @p n consecutive values of @p size
+/// bytes from @p values. Contributions that arrive while the previous epoch
+/// is still being read are queued by the gather rather than blocking.
+///
+/// @param gather    The gather we're setting.
+/// @param id        The first id to set.
+/// @param n         The number of consecutive ids to set.
+/// @param size      The size of each input value.
+/// @param values    A pointer to @p n * @p size bytes to set with.
+/// @param lsync     An LCO to test for local completion.
+/// @param rsync     An LCO to test for remote completion.
+hpx_status_t hpx_lco_gather_setid_range(hpx_addr_t gather, unsigned id,
+                                        unsigned n, int size,
+                                        const void *values,
+                                        hpx_addr_t lsync, hpx_addr_t rsync)
+  HPX_PUBLIC;
+
 /// Allocate a gather LCO.
 ///
 /// This allocates an gather LCO with enough space for @p inputs of @p size.
@@ -706,6 +812,26 @@ hpx_status_t hpx_lco_alltoall_setid(hpx_addr_t alltoall, unsigned id,
                                     hpx_addr_t lsync, hpx_addr_t rsync)
   HPX_PUBLIC;
 
+/// Set a contiguous range of ids in an alltoall.
+///
+/// This sets ids [@p id, @p id + @p n) with a single operation (and a single
+/// parcel if the alltoall is remote). Each id's input is @p size bytes, laid
+/// out consecutively in @p values. Contributions that arrive while the
+/// previous epoch is still being read are queued rather than blocking.
+///
+/// @param alltoall    The alltoall we're setting.
+/// @param id          The first id to set.
+/// @param n           The number of consecutive ids to set.
+/// @param size        The size of each input value.
+/// @param values      A pointer to @p n * @p size bytes to set with.
+/// @param lsync       An LCO to test for local completion.
+/// @param rsync       An LCO to test for remote completion.
+hpx_status_t hpx_lco_alltoall_setid_range(hpx_addr_t alltoall, unsigned id,
+                                          unsigned n, int size,
+                                          const void *values,
+                                          hpx_addr_t lsync, hpx_addr_t rsync)
+  HPX_PUBLIC;
+
 /// Get the ID for alltoall. This is global getid for the user to use.
 ///
 /// @param   alltoall    Global address of the alltoall LCO
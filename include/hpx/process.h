@@ -147,6 +147,12 @@ int _hpx_process_broadcast_rsync(hpx_pid_t pid, hpx_action_t action, int nargs,
 /// This allreduce does not guarantee a deterministic reduce order, so floating
 /// point reductions must account for machine precision issues.
 ///
+/// When the runtime is configured with --hpx-coll-segment, values larger than
+/// the segment size are pipelined through the reduction tree one segment at a
+/// time. In that case @p reset and @p op are applied to individual segments,
+/// so they must operate elementwise, honor their size argument, and the
+/// segment size must be a multiple of the element size.
+///
 /// @param        bytes The size, in bytes, of the reduced value.
 /// @param        reset A reset operation for the reduction type.
 /// @param           op The reduce operation.
@@ -158,6 +164,58 @@ hpx_addr_t hpx_process_collective_allreduce_new(size_t bytes,
                                                 hpx_action_t op)
   HPX_PUBLIC;
 
+/// Allocate other distributed collectives in the current process.
+///
+/// These collectives are used through the allreduce interfaces below, and
+/// behave like the allreduce, except that they are defined over every
+/// locality. Each locality's input is the reduction of the values that its
+/// subscribers join with, and every locality must have subscribers when
+/// hpx_process_collective_allreduce_subscribe_finalize() is called.
+///
+/// Values are made of blocks of @p bytes bytes. For HPX_LOCALITIES blocks, the
+/// block at index i belongs to locality i.
+///
+///   allgather      each input is one block, each result is the blocks from
+///                  all localities
+///   alltoall       each input is HPX_LOCALITIES blocks, the result at
+///                  locality i is block i from all localities
+///   bcast          each input is one block, the result is the input from the
+///                  @p root locality
+///   reduce_scatter each input is HPX_LOCALITIES blocks, the result at
+///                  locality i is the reduction of block i from all localities
+///
+/// When the runtime is configured with --hpx-coll-network these use the
+/// network's collectives.
+///
+/// @param        bytes The size, in bytes, of a block.
+/// @param         root The root locality of a broadcast.
+/// @param        reset A reset operation for the reduction type.
+/// @param           op The reduce operation.
+///
+/// @returns            The global address to use for the collective, or
+///                     HPX_NULL if there was a problem.
+/// @{
+hpx_addr_t hpx_process_collective_allgather_new(size_t bytes,
+                                                hpx_action_t reset,
+                                                hpx_action_t op)
+  HPX_PUBLIC;
+
+hpx_addr_t hpx_process_collective_alltoall_new(size_t bytes,
+                                               hpx_action_t reset,
+                                               hpx_action_t op)
+  HPX_PUBLIC;
+
+hpx_addr_t hpx_process_collective_bcast_new(size_t bytes, int root,
+                                            hpx_action_t reset,
+                                            hpx_action_t op)
+  HPX_PUBLIC;
+
+hpx_addr_t hpx_process_collective_reduce_scatter_new(size_t bytes,
+                                                     hpx_action_t reset,
+                                                     hpx_action_t op)
+  HPX_PUBLIC;
+/// @}
+
 /// Delete a process allreduce.
 ///
 /// This is not synchronized, so the caller must ensure that there are no
@@ -175,8 +233,8 @@ void hpx_process_collective_allreduce_delete(hpx_addr_t allreduce)
 ///
 /// The subscription is defined in terms of a continuation action to be invoked
 /// with the reduced value after each epoch. The continuation must be a
-/// marshalled action type, and be compatible with the size defined during
-/// allreduce allocation. The subscription returns an identifier token that
+/// marshalled action type, and be compatible with the size of the result of
+/// the collective. The subscription returns an identifier token that
 /// should be used during the join operation.
 ///
 /// @param    allreduce The allreduce to subscribe to.
@@ -197,6 +255,8 @@ int32_t hpx_process_collective_allreduce_subscribe(hpx_addr_t allreduce,
 ///
 /// @param    allreduce The allreduce to finalize from.
 ///
+/// @returns            HPX_SUCCESS, or an error code if the group is not valid
+///                     for the collective.
 int hpx_process_collective_allreduce_subscribe_finalize(hpx_addr_t allreduce)
 
   HPX_PUBLIC;
@@ -209,6 +209,19 @@ typedef struct {
                               hpx_addr_t rsync, hpx_action_t rop, int n,
                               va_list *args);
 
+  /// Compute the payload size of a parcel for an action.
+  ///
+  /// This returns the number of bytes that new_parcel() would allocate for the
+  /// parcel payload, which allows the caller to provide its own parcel to
+  /// pack_parcel(). This may be NULL if the size can't be computed cheaply.
+  ///
+  /// @param        obj The action object.
+  /// @param          n The number of @p args.
+  /// @param       args The list of args for the parcel, which is not consumed.
+  ///
+  /// @return           The size of the packed arguments.
+  size_t (*payload_size)(const void *obj, int n, va_list *args);
+
   /// Exit a thread.
   ///
   /// This is used to provide an action a chance to clean up (e.g., unpin the
@@ -423,7 +436,8 @@ static const char* const HPX_ACTION_ATTR_TO_STRING[] = {
   "INTERNAL",
   "VECTORED",
   "COALESCED",
-  "COMPRESSED"
+  "COMPRESSED",
+  "TYPED"
 };
 
 static inline bool action_is_pinned(hpx_action_t id) {
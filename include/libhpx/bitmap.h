@@ -80,6 +80,21 @@ int bitmap_reserve(bitmap_t *map, uint32_t nbits, uint32_t align, uint32_t *i)
 int bitmap_rreserve(bitmap_t *map, uint32_t nbits, uint32_t align, uint32_t *i)
   HPX_NON_NULL(1, 4);
 
+/// Like bitmap_rreserve(), but returns LIBHPX_ENOMEM rather than reporting an
+/// error when there is no space.
+///
+/// This is used to speculatively reserve space for a cache.
+///
+/// @param[in]      map The bitmap to allocate from.
+/// @param[in]    nbits The number of continuous bits to allocate.
+/// @param[in]    align The alignment we need to find.
+/// @param[out]       i The offset of the start of the allocation.
+///
+/// @returns LIBHPX_OK, LIBHPX_ENOMEM
+int bitmap_try_rreserve(bitmap_t *map, uint32_t nbits, uint32_t align,
+                        uint32_t *i)
+  HPX_NON_NULL(1, 4);
+
 /// Free @p nbits contiguous bits of memory, starting at offset @p i.
 ///
 /// @param          map The bitmap to free from.
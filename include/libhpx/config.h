@@ -129,6 +129,42 @@ static const char * const HPX_SCHED_POLICY_TO_STRING[] = {
   "INVALID_POLICY"
 };
 
+//! Configuration options for the pages that back the global heap.
+typedef enum {
+  HPX_HUGEPAGES_DEFAULT = 0,    //!< Use hugetlbfs if it is available.
+  HPX_HUGEPAGES_NONE,           //!< Use normal pages.
+  HPX_HUGEPAGES_THP,            //!< Request transparent huge pages.
+  HPX_HUGEPAGES_HUGETLB,        //!< Use explicit (MAP_HUGETLB) huge pages.
+  HPX_HUGEPAGES_MAX
+} libhpx_hugepages_t;
+
+static const char * const HPX_HUGEPAGES_TO_STRING[] = {
+  "DEFAULT",
+  "NONE",
+  "THP",
+  "HUGETLB",
+  "INVALID_POLICY"
+};
+
+//! Configuration options for the NUMA placement of the global heap.
+typedef enum {
+  HPX_HEAP_NUMA_DEFAULT = 0,    //!< Leave placement to the operating system.
+  HPX_HEAP_NUMA_INTERLEAVE,     //!< Interleave pages across all NUMA nodes.
+  HPX_HEAP_NUMA_FIRSTTOUCH,     //!< Place pages on the node of the worker that
+                                //!< allocates them, through per-node arenas.
+  HPX_HEAP_NUMA_PARTITION,      //!< Bind each per-node arena's memory to its
+                                //!< node.
+  HPX_HEAP_NUMA_MAX
+} libhpx_heap_numa_t;
+
+static const char * const HPX_HEAP_NUMA_TO_STRING[] = {
+  "DEFAULT",
+  "INTERLEAVE",
+  "FIRSTTOUCH",
+  "PARTITION",
+  "INVALID_POLICY"
+};
+
 //! Locality types in HPX.
 #define HPX_LOCALITY_NONE  -2                   //!< Represents no locality.
 #define HPX_LOCALITY_ALL   -1                   //!< Represents all localities.
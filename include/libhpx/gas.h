@@ -58,6 +58,12 @@ typedef struct gas {
   __typeof(hpx_gas_calloc_cyclic_attr) *calloc_cyclic;
   __typeof(hpx_gas_alloc_blocked_attr) *alloc_blocked;
   __typeof(hpx_gas_calloc_blocked_attr) *calloc_blocked;
+
+  // user-defined distributions, may be NULL
+  hpx_addr_t (*alloc_user)(size_t n, uint32_t bsize, uint32_t boundary,
+                           hpx_gas_dist_t dist, uint32_t attr);
+  hpx_addr_t (*calloc_user)(size_t n, uint32_t bsize, uint32_t boundary,
+                            hpx_gas_dist_t dist, uint32_t attr);
 } gas_t;
 
 gas_t *gas_new(config_t *cfg, struct boot *boot)
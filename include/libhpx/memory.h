@@ -127,6 +127,25 @@ void as_leave(void);
 /// allocator-independent way.
 size_t as_bytes_per_chunk(void);
 
+/// Get the NUMA node that an arena serves.
+///
+/// @param        arena The jemalloc arena index.
+///
+/// @returns            The node, or -1 if @p arena is not a per-NUMA node
+///                     arena.
+int as_arena_numa_node(unsigned arena);
+
+/// Apply the --hpx-heap-numa placement policy to a new chunk.
+///
+/// Custom chunk allocation hooks call this before the chunk is touched. Chunks
+/// for per-NUMA node arenas are bound to their node under the partitioned
+/// policy.
+///
+/// @param        chunk The chunk.
+/// @param            n The size of the chunk.
+/// @param        arena The arena that the chunk is being allocated for.
+void as_chunk_place(void *chunk, size_t n, unsigned arena);
+
 void *as_malloc(int id, size_t bytes);
 void *as_calloc(int id, size_t nmemb, size_t bytes);
 void *as_memalign(int id, size_t boundary, size_t size);
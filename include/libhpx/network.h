@@ -33,13 +33,30 @@ struct transport;
 /// @}
 
 /// collective definitions/interfaces
+///
+/// The input to a collective is the data of the parcel passed to coll_sync(),
+/// and the output buffer must be large enough for the result:
+///
+///   ALL_REDUCE     in and out are both one value
+///   ALL_GATHER     in is one block, out is group_sz blocks
+///   ALL_TO_ALL     in and out are both group_sz blocks, block i of in is sent
+///                  to the i'th member of the group
+///   BROADCAST      in is the value at the root'th member of the group, out is
+///                  the value everywhere
+///   REDUCE_SCATTER in is group_sz blocks, out is the reduction of the i'th
+///                  block at the i'th member of the group
 typedef enum {
   ALL_REDUCE = 1000 ,
+  ALL_GATHER,
+  ALL_TO_ALL,
+  BROADCAST,
+  REDUCE_SCATTER,
 } coll_type_t;
 
 typedef struct collective{
   coll_type_t      type;   //!< type of collective operation
   hpx_monoid_op_t    op;   //!< collective operator 
+  int32_t          root;   //!< group index of the broadcast root
   int32_t      group_sz;   //!< active group size
   int32_t    recv_count;   //!< how many bytes to be recieved
   int32_t    comm_bytes;   //!< active comm size in bytes
@@ -250,4 +267,17 @@ static inline int network_memcpy_sync(void *obj, hpx_addr_t to, hpx_addr_t from,
   return network->string->memcpy_sync(network, to, from, size);
 }
 
+static inline int network_memget_vec(void *obj, const hpx_gas_iovec_t *iov,
+                                     int n, hpx_addr_t lsync) {
+  network_t *network = obj;
+  return network->string->memget_vec(network, iov, n, lsync);
+}
+
+static inline int network_memput_vec(void *obj, const hpx_gas_iovec_t *iov,
+                                     int n, hpx_addr_t lsync,
+                                     hpx_addr_t rsync) {
+  network_t *network = obj;
+  return network->string->memput_vec(network, iov, n, lsync, rsync);
+}
+
 #endif // LIBHPX_NETWORK_H
@@ -16,9 +16,16 @@
 
 #include <stddef.h>
 
+struct config;
 struct hpx_parcel;
 typedef struct parcel_block parcel_block_t;
 
+/// The largest parcel block size.
+///
+/// Parcel blocks may have any power of two size up to this size, but are all
+/// aligned to it so that a parcel's block can be found from its address.
+size_t parcel_block_max_size(const struct config *cfg);
+
 parcel_block_t *parcel_block_new(size_t align, size_t n, size_t *offset);
 void parcel_block_delete(parcel_block_t *block);
 void *parcel_block_at(parcel_block_t *block, size_t offset);
@@ -57,6 +57,7 @@ typedef struct {
   profile_list_t     *events; //!< The actual profiled events
   int          current_entry; //!< The current entry
   int          current_event; //!< The current code event
+  int                     id; //!< Identifies the log in profiling tags
 } profile_log_t;
 
 #define PROFILE_INIT {                      \
@@ -66,24 +67,76 @@ typedef struct {
     .counters = NULL,                       \
     .events = NULL,                         \
     .current_entry = -1,                    \
-    .current_event = -1                     \
+    .current_event = -1,                    \
+    .id = 0                                 \
     }
 
-/// Add a new entry to the profile list in the profile log.
+/// Each thread records profiling entries into its own profile log, in which
+/// the events are indexed by the integer handle returned from
+/// prof_register_event(). The per-thread logs are merged into the locality's
+/// log by profile_merge() when profiling is finalized, and all of the
+/// prof_get_*() queries operate on the merged log.
+///
+/// Because entries are recorded per thread, the calls that start and stop
+/// (or pause and resume) a particular entry must be made on the same thread.
+/// Tags identify the log that they were issued by, and calls with a tag from
+/// another thread's log (e.g., after an HPX thread has migrated between workers)
+/// are rejected.
+
+/// Get the calling thread's profile log, creating it if necessary.
+/// @returns                 The log, or NULL if profiling is not enabled.
+profile_log_t *profile_local_log(void);
+
+/// Get the list for an event in a thread's profile log, initializing it from
+/// the registered event if necessary.
+/// @param               log The thread's profile log.
+/// @param             event The event handle.
+/// @returns                 The event's list, or NULL if the event is invalid.
+profile_list_t *profile_local_event(profile_log_t *log, int event);
+
+/// Add a new entry to the profile list in a thread's profile log.
+/// @param               log The thread's profile log.
 /// @param             event The event id of the new entry being added
-/// @returns                 Index of the new entry.  
-int profile_new_entry(int event);
-
-/// Get the event corresponding to the event key @p key in the profile
-/// log.
+/// @returns                 Index of the new entry.
+int profile_new_entry(profile_log_t *log, int event);
+
+/// Get the tag for an entry in a thread's profile log.
+/// @param               log The thread's profile log.
+/// @param             entry The index of the entry.
+/// @returns                 The tag, or HPX_PROF_NO_TAG if the entry index
+///                          can't be represented.
+int profile_tag(const profile_log_t *log, int entry);
+
+/// Get the entry that a tag refers to in a thread's profile log.
+/// @param               log The thread's profile log.
+/// @param             event The event handle.
+/// @param               tag The tag.
+/// @returns                 The index of the entry, or HPX_PROF_NO_TAG if the
+///                          tag was not issued by @p log for an entry of
+///                          @p event.
+int profile_tag_entry(const profile_log_t *log, int event, int tag);
+
+/// Get the event handle corresponding to the event key @p key.
 /// @param               key The key of the event we are getting
-int profile_get_event(char *key);
+/// @returns                 The handle, or LIBHPX_ERROR if it does not exist.
+int profile_get_event(const char *key);
+
+/// Merge all of the per-thread profile logs into the locality's profile log.
+/// This must only be called once no other thread is profiling.
+void profile_merge(void);
+
+/// Free the locality's profile log and the event registry.
+void profile_fini(void);
 
-/// Create a new profile event list in the profile log.
+/// Register a profiled code event, returning its handle. If an event with the
+/// same key already exists, its handle is returned.
+///
+/// The prof_*_id() variants of the functions below take this handle in place
+/// of the key, and avoid looking the key up on each call.
 /// @param               key The key of the event we are creating
 /// @param            simple True if hardware counters don't apply
-/// @param          eventset The eventset of the new event entry
-int profile_new_event(char *key, bool simple, int eventset);
+/// @returns                 The handle, or LIBHPX_ERROR.
+int prof_register_event(const char *key, bool simple);
 
 /// Initialize profiling. This is usually called in hpx_init().
 int prof_init(struct config *cfg)
@@ -147,16 +200,19 @@ int prof_get_num_counters(void);
 /// @param         key The key that identifies the code event
 /// @param      amount The amount to add to the total
 void prof_record_user_val(char *key, double amount);
+void prof_record_user_val_id(int id, double amount);
 
 /// Mark the occurrence of an event
 /// @param         key The key that identifies the code event
 void prof_mark(char *key);
+void prof_mark_id(int id);
 
 /// Begin profiling. This begins recording performance information of an event.
 /// @param         key The key that identifies the code event
 /// @param         tag A pointer that is given a unique value upon success; is
 ///                    used in other functions for better profiling performance
 void prof_start_timing(char *key, int *tag);
+void prof_start_timing_id(int id, int *tag);
 
 /// Stop profiling.  This ends recording performance information of an event.
 /// Additionally, the times are added to the running total time.
@@ -164,12 +220,14 @@ void prof_start_timing(char *key, int *tag);
 /// @param         tag Used for internal lookup; will be given a new value if
 ///                    the provided value is HPX_PROF_NO_TAG
 int prof_stop_timing(char *key, int *tag);
+int prof_stop_timing_id(int id, int *tag);
 
 /// Begin profiling. This begins recording performance information of an event.
 /// @param         key The key that identifies the code event
 /// @param         tag A pointer that is given a unique value upon success; is
 ///                    used in other functions for better profiling performance
 int prof_start_hardware_counters(char *key, int *tag);
+int prof_start_hardware_counters_id(int id, int *tag);
 
 /// Stop profiling.  This ends recording performance information of an event.
 /// Additionally, the counter values are added to the running total counts.
@@ -177,12 +235,14 @@ int prof_start_hardware_counters(char *key, int *tag);
 /// @param         tag Used for internal lookup; will be given a new value if
 ///                    the provided value is HPX_PROF_NO_TAG
 int prof_stop_hardware_counters(char *key, int *tag);
+int prof_stop_hardware_counters_id(int id, int *tag);
 
 /// Pause the profiling temporarily
 /// @param         key The key that identifies the code event
 /// @param         tag Used for internal lookup; will be given a new value if
 ///                    the provided value is HPX_PROF_NO_TAG
 int prof_pause(char *key, int *tag);
+int prof_pause_id(int id, int *tag);
 
 /// Resume profiling after pausing; the tag argument should be the value
 /// returned after calling the corresponding prof_pause()
@@ -190,5 +250,6 @@ int prof_pause(char *key, int *tag);
 /// @param         tag Used for internal lookup; will be given a new value if
 ///                    the provided value is HPX_PROF_NO_TAG
 int prof_resume(char *key, int *tag);
+int prof_resume_id(int id, int *tag);
 
 #endif
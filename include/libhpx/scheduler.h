@@ -165,6 +165,27 @@ void scheduler_spawn_at(hpx_parcel_t *p, int thread)
 void scheduler_spawn(hpx_parcel_t *p)
   HPX_NON_NULL(1);
 
+/// Check if the calling thread can run an interrupt synchronously.
+///
+/// This is true on a running worker that is not holding an LCO lock, is not
+/// progressing the network, and is not already too deeply nested in inline
+/// interrupts. Unlike scheduler_spawn(), this does not otherwise depend on the
+/// work-first mode, because an interrupt does not need its own stack.
+///
+/// @returns            True if scheduler_run_interrupt() may be called.
+int scheduler_can_run_interrupt(void);
+
+/// Run an interrupt parcel synchronously on the calling thread.
+///
+/// The caller must have checked scheduler_can_run_interrupt(). The parcel is
+/// deleted after it runs unless it is retained, which allows the caller to
+/// provide a parcel allocated on its own stack. Such a parcel must not be
+/// able to resend, i.e., it can't target a pinned action.
+///
+/// @param            p The interrupt parcel to run.
+void scheduler_run_interrupt(hpx_parcel_t *p)
+  HPX_NON_NULL(1);
+
 /// Yield a user-level thread.
 ///
 /// This triggers a scheduling event, and possibly selects a new user-level
@@ -16,39 +16,38 @@
 
 #include "hpx/hpx.h"
 
+struct config;
+
 /// @file libhpx/scheduler/stats.h
 /// @brief The libhpx stats definitions.
 
-#if defined(ENABLE_PROFILING) || defined(HAVE_APEX)
+/// Statistics are always collected. Each counter is only ever updated by the
+/// worker that owns it, so sampling is a plain increment.
 #define COUNTER_SAMPLE(e) e
-#else
-#define COUNTER_SAMPLE(e)
-#endif
+
+/// Add @p n to the calling worker's @p stat counter, if the caller is a worker.
+/// This requires libhpx/worker.h.
+#define STATS_ADD(stat, n) do {                 \
+    worker_t *_w = self;                        \
+    if (_w) {                                   \
+      _w->stats.stat += (n);                    \
+    }                                           \
+  } while (0)
 
 /// libhpx statistics.
 ///
-/// These are statistics mostly related to the scheduler that are
+/// These are statistics related to the scheduler and network that are
 /// updated during program execution. Local (per-worker) statistics
 /// are stored in each worker's TLS and updated by each worker
-/// separately. Global (per-scheduler) statistics are accumulated
-/// after each worker shuts down.
+/// separately. They are summed across workers when they are exported or
+/// printed. The counters are declared in libhpx/stats.def.
 typedef struct libhpx_stats {
-  unsigned long        spawns;
-  unsigned long failed_steals;
-  unsigned long        steals;
-  unsigned long          mail;
-  unsigned long        stacks;
-  unsigned long        yields;
+#define LIBHPX_STAT(id) unsigned long id;
+# include "libhpx/stats.def"
+#undef LIBHPX_STAT
 } libhpx_stats_t;
 
-#define LIBHPX_STATS_INIT { \
-    .spawns        = 0,     \
-    .failed_steals = 0,     \
-    .steals        = 0,     \
-    .mail          = 0,     \
-    .stacks        = 0,     \
-    .yields        = 0,     \
-  }
+#define LIBHPX_STATS_INIT {0}
 
 /// Initialize the libhpx statistics structure.
 void libhpx_stats_init(struct libhpx_stats *stats)
@@ -66,9 +65,77 @@ struct libhpx_stats *libhpx_stats_accum(struct libhpx_stats *lhs,
                                         const struct libhpx_stats *rhs)
   HPX_NON_NULL(1, 2);
 
+/// Sum the statistics of all of the workers on this locality.
+///
+/// This may be called while the workers are running, in which case the
+/// result is a slightly stale snapshot.
+///
+/// @param[out]   total The accumulated statistics.
+void libhpx_stats_collect(struct libhpx_stats *total)
+  HPX_NON_NULL(1);
+
 /// Print libhpx statistics.
 void libhpx_stats_print(void);
 
+/// Start exporting statistics.
+///
+/// If --hpx-stats-file is set, this starts a thread that periodically writes
+/// the per-worker and total statistics to that file (suffixed with the
+/// locality's rank), so that external tools can monitor a running job. The
+/// file is replaced atomically on each update.
+int libhpx_stats_export_start(const struct config *cfg)
+  HPX_NON_NULL(1);
+
+/// Stop exporting statistics, after writing a final update.
+void libhpx_stats_export_stop(void);
+
+/// The number of log2 buckets in the per-action latency histograms.
+///
+/// Bucket i counts executions that took [2^i, 2^(i+1)) nanoseconds; the last
+/// bucket also counts anything longer.
+#define LIBHPX_ACTION_STATS_BUCKETS 40
+
+/// Per-action statistics.
+///
+/// When --hpx-stats-actions is set each worker keeps one of these for each
+/// registered action, indexed by action id. They are only updated by the
+/// owning worker, and are merged when they are printed or exported. The
+/// execution time of a thread is the wall time from when it starts to when it
+/// finishes, and includes the time it spends blocked.
+typedef struct {
+  unsigned long   count;                        //!< number of executions
+  unsigned long    time;                        //!< total execution time (ns)
+  unsigned long blocked;                        //!< total blocked time (ns)
+  unsigned long    hist[LIBHPX_ACTION_STATS_BUCKETS];
+} libhpx_action_stats_t;
+
+/// Start timing an action execution or wait.
+///
+/// @returns            An opaque start time, or 0 if per-action statistics
+///                     are disabled.
+uint64_t libhpx_action_stats_start(void);
+
+/// Record an execution of an action by the calling worker.
+///
+/// @param           id The action that was executed.
+/// @param        start The value returned by libhpx_action_stats_start().
+void libhpx_action_stats_exec(hpx_action_t id, uint64_t start);
+
+/// Record the time that an action spent blocked on the calling worker.
+///
+/// @param           id The action that was blocked.
+/// @param        start The value returned by libhpx_action_stats_start().
+void libhpx_action_stats_blocked(hpx_action_t id, uint64_t start);
+
+/// Merge the per-action statistics of all of the workers on this locality.
+///
+/// Like libhpx_stats_collect() this may be called while the workers are
+/// running.
+///
+/// @param[out]   total An array of action_table_size() entries.
+void libhpx_action_stats_collect(libhpx_action_stats_t *total)
+  HPX_NON_NULL(1);
+
 /// Save collected statistics to APEX.
 void libhpx_save_apex_stats(void);
 
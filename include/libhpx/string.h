@@ -37,6 +37,16 @@ typedef struct {
                 hpx_addr_t sync);
 
   int (*memcpy_sync)(void *obj, hpx_addr_t to, hpx_addr_t from, size_t size);
+
+  /// The vectored operations signal their LCOs once, when all of the regions
+  /// have completed. The @p iov array is not referenced after they return.
+  /// @{
+  int (*memget_vec)(void *obj, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync);
+
+  int (*memput_vec)(void *obj, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync, hpx_addr_t rsync);
+  /// @}
 } class_string_t;
 
 #endif // LIBHPX_STRING_H
@@ -54,7 +54,10 @@ typedef void *(*system_mmap_t)(void *, void *, size_t, size_t);
 /// An abstract interface to mmap-like operations for huge pages.
 ///
 /// As opposed to mmap, this guarantees alignment. It will try and place the
-/// corresponding allocation at @p addr, but it won't try too hard.
+/// corresponding allocation at @p addr, but it won't try too hard. The kind of
+/// huge pages that are used is selected by --hpx-hugepages; the size and
+/// alignment are rounded up to the huge page size when necessary, and regions
+/// must be released with system_munmap_huge_pages().
 ///
 /// @param          obj User data to match the object oriented mmap interface.
 /// @param         addr A hint about where to try and place the allocation.
@@ -64,6 +67,49 @@ typedef void *(*system_mmap_t)(void *, void *, size_t, size_t);
 /// @returns The allocated region.
 void *system_mmap_huge_pages(void *obj, void *addr, size_t bytes, size_t align);
 
+/// Get the size of the pages that back a mapped address.
+///
+/// This is used to report the page size that a huge page allocation actually
+/// obtained, which may be smaller than requested if the system is out of huge
+/// pages or has transparent huge pages disabled.
+///
+/// @param         addr An address in the mapping.
+///
+/// @returns            The page size in bytes.
+size_t system_mmap_page_size(const void *addr);
+
+/// Reserve a range of address space without committing any memory to it.
+///
+/// The range is inaccessible until parts of it are committed with
+/// system_mmap_commit(), and is released with system_munmap().
+///
+/// @param         addr A hint about where to try and place the reservation.
+/// @param        bytes The size in bytes of the reservation (must be 2^n).
+/// @param        align The alignment in bytes of the reservation (must be 2^n).
+///
+/// @returns The reserved region.
+void *system_mmap_reserve(void *addr, size_t bytes, size_t align);
+
+/// Commit memory to part of a reserved range.
+///
+/// The memory is zero-filled, and is backed by huge pages according to
+/// --hpx-hugepages when @p addr and @p bytes are suitably aligned.
+///
+/// @param         addr The base of the range to commit.
+/// @param        bytes The number of bytes to commit.
+///
+/// @returns LIBHPX_OK, or LIBHPX_ENOMEM if the memory could not be committed.
+int system_mmap_commit(void *addr, size_t bytes);
+
+/// Return the memory backing part of a reserved range to the OS.
+///
+/// The range remains reserved, and becomes inaccessible until it is committed
+/// again.
+///
+/// @param         addr The base of the range to decommit.
+/// @param        bytes The number of bytes to decommit.
+void system_mmap_decommit(void *addr, size_t bytes);
+
 /// Unmap memory.
 void system_munmap(void *obj, void *addr, size_t size);
 
@@ -24,6 +24,8 @@
 extern "C" {
 #endif
 
+#include <libhpx/config.h>
+
 /// Forward declarations
 /// @{
 struct config;
@@ -64,6 +66,23 @@ typedef struct topology {
 topology_t *topology_new(const struct config *config)
   HPX_MALLOC;
 
+/// Apply a NUMA placement policy to a range of memory.
+///
+/// This is a no-op on systems with a single NUMA node, and for the default
+/// policy. Pages in the range that have already been touched are migrated
+/// when they are bound to a single node.
+///
+/// @param     topology The topology object.
+/// @param         addr The start of the range (must be page aligned).
+/// @param            n The number of bytes in the range.
+/// @param       policy The placement policy.
+/// @param         node The node to bind to for HPX_HEAP_NUMA_PARTITION.
+///
+/// @returns            LIBHPX_OK, or LIBHPX_ERROR if the policy could not be
+///                     applied.
+int topology_set_membind(const topology_t *topology, void *addr, size_t n,
+                         libhpx_heap_numa_t policy, int node);
+
 /// Finalize and free the topology object.
 ///
 /// @param    topology The topology object to free.
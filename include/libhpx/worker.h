@@ -67,8 +67,12 @@ typedef struct {
   libhpx_stats_t      stats;              //!< per-worker statistics          
   int           last_victim;              //!< last successful victim         
   int             numa_node;              //!< this worker's numa node        
+  int             interrupts;             //!< depth of inline interrupts
   void            *profiler;              //!< reference to the profiler      
   void                 *bst;              //!< reference to the profiler      
+  void              *tcache;              //!< AGAS translation cache         
+  void        *action_stats;              //!< per-action statistics          
+  void            *compress;              //!< compression scratch buffer     
   struct network   *network;              //!< reference to the network       
 } worker_t HPX_ALIGNED(HPX_CACHELINE_SIZE);
 /// @}
@@ -17,15 +17,67 @@
 
 #include <libhpx/action.h>
 #include <libhpx/debug.h>
+#include <libhpx/gas.h>
+#include <libhpx/locality.h>
 #include <libhpx/parcel.h>
+#include <libhpx/scheduler.h>
 #include "init.h"
 
+/// The largest payload that we will pack into a parcel on the stack for a
+/// direct call.
+static const size_t _DIRECT_CALL_MAX = 256;
+
+/// Try to call an action directly.
+///
+/// A local call to an unpinned interrupt from a thread that would run it
+/// immediately in scheduler_spawn() doesn't need a heap allocated parcel or a
+/// trip through parcel_launch(). We pack the arguments straight into a
+/// retained parcel on our stack and run it. Unpinned interrupts can't resend,
+/// and their continuation is launched as a separate parcel, so the stack
+/// parcel never outlives this call.
+///
+/// @returns            True if the action was run, false if the caller needs to
+///                     fall back to sending a parcel.
+static bool _call_direct(const action_t *a, hpx_addr_t addr, hpx_addr_t rsync,
+                         hpx_action_t rop, int n, va_list *args) {
+  if (a->type != HPX_INTERRUPT || (a->attr & HPX_PINNED)) {
+    return false;
+  }
+
+  if (!a->parcel_class->payload_size || !scheduler_can_run_interrupt()) {
+    return false;
+  }
+
+  if (gas_owner_of(here->gas, addr) != here->rank) {
+    return false;
+  }
+
+  size_t bytes = a->parcel_class->payload_size(a, n, args);
+  if (bytes > _DIRECT_CALL_MAX) {
+    return false;
+  }
+
+  char buffer[sizeof(hpx_parcel_t) + _DIRECT_CALL_MAX] HPX_ALIGNED(8);
+  hpx_parcel_t *p = (hpx_parcel_t*)buffer;
+  hpx_pid_t pid = hpx_thread_current_pid();
+  parcel_init(addr, *a->id, rsync, rop, pid, NULL, bytes, p);
+  a->parcel_class->pack_parcel(a, p, n, args);
+  parcel_prepare(p);
+  parcel_retain(p);
+  scheduler_run_interrupt(p);
+  return true;
+}
+
 static int _call_by_parcel_async(const void *o, hpx_addr_t addr,
                                  hpx_addr_t lsync, hpx_action_t lop,
                                  hpx_addr_t rsync, hpx_action_t rop,
                                  int n, va_list *args) {
   dbg_assert(lop == hpx_lco_set_action);
   const action_t *a = o;
+  if (_call_direct(a, addr, rsync, rop, n, args)) {
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return HPX_SUCCESS;
+  }
   hpx_parcel_t *p = a->parcel_class->new_parcel(a, addr, rsync, rop, n, args);
   hpx_parcel_send(p, lsync);
   return HPX_SUCCESS;
@@ -35,6 +87,9 @@ static int _call_by_parcel_lsync(const void *o, hpx_addr_t addr,
                                  hpx_addr_t rsync, hpx_action_t rop, int n,
                                  va_list *args) {
   const action_t *a = o;
+  if (_call_direct(a, addr, rsync, rop, n, args)) {
+    return HPX_SUCCESS;
+  }
   hpx_parcel_t *p = a->parcel_class->new_parcel(a, addr, rsync, rop, n, args);
   parcel_launch(p);
   return HPX_SUCCESS;
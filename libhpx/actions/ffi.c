@@ -88,6 +88,20 @@ static void _pack_pinned_ffi_n(const void *obj, hpx_parcel_t *p, int n,
   ffi_ptrarray_to_raw((void*)cif, argps, buffer);
 }
 
+static size_t _payload_ffi_0(const void *obj, int n, va_list *args) {
+  return 0;
+}
+
+static size_t _payload_ffi_n(const void *obj, int n, va_list *args) {
+  const action_t *action = obj;
+  return ffi_raw_size(action->env);
+}
+
+static size_t _payload_pinned_ffi_n(const void *obj, int n, va_list *args) {
+  const action_t *action = obj;
+  return ffi_raw_size(action->env) - sizeof(void*);
+}
+
 static hpx_parcel_t *_new_ffi_0(const void *obj, hpx_addr_t addr,
                                 hpx_addr_t c_addr, hpx_action_t c_action,
                                 int n, va_list *args) {
@@ -178,6 +192,7 @@ static const parcel_management_vtable_t _ffi_0_vtable = {
   .new_parcel = _new_ffi_0,
   .pack_parcel = _pack_ffi_0,
   .exec_parcel = _exec_ffi_n,
+  .payload_size = _payload_ffi_0,
   .exit = exit_action
 };
 
@@ -185,6 +200,7 @@ static const parcel_management_vtable_t _pinned_ffi_0_vtable = {
   .new_parcel = _new_ffi_0,
   .pack_parcel = _pack_ffi_0,
   .exec_parcel = _exec_pinned_ffi_n,
+  .payload_size = _payload_ffi_0,
   .exit = exit_pinned_action
 };
 
@@ -192,6 +208,7 @@ static const parcel_management_vtable_t _ffi_n_vtable = {
   .new_parcel = _new_ffi_n,
   .pack_parcel = _pack_ffi_n,
   .exec_parcel = _exec_ffi_n,
+  .payload_size = _payload_ffi_n,
   .exit = exit_action
 };
 
@@ -199,6 +216,7 @@ static const parcel_management_vtable_t _pinned_ffi_n_vtable = {
   .new_parcel = _new_pinned_ffi_n,
   .pack_parcel = _pack_pinned_ffi_n,
   .exec_parcel = _exec_pinned_ffi_n,
+  .payload_size = _payload_pinned_ffi_n,
   .exit = exit_pinned_action
 };
 
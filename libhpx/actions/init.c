@@ -21,7 +21,7 @@
 #include "init.h"
 
 void action_init(action_t *action, int n, va_list *args) {
-  uint32_t attr = action->attr & (HPX_MARSHALLED | HPX_VECTORED);
+  uint32_t attr = action->attr & (HPX_MARSHALLED | HPX_VECTORED | HPX_TYPED);
   switch (attr) {
    case (HPX_ATTR_NONE):
     action_init_ffi(action, n, args);
@@ -32,6 +32,9 @@ void action_init(action_t *action, int n, va_list *args) {
    case (HPX_MARSHALLED | HPX_VECTORED):
     action_init_vectored(action, n, args);
     return;
+   case (HPX_TYPED):
+    action_init_typed(action, n, args);
+    return;
   }
   dbg_error("Could not initialize action for attr %" PRIu32 "\n", attr);
 }
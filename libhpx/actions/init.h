@@ -21,6 +21,7 @@ void action_init(action_t *action, int n, va_list *args);
 void action_init_marshalled(action_t *action, int n, va_list *args);
 void action_init_ffi(action_t *action, int n, va_list *args);
 void action_init_vectored(action_t *action, int n, va_list *args);
+void action_init_typed(action_t *action, int n, va_list *args);
 
 void action_init_call_by_parcel(action_t *action);
 
@@ -15,6 +15,7 @@
 # include "config.h"
 #endif
 
+#include <string.h>
 #include <hpx/hpx.h>
 #include <libhpx/action.h>
 #include <libhpx/debug.h>
@@ -24,6 +25,31 @@
 
 static void _pack_marshalled(const void *obj, hpx_parcel_t *p, int n,
                              va_list *args) {
+  dbg_assert_str(!n || args);
+  dbg_assert(!n || n == 2);
+  if (!n) {
+    return;
+  }
+
+  void *data = va_arg(*args, void*);
+  int bytes = va_arg(*args, int);
+  dbg_assert(bytes <= p->size);
+  if (bytes) {
+    memcpy(hpx_parcel_get_data(p), data, bytes);
+  }
+}
+
+static size_t _payload_marshalled(const void *obj, int n, va_list *args) {
+  if (!n) {
+    return 0;
+  }
+
+  va_list temp;
+  va_copy(temp, *args);
+  va_arg(temp, void*);
+  int bytes = va_arg(temp, int);
+  va_end(temp);
+  return bytes;
 }
 
 static hpx_parcel_t *_new_marshalled(const void *obj, hpx_addr_t addr,
@@ -77,6 +103,7 @@ static const parcel_management_vtable_t _marshalled_vtable = {
   .new_parcel = _new_marshalled,
   .pack_parcel = _pack_marshalled,
   .exec_parcel = _exec_marshalled,
+  .payload_size = _payload_marshalled,
   .exit = exit_action
 };
 
@@ -84,6 +111,7 @@ static const parcel_management_vtable_t _pinned_marshalled_vtable = {
   .new_parcel = _new_marshalled,
   .pack_parcel = _pack_marshalled,
   .exec_parcel = _exec_pinned_marshalled,
+  .payload_size = _payload_marshalled,
   .exit = exit_pinned_action
 };
 
@@ -0,0 +1,183 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+/// Typed actions are registered by compiled front ends (currently the C++
+/// hpx::Action template) that know the exact signature of the user's function
+/// at compile time. The action's handler is a trampoline generated for that
+/// signature, which unpacks the parcel data and calls the user's function
+/// directly, so neither the sender nor the receiver goes through libffi.
+///
+/// Each argument occupies its own 8-byte aligned slot in the parcel data, in
+/// order. This is the same layout that libffi's raw API uses for the
+/// arguments we support, so raw buffers (e.g., a continued value) that were
+/// produced for an ffi action are also valid for a typed action.
+
+#include <stdlib.h>
+#include <string.h>
+#include <hpx/hpx.h>
+#include <libhpx/action.h>
+#include <libhpx/debug.h>
+#include <libhpx/padding.h>
+#include <libhpx/parcel.h>
+#include "init.h"
+#include "exit.h"
+
+/// The type information that we need in order to pack typed arguments.
+typedef struct {
+  handler_t      f;                     //!< the function for the trampoline
+  int        nargs;                     //!< the number of packed arguments
+  size_t     bytes;                     //!< the total packed size
+  size_t sizes[];                       //!< the size of each argument
+} _typed_env_t;
+
+static size_t _slot(size_t size) {
+  return size + ALIGN(size, 8);
+}
+
+static void _pack_typed(const void *obj, hpx_parcel_t *p, int n,
+                        va_list *args) {
+  const action_t *action = obj;
+  const _typed_env_t *env = action->env;
+
+  DEBUG_IF (n != env->nargs) {
+    const char *key = action->key;
+    dbg_error("%s requires %d arguments (%d given).\n", key, env->nargs, n);
+  }
+
+  char *buffer = hpx_parcel_get_data(p);
+  for (int i = 0; i < n; ++i) {
+    const void *arg = va_arg(*args, const void*);
+    memcpy(buffer, arg, env->sizes[i]);
+    buffer += _slot(env->sizes[i]);
+  }
+}
+
+static size_t _payload_typed(const void *obj, int n, va_list *args) {
+  const action_t *action = obj;
+  const _typed_env_t *env = action->env;
+  return env->bytes;
+}
+
+static hpx_parcel_t *_new_typed(const void *obj, hpx_addr_t addr,
+                                hpx_addr_t c_addr, hpx_action_t c_action,
+                                int n, va_list *args) {
+  const action_t *action = obj;
+  const _typed_env_t *env = action->env;
+  hpx_action_t id = *action->id;
+  hpx_pid_t pid = hpx_thread_current_pid();
+  hpx_parcel_t *p = parcel_new(addr, id, c_addr, c_action, pid, NULL,
+                               env->bytes);
+  _pack_typed(obj, p, n, args);
+  return p;
+}
+
+static int _exec_typed(const void *obj, hpx_parcel_t *p) {
+  const action_t *action = obj;
+  const _typed_env_t *env = action->env;
+  hpx_typed_action_handler_t handler =
+      (hpx_typed_action_handler_t)action->handler;
+  void *args = hpx_parcel_get_data(p);
+  return handler(env->f, args, p->size);
+}
+
+static int _exec_pinned_typed(const void *obj, hpx_parcel_t *p) {
+  void *target;
+  if (!hpx_gas_try_pin(p->target, &target)) {
+    log_action("pinned action resend.\n");
+    return HPX_RESEND;
+  }
+
+  const action_t *action = obj;
+  const _typed_env_t *env = action->env;
+  hpx_pinned_typed_action_handler_t handler =
+      (hpx_pinned_typed_action_handler_t)action->handler;
+  void *args = hpx_parcel_get_data(p);
+  int e = handler(env->f, target, args, p->size);
+  hpx_gas_unpin(p->target);
+  return e;
+}
+
+static void _typed_finish(void *act) {
+  action_t *action = act;
+  log_action("%d: %s (%p) %s %x.\n", *action->id, action->key,
+             (void*)(uintptr_t)action->handler,
+             HPX_ACTION_TYPE_TO_STRING[action->type],
+             action->attr);
+  (void)action;
+}
+
+static void _typed_fini(void *act) {
+  action_t *action = act;
+  free(action->env);
+}
+
+static const parcel_management_vtable_t _typed_vtable = {
+  .new_parcel = _new_typed,
+  .pack_parcel = _pack_typed,
+  .exec_parcel = _exec_typed,
+  .payload_size = _payload_typed,
+  .exit = exit_action
+};
+
+static const parcel_management_vtable_t _pinned_typed_vtable = {
+  .new_parcel = _new_typed,
+  .pack_parcel = _pack_typed,
+  .exec_parcel = _exec_pinned_typed,
+  .payload_size = _payload_typed,
+  .exit = exit_pinned_action
+};
+
+void action_init_typed(action_t *action, int n, va_list *args) {
+  dbg_assert(n > 0);
+
+  // The first argument after the trampoline is the function that it calls.
+  handler_t f = va_arg(*args, handler_t);
+  n--;
+
+  // Pinned actions don't send their first argument, which must be a pointer.
+  uint32_t pinned = action->attr & HPX_PINNED;
+  if (pinned && (!n-- || va_arg(*args, hpx_type_t) != HPX_POINTER)) {
+    dbg_error("First type of a pinned action should be HPX_POINTER\n");
+  }
+
+  _typed_env_t *env = malloc(sizeof(*env) + n * sizeof(env->sizes[0]));
+  dbg_assert(env);
+  env->f = f;
+  env->nargs = n;
+  env->bytes = 0;
+  for (int i = 0; i < n; ++i) {
+    hpx_type_t type = va_arg(*args, hpx_type_t);
+    env->sizes[i] = type->size;
+    env->bytes += _slot(type->size);
+  }
+  action->env = env;
+
+  // Initialize the parcel class.
+  if (pinned) {
+    action->parcel_class = &_pinned_typed_vtable;
+  }
+  else {
+    action->parcel_class = &_typed_vtable;
+  }
+
+  // Initialize the call class.
+  action_init_call_by_parcel(action);
+
+  // Initialize the destructor.
+  action->finish = _typed_finish;
+  action->fini = _typed_fini;
+}
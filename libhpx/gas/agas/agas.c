@@ -26,7 +26,9 @@
 #include <libhpx/memory.h>
 #include <libhpx/rebalancer.h>
 #include <libhpx/system.h>
+#include <libsync/sync.h>
 #include "agas.h"
+#include "blocked_table.h"
 #include "btt.h"
 #include "chunk_table.h"
 #include "gva.h"
@@ -35,15 +37,15 @@ static const uint64_t AGAS_THERE_OFFSET = UINT64_C(4398046511103);
 
 __thread size_t agas_alloc_bsize;
 
-HPX_ACTION_DECL(agas_alloc_cyclic);
-HPX_ACTION_DECL(agas_calloc_cyclic);
-
 static void
 _agas_dealloc(void *gas) {
   agas_t *agas = gas;
   if (agas->chunk_table) {
     chunk_table_delete(agas->chunk_table);
   }
+  if (agas->blocked_table) {
+    blocked_table_delete(agas->blocked_table);
+  }
   if (agas->btt) {
     btt_delete(agas->btt);
   }
@@ -51,18 +53,65 @@ _agas_dealloc(void *gas) {
     bitmap_delete(agas->bitmap);
   }
 
+  if (agas->cyclic_bitmap) {
+    bitmap_delete(agas->cyclic_bitmap);
+  }
+
   rebalancer_finalize();
+  free(agas);
+}
 
-  if (here->rank == 0) {
-    if (agas->cyclic_bitmap) {
-      bitmap_delete(agas->cyclic_bitmap);
-    }
+/// Look up the blocked segment that a cyclic address belongs to.
+///
+/// @param         agas The agas instance.
+/// @param          gva The cyclic address.
+/// @param[out]    base The base offset of the segment.
+/// @param[out]  blocks The number of blocks in the segment at each locality.
+///
+/// @returns            true if @p gva is part of a blocked allocation.
+static bool
+_blocked_lookup(const agas_t *agas, gva_t gva, uint64_t *base,
+                uint64_t *blocks) {
+  // Cyclic address arithmetic calls this for every address, so avoid the hash
+  // lookup entirely while there are no blocked allocations.
+  if (!sync_load(&agas->blocked_segments, SYNC_ACQUIRE)) {
+    return false;
   }
-  free(agas);
+
+  uint64_t chunk = gva.bits.offset / BLOCKED_TABLE_CHUNK_BYTES;
+  return blocked_table_lookup(agas->blocked_table, chunk, base, blocks);
+}
+
+/// Compute the logical byte position of a blocked address within its
+/// allocation.
+///
+/// Blocked allocations are laid out as a symmetric segment at each locality,
+/// where locality i stores blocks [i * blocks, (i + 1) * blocks) of the
+/// allocation contiguously.
+static int64_t
+_blocked_position(gva_t gva, uint64_t base, uint64_t blocks, uint32_t bsize) {
+  uint64_t  bits = gva.bits.size;
+  uint64_t  mask = (UINT64_C(1) << bits) - 1;
+  uint64_t  diff = gva.bits.offset - base;
+  uint64_t block = gva.bits.home * blocks + (diff >> bits);
+  return block * bsize + (diff & mask);
+}
+
+static hpx_addr_t
+_blocked_add(gva_t gva, uint64_t base, uint64_t blocks, int64_t bytes,
+             uint32_t bsize) {
+  int64_t position = _blocked_position(gva, base, blocks, bsize) + bytes;
+  dbg_assert_str(position >= 0, "blocked address arithmetic underflow\n");
+  uint64_t block = position / bsize;
+  uint64_t phase = position % bsize;
+  gva.bits.home = block / blocks;
+  gva.bits.offset = base + ((block % blocks) << gva.bits.size) + phase;
+  return gva.addr;
 }
 
 static int64_t
 _agas_sub(const void *gas, hpx_addr_t lhs, hpx_addr_t rhs, uint32_t bsize) {
+  const agas_t *agas = gas;
   gva_t l = { .addr = lhs };
   gva_t r = { .addr = rhs };
 
@@ -72,6 +121,11 @@ _agas_sub(const void *gas, hpx_addr_t lhs, hpx_addr_t rhs, uint32_t bsize) {
   }
 
   if (l.bits.cyclic && r.bits.cyclic) {
+    uint64_t base, blocks;
+    if (_blocked_lookup(agas, l, &base, &blocks)) {
+      return _blocked_position(l, base, blocks, bsize) -
+             _blocked_position(r, base, blocks, bsize);
+    }
     return gpa_sub_cyclic(lhs, rhs, bsize);
   }
 
@@ -86,6 +140,7 @@ _agas_sub(const void *gas, hpx_addr_t lhs, hpx_addr_t rhs, uint32_t bsize) {
 
 static hpx_addr_t
 _agas_add(const void *gas, hpx_addr_t addr, int64_t bytes, uint32_t bsize) {
+  const agas_t *agas = gas;
   gva_t gva = { .addr = addr };
   uint32_t size = ceil_log2_32(bsize);
   if (gva.bits.size != size) {
@@ -93,6 +148,10 @@ _agas_add(const void *gas, hpx_addr_t addr, int64_t bytes, uint32_t bsize) {
   }
 
   if (gva.bits.cyclic) {
+    uint64_t base, blocks;
+    if (_blocked_lookup(agas, gva, &base, &blocks)) {
+      return _blocked_add(gva, base, blocks, bytes, bsize);
+    }
     gva.addr = gpa_add_cyclic(addr, bytes, bsize);
     gva.bits.size = size;
     gva.bits.cyclic = 1;
@@ -148,12 +207,51 @@ void _agas_set_attr(void *gas, hpx_addr_t addr, uint32_t attr) {
   btt_set_attr(agas->btt, gva, attr);
 }
 
+/// Record the blocked layout of a segment in the cyclic address space.
+static void
+_blocked_insert(agas_t *agas, uint64_t offset, uint64_t blocks, uint32_t bsize) {
+  uint64_t chunk = offset / BLOCKED_TABLE_CHUNK_BYTES;
+  uint64_t n = ceil_div_64(blocks * bsize, BLOCKED_TABLE_CHUNK_BYTES);
+  for (uint64_t i = 0; i < n; ++i) {
+    blocked_table_insert(agas->blocked_table, chunk + i, offset, blocks);
+  }
+  sync_fadd(&agas->blocked_segments, 1, SYNC_RELEASE);
+}
+
+void
+agas_blocked_remove(agas_t *agas, gva_t base, uint64_t blocks) {
+  uint64_t offset, n;
+  if (!_blocked_lookup(agas, base, &offset, &n)) {
+    return;
+  }
+  dbg_assert(offset == base.bits.offset && n == blocks);
+
+  uint64_t  bsize = UINT64_C(1) << base.bits.size;
+  uint64_t  chunk = offset / BLOCKED_TABLE_CHUNK_BYTES;
+  uint64_t chunks = ceil_div_64(blocks * bsize, BLOCKED_TABLE_CHUNK_BYTES);
+  for (uint64_t i = 0; i < chunks; ++i) {
+    blocked_table_remove(agas->blocked_table, chunk + i);
+  }
+  sync_fadd(&agas->blocked_segments, -1, SYNC_RELEASE);
+}
+
 static int
 _locality_alloc_cyclic_handler(uint64_t blocks, uint32_t align, uint64_t offset,
-                               void *lva, uint32_t attr, int zero) {
+                               void *lva, uint32_t attr, int zero,
+                               int blocked) {
   agas_t *agas = (agas_t*)here->gas;
   uint32_t bsize = 1u << align;
-  if (here->rank != 0) {
+  gva_t gva = {
+    .bits = {
+      .offset = offset,
+      .cyclic = 1,
+      .size = align,
+      .home = here->rank
+    }
+  };
+
+  // The root already allocated its segment from its cyclic arena.
+  if (here->rank != agas_cyclic_root(agas, gva)) {
     uint32_t boundary = (bsize < 8) ? 8 : bsize;
     lva = NULL;
     int e = posix_memalign(&lva, boundary, blocks * bsize);
@@ -166,30 +264,38 @@ _locality_alloc_cyclic_handler(uint64_t blocks, uint32_t align, uint64_t offset,
   }
 
   // and insert entries into our block translation table
-  gva_t gva = {
-    .bits = {
-      .offset = offset,
-      .cyclic = 1,
-      .size = align,
-      .home = here->rank
-    }
-  };
-
   for (int i = 0; i < blocks; i++) {
     btt_insert(agas->btt, gva, here->rank, lva, blocks, attr);
     lva += bsize;
     gva.bits.offset += bsize;
   }
+
+  // Blocked segments need to be registered before any address arithmetic is
+  // performed on them, which is guaranteed by the rsync broadcast.
+  if (blocked) {
+    _blocked_insert(agas, offset, blocks, bsize);
+  }
   return HPX_SUCCESS;
 }
 static LIBHPX_ACTION(HPX_DEFAULT, 0, _locality_alloc_cyclic,
                      _locality_alloc_cyclic_handler, HPX_UINT64, HPX_UINT32,
-                     HPX_UINT64, HPX_POINTER, HPX_UINT32, HPX_INT);
-
-hpx_addr_t _agas_alloc_cyclic_sync(size_t n, uint32_t bsize, uint32_t attr,
-                                   int zero) {
+                     HPX_UINT64, HPX_POINTER, HPX_UINT32, HPX_INT, HPX_INT);
+
+/// Allocate a segment of @p n blocks in the cyclic address space.
+///
+/// Cyclic and blocked allocations share the same physical layout: every
+/// locality gets a symmetric segment of ceil(n / ranks) blocks, at the same
+/// offset. They differ only in how block indices map onto segments, which is
+/// resolved by address arithmetic. Blocked segments are padded to whole
+/// blocked table chunks so that the table can classify addresses by chunk.
+///
+/// The calling locality is the root of the allocation. It reserves the offset
+/// from its own range of the cyclic address space, so allocations at different
+/// localities proceed independently.
+static hpx_addr_t
+_agas_alloc_segment_sync(size_t n, uint32_t bsize, uint32_t attr, int zero,
+                         int blocked) {
   agas_t *agas = (agas_t*)here->gas;
-  dbg_assert(here->rank == 0);
 
   // Figure out how many blocks per node we need.
   uint64_t blocks = ceil_div_64(n, here->ranks);
@@ -197,79 +303,214 @@ hpx_addr_t _agas_alloc_cyclic_sync(size_t n, uint32_t bsize, uint32_t attr,
   dbg_assert(align < 32);
   uint32_t padded = 1u << align;
 
+  size_t boundary = padded;
+  size_t bytes = blocks * padded;
+  if (blocked) {
+    boundary = max_size_t(boundary, BLOCKED_TABLE_CHUNK_BYTES);
+    bytes = ceil_div_size_t(bytes, BLOCKED_TABLE_CHUNK_BYTES) *
+            BLOCKED_TABLE_CHUNK_BYTES;
+  }
+
   agas_alloc_bsize = padded;
   // Allocate the blocks as a contiguous, aligned array from cyclic memory.
-  void *lva = cyclic_memalign(padded, blocks * padded);
+  void *lva = cyclic_memalign(boundary, bytes);
   if (!lva) {
     dbg_error("failed cyclic allocation\n");
   }
 
+  // The first block of the array is always at rank 0.
   gva_t gva = agas_lva_to_gva(agas, lva, padded);
   gva.bits.cyclic = 1;
+  gva.bits.home = 0;
   uint64_t offset = gva.bits.offset;
   int e = hpx_bcast_rsync(_locality_alloc_cyclic, &blocks, &align, &offset,
-                          &lva, &attr, &zero);
+                          &lva, &attr, &zero, &blocked);
   dbg_check(e, "failed to insert btt entries.\n");
 
   // and return the address
   return gva.addr;
 }
 
-hpx_addr_t agas_alloc_cyclic_sync(size_t n, uint32_t bsize, uint32_t attr) {
-  dbg_assert(here->rank == 0);
-  return _agas_alloc_cyclic_sync(n, bsize, attr, 0);
+static hpx_addr_t
+_agas_alloc_cyclic(size_t n, uint32_t bsize, uint32_t boundary, uint32_t attr) {
+  hpx_addr_t addr = _agas_alloc_segment_sync(n, bsize, attr, 0, 0);
+  dbg_assert_str(addr != HPX_NULL, "HPX_NULL is not a valid allocation\n");
+  return addr;
 }
 
-static int _alloc_cyclic_handler(size_t n, size_t bsize, uint32_t attr) {
-  hpx_addr_t addr = agas_alloc_cyclic_sync(n, bsize, attr);
-  return HPX_THREAD_CONTINUE(addr);
+static hpx_addr_t
+_agas_calloc_cyclic(size_t n, uint32_t bsize, uint32_t boundary,
+                    uint32_t attr) {
+  hpx_addr_t addr = _agas_alloc_segment_sync(n, bsize, attr, 1, 0);
+  dbg_assert_str(addr != HPX_NULL, "HPX_NULL is not a valid allocation\n");
+  return addr;
 }
-LIBHPX_ACTION(HPX_DEFAULT, 0, agas_alloc_cyclic, _alloc_cyclic_handler,
-              HPX_SIZE_T, HPX_SIZE_T, HPX_UINT32);
 
+/// Allocate a blocked array.
+///
+/// Each locality gets a contiguous run of ceil(n / ranks) blocks, in locality
+/// order, so neighboring blocks are co-located. The blocks are still tracked
+/// individually by the BTT and can be moved one at a time.
 static hpx_addr_t
-_agas_alloc_cyclic(size_t n, uint32_t bsize, uint32_t boundary, uint32_t attr) {
-  hpx_addr_t addr;
-  if (here->rank == 0) {
-    addr = agas_alloc_cyclic_sync(n, bsize, attr);
-  }
-  else {
-    int e = hpx_call_sync(HPX_THERE(0), agas_alloc_cyclic, &addr, sizeof(addr),
-                          &n, &bsize, &attr);
-    dbg_check(e, "Failed to call agas_alloc_cyclic_handler.\n");
-  }
+_agas_alloc_blocked(size_t n, uint32_t bsize, uint32_t boundary,
+                    uint32_t attr) {
+  hpx_addr_t addr = _agas_alloc_segment_sync(n, bsize, attr, 0, 1);
   dbg_assert_str(addr != HPX_NULL, "HPX_NULL is not a valid allocation\n");
   return addr;
 }
 
-hpx_addr_t agas_calloc_cyclic_sync(size_t n, uint32_t bsize, uint32_t attr) {
-  assert(here->rank == 0);
-  return _agas_alloc_cyclic_sync(n, bsize, attr, 1);
+static hpx_addr_t
+_agas_calloc_blocked(size_t n, uint32_t bsize, uint32_t boundary,
+                     uint32_t attr) {
+  hpx_addr_t addr = _agas_alloc_segment_sync(n, bsize, attr, 1, 1);
+  dbg_assert_str(addr != HPX_NULL, "HPX_NULL is not a valid allocation\n");
+  return addr;
 }
 
-static int _calloc_cyclic_handler(size_t n, size_t bsize, uint32_t attr) {
-  hpx_addr_t addr = agas_calloc_cyclic_sync(n, bsize, attr);
-  return HPX_THREAD_CONTINUE(addr);
+/// The arguments for an allocation with a user-defined distribution.
+///
+/// The distribution callback is only meaningful at the calling locality, so it
+/// evaluates the owner for each block there, reserves the placement in the
+/// cyclic address space, and broadcasts the arguments as-is.
+typedef struct {
+  uint64_t        n;
+  uint64_t   blocks;
+  uint64_t   offset;
+  void         *lva;
+  uint32_t    align;
+  uint32_t     attr;
+  int          zero;
+  uint32_t owners[];
+} _alloc_user_args_t;
+
+/// Insert the BTT entries for an allocation with a user-defined distribution.
+///
+/// The allocation is laid out as a cyclic allocation, so that normal cyclic
+/// address arithmetic applies. Blocks whose owner is not their cyclic home are
+/// then placed exactly as if they had been moved to their owner: the home
+/// keeps its segment entry, marked with the owner, and the owner gets its own
+/// single-block entry for the block.
+static int
+_locality_alloc_user_handler(_alloc_user_args_t *args, size_t size) {
+  agas_t *agas = (agas_t*)here->gas;
+  uint32_t bsize = 1u << args->align;
+  uint32_t ranks = here->ranks;
+  uint32_t  rank = here->rank;
+  dbg_assert(size == sizeof(*args) + args->n * sizeof(args->owners[0]));
+
+  gva_t gva = {
+    .bits = {
+      .offset = args->offset,
+      .cyclic = 1,
+      .size = args->align,
+      .home = rank
+    }
+  };
+
+  char *lva = args->lva;
+  if (rank != agas_cyclic_root(agas, gva)) {
+    uint32_t boundary = (bsize < 8) ? 8 : bsize;
+    int e = posix_memalign((void**)&lva, boundary, args->blocks * bsize);
+    dbg_check(e, "Failed memalign\n");
+    (void)e;
+  }
+
+  if (args->zero) {
+    memset(lva, 0, args->blocks * bsize);
+  }
+
+  // insert entries for the segment that is home here
+  for (uint64_t j = 0; j < args->blocks; ++j) {
+    uint64_t i = j * ranks + rank;
+    uint32_t owner = (i < args->n) ? args->owners[i] : rank;
+    btt_insert(agas->btt, gva, owner, lva, args->blocks, args->attr);
+    lva += bsize;
+    gva.bits.offset += bsize;
+  }
+
+  // and entries for the blocks that are placed here, but are home elsewhere
+  for (uint64_t i = 0; i < args->n; ++i) {
+    if (args->owners[i] != rank || i % ranks == rank) {
+      continue;
+    }
+
+    void *block = (args->zero) ? calloc(1, bsize) : malloc(bsize);
+    dbg_assert(block);
+    gva.bits.offset = args->offset + (i / ranks) * bsize;
+    gva.bits.home = i % ranks;
+    btt_insert(agas->btt, gva, rank, block, 1, args->attr);
+  }
+  return HPX_SUCCESS;
 }
-LIBHPX_ACTION(HPX_DEFAULT, 0, agas_calloc_cyclic, _calloc_cyclic_handler,
-              HPX_SIZE_T, HPX_SIZE_T, HPX_UINT32);
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _locality_alloc_user,
+                     _locality_alloc_user_handler, HPX_POINTER, HPX_SIZE_T);
 
 static hpx_addr_t
-_agas_calloc_cyclic(size_t n, uint32_t bsize, uint32_t boundary,
-                    uint32_t attr) {
-  hpx_addr_t addr;
-  if (here->rank == 0) {
-    addr = agas_calloc_cyclic_sync(n, bsize, attr);
+_agas_alloc_user_sync(_alloc_user_args_t *args, size_t size) {
+  agas_t *agas = (agas_t*)here->gas;
+  uint32_t padded = 1u << args->align;
+  args->blocks = ceil_div_64(args->n, here->ranks);
+
+  agas_alloc_bsize = padded;
+  void *lva = cyclic_memalign(padded, args->blocks * padded);
+  if (!lva) {
+    dbg_error("failed cyclic allocation\n");
   }
-  else {
-    int e = hpx_call_sync(HPX_THERE(0), agas_calloc_cyclic, &addr, sizeof(addr),
-                          &n, &bsize, &attr);
-    dbg_check(e, "Failed to call agas_calloc_cyclic_handler.\n");
+
+  gva_t gva = agas_lva_to_gva(agas, lva, padded);
+  gva.bits.cyclic = 1;
+  gva.bits.home = 0;
+  args->offset = gva.bits.offset;
+  args->lva = lva;
+  int e = hpx_bcast_rsync(_locality_alloc_user, args, size);
+  dbg_check(e, "failed to insert btt entries.\n");
+  return gva.addr;
+}
+
+static hpx_addr_t
+_agas_alloc_user_with(size_t n, uint32_t bsize, hpx_gas_dist_t dist,
+                      uint32_t attr, int zero) {
+  const agas_t *agas = (agas_t*)here->gas;
+  uint32_t align = ceil_log2_32(bsize);
+  dbg_assert(align < 32);
+
+  size_t size = sizeof(_alloc_user_args_t) + n * sizeof(uint32_t);
+  _alloc_user_args_t *args = malloc(size);
+  dbg_assert(args);
+  args->n = n;
+  args->blocks = 0;
+  args->offset = 0;
+  args->lva = NULL;
+  args->align = align;
+  args->attr = attr;
+  args->zero = zero;
+  for (size_t i = 0; i < n; ++i) {
+    args->owners[i] = _agas_owner_of(agas, dist(i, n, bsize));
+    dbg_assert(args->owners[i] < here->ranks);
   }
+
+  hpx_addr_t addr = _agas_alloc_user_sync(args, size);
+  free(args);
   dbg_assert_str(addr != HPX_NULL, "HPX_NULL is not a valid allocation\n");
   return addr;
 }
 
+/// Allocate an array with a user-defined distribution.
+///
+/// Each block i is placed at the owner of dist(i, n, bsize) at allocation
+/// time, which avoids a pass of hpx_gas_move() operations after allocation.
+static hpx_addr_t
+_agas_alloc_user(size_t n, uint32_t bsize, uint32_t boundary,
+                 hpx_gas_dist_t dist, uint32_t attr) {
+  return _agas_alloc_user_with(n, bsize, dist, attr, 0);
+}
+
+static hpx_addr_t
+_agas_calloc_user(size_t n, uint32_t bsize, uint32_t boundary,
+                  hpx_gas_dist_t dist, uint32_t attr) {
+  return _agas_alloc_user_with(n, bsize, dist, attr, 1);
+}
+
 static gas_t _agas_vtable = {
   .type           = HPX_GAS_AGAS,
   .string = {
@@ -281,6 +522,8 @@ static gas_t _agas_vtable = {
     .memput_rsync = agas_memput_rsync,
     .memcpy       = agas_memcpy,
     .memcpy_sync  = agas_memcpy_sync,
+    .memget_vec   = agas_memget_vec,
+    .memput_vec   = agas_memput_vec
   },
   .dealloc        = _agas_dealloc,
   .local_size     = NULL,
@@ -292,8 +535,10 @@ static gas_t _agas_vtable = {
   .unpin          = _agas_unpin,
   .alloc_cyclic   = _agas_alloc_cyclic,
   .calloc_cyclic  = _agas_calloc_cyclic,
-  .alloc_blocked  = NULL,
-  .calloc_blocked = NULL,
+  .alloc_blocked  = _agas_alloc_blocked,
+  .calloc_blocked = _agas_calloc_blocked,
+  .alloc_user     = _agas_alloc_user,
+  .calloc_user    = _agas_calloc_user,
   .alloc_local    = agas_alloc_local,
   .calloc_local   = agas_calloc_local,
   .free           = agas_free,
@@ -309,6 +554,8 @@ gas_t *gas_agas_new(const config_t *config, boot_t *boot) {
   agas_alloc_bsize = 0;
   agas->vtable = _agas_vtable;
   agas->chunk_table = chunk_table_new(0);
+  agas->blocked_table = blocked_table_new(0);
+  agas->blocked_segments = 0;
   agas->btt = btt_new(0);
 
   // initialize the rebalancer
@@ -324,20 +571,28 @@ gas_t *gas_agas_new(const config_t *config, boot_t *boot) {
   agas->bitmap = bitmap_new(nchunks, min_align, base_align);
   agas_global_allocator_init(agas);
 
-  if (here->rank == 0) {
-    size_t nchunks = ceil_div_size_t(here->ranks * heap_size, agas->chunk_size);
-    uint32_t min_align = ceil_log2_64(agas->chunk_size);
-    uint32_t base_align = ceil_log2_64(heap_size);
-    agas->cyclic_bitmap = bitmap_new(nchunks, min_align, base_align);
-    log_gas("allocated the arena to manage cyclic allocations.\n");
-    agas_cyclic_allocator_init(agas);
-  }
+  // Every locality reserves an equal, aligned range of the cyclic address
+  // space, and manages it with its own cyclic arena.
+  agas->cyclic_bits = GVA_OFFSET_BITS - ceil_log2_32(here->ranks);
+  size_t cyclic_size = 1lu << agas->cyclic_bits;
+  dbg_assert(cyclic_size >= agas->chunk_size);
+  nchunks = ceil_div_size_t(cyclic_size, agas->chunk_size);
+  agas->cyclic_bitmap = bitmap_new(nchunks, min_align, agas->cyclic_bits);
+  log_gas("allocated the arena to manage cyclic allocations.\n");
+  agas_cyclic_allocator_init(agas);
 
   gva_t there = { .addr = _agas_there(agas, here->rank) };
   btt_insert(agas->btt, there, here->rank, here, 1, HPX_GAS_ATTR_NONE);
   return &agas->vtable;
 }
 
+/// Get the offset of the first chunk managed by a bitmap.
+static uint64_t _bitmap_base(const agas_t *agas, const void *bitmap) {
+  if (bitmap == agas->cyclic_bitmap) {
+    return agas_cyclic_base(agas, here->rank);
+  }
+  return 0;
+}
 
 void *
 agas_chunk_alloc(agas_t *agas, void *bitmap, void *addr, size_t n, size_t align)
@@ -348,11 +603,11 @@ agas_chunk_alloc(agas_t *agas, void *bitmap, void *addr, size_t n, size_t align)
   uint32_t bit;
   int e = bitmap_reserve(bitmap, nbits, log2_align, &bit);
   dbg_check(e, "Could not reserve gva for %lu bytes\n", n);
-  uint64_t offset = bit * agas->chunk_size;
+  uint64_t offset = _bitmap_base(agas, bitmap) + bit * agas->chunk_size;
 
   // 2) get backing memory
   align = 1 << log2_align;
-  void *base = system_mmap(NULL, addr, n, align);
+  void *base = system_mmap_huge_pages(NULL, addr, n, align);
   dbg_assert(base);
   dbg_assert(((uintptr_t)base & (align - 1)) == 0);
 
@@ -372,11 +627,11 @@ agas_chunk_dalloc(agas_t *agas, void *bitmap, void *addr, size_t n) {
   // 1) release the bits
   uint64_t offset = chunk_table_lookup(agas->chunk_table, addr);
   uint32_t nbits = ceil_div_64(n, agas->chunk_size);
-  uint32_t bit = offset / agas->chunk_size;
+  uint32_t bit = (offset - _bitmap_base(agas, bitmap)) / agas->chunk_size;
   bitmap_release(bitmap, bit, nbits);
 
   // 2) unmap the backing memory
-  system_munmap(NULL, addr, n);
+  system_munmap_huge_pages(NULL, addr, n);
 
   // 3) remove the inverse mappings
   char *chunk = addr;
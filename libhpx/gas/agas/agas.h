@@ -29,11 +29,27 @@ typedef struct {
   gas_t vtable;
   size_t chunk_size;
   void *chunk_table;
+  void *blocked_table;
+  volatile uint64_t blocked_segments;
   void *btt;
   void *bitmap;
   void *cyclic_bitmap;
+  uint32_t cyclic_bits;
 } agas_t;
 
+/// Get the base offset of a locality's range of the cyclic address space.
+static inline uint64_t agas_cyclic_base(const agas_t *agas, uint32_t rank) {
+  return (uint64_t)rank << agas->cyclic_bits;
+}
+
+/// Get the locality that allocated the cyclic segment containing @p gva.
+///
+/// The root is responsible for returning the segment's address space to its
+/// cyclic arena when the allocation is freed.
+static inline uint32_t agas_cyclic_root(const agas_t *agas, gva_t gva) {
+  return gva.bits.offset >> agas->cyclic_bits;
+}
+
 // set the block size of an allocation out-of-band using this TLS
 // variable
 extern __thread size_t agas_alloc_bsize;
@@ -70,6 +86,12 @@ int agas_memcpy(void *gas, hpx_addr_t to, hpx_addr_t from, size_t size,
 
 int agas_memcpy_sync(void *gas, hpx_addr_t to, hpx_addr_t from, size_t size);
 
+int agas_memget_vec(void *gas, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync);
+
+int agas_memput_vec(void *gas, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync, hpx_addr_t rsync);
+
 gva_t agas_lva_to_gva(agas_t *gas, void *lva, uint32_t bsize);
 
 hpx_addr_t agas_alloc_local(size_t n, uint32_t bsize, uint32_t boundary,
@@ -85,6 +107,11 @@ hpx_addr_t agas_add_local(const agas_t *agas, gva_t gva, int64_t bytes,
 
 void agas_free(void *gas, hpx_addr_t addr, hpx_addr_t rsync);
 
+/// Forget the blocked layout of a segment in the cyclic address space.
+///
+/// This is a no-op for segments that belong to normal cyclic allocations.
+void agas_blocked_remove(agas_t *agas, gva_t base, uint64_t blocks);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,72 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <cuckoohash_map.hh>
+#include <city_hasher.hh>
+#include "blocked_table.h"
+
+namespace {
+  struct Segment {
+    uint64_t base;
+    uint64_t blocks;
+  };
+
+  typedef cuckoohash_map<uint64_t, Segment, CityHasher<uint64_t> > BlockedTable;
+}
+
+void *
+blocked_table_new(size_t size) {
+  return new BlockedTable(size);
+}
+
+void
+blocked_table_delete(void *obj) {
+  BlockedTable *table = static_cast<BlockedTable*>(obj);
+  delete table;
+}
+
+bool
+blocked_table_lookup(const void *obj, uint64_t chunk, uint64_t *base,
+                     uint64_t *blocks) {
+  const BlockedTable *table = static_cast<const BlockedTable*>(obj);
+  Segment segment;
+  if (!table->find(chunk, segment)) {
+    return false;
+  }
+  *base = segment.base;
+  *blocks = segment.blocks;
+  return true;
+}
+
+void
+blocked_table_insert(void *obj, uint64_t chunk, uint64_t base,
+                     uint64_t blocks) {
+  BlockedTable *table = static_cast<BlockedTable*>(obj);
+  Segment segment = { base, blocks };
+  bool inserted = table->insert(chunk, segment);
+  assert(inserted);
+  (void)inserted;
+}
+
+void
+blocked_table_remove(void *obj, uint64_t chunk) {
+  BlockedTable *table = static_cast<BlockedTable*>(obj);
+  bool erased = table->erase(chunk);
+  assert(erased);
+  (void)erased;
+}
@@ -0,0 +1,49 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+
+#ifndef LIBHPX_GAS_AGAS_BLOCKED_TABLE_H
+#define LIBHPX_GAS_AGAS_BLOCKED_TABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// The blocked table records the layout of the blocked allocations that are
+/// live in the cyclic address space. It maps each chunk of virtual address
+/// space that is covered by a blocked segment to the segment's base offset and
+/// its number of blocks per locality. Every locality keeps a replica of the
+/// table, so blocked address arithmetic never requires communication.
+///
+/// Blocked segments are always aligned to, and a multiple of, the table's
+/// chunk size, so a chunk belongs to at most one segment. The table's chunk
+/// size is independent of the allocator's chunk size, which may be as large as
+/// half of the heap.
+#define BLOCKED_TABLE_CHUNK_BYTES (UINT64_C(1) << 21)
+
+void *blocked_table_new(size_t size);
+void blocked_table_delete(void *table);
+bool blocked_table_lookup(const void *table, uint64_t chunk, uint64_t *base,
+                          uint64_t *blocks);
+void blocked_table_insert(void *table, uint64_t chunk, uint64_t base,
+                          uint64_t blocks);
+void blocked_table_remove(void *table, uint64_t chunk);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHPX_GAS_AGAS_BLOCKED_TABLE_H
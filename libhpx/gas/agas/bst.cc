@@ -16,6 +16,7 @@
 #endif
 
 #include <cassert>
+#include <vector>
 #include <libhpx/libhpx.h>
 #include <libhpx/parcel.h>
 #include <libhpx/scheduler.h>
@@ -24,13 +25,14 @@
 #include "rebalancer.h"
 
 namespace {
+  // The accesses to a block, sparse and sorted by rank.
   struct Entry {
-    uint64_t *counts;
-    uint64_t *sizes;
-    Entry() : counts(NULL), sizes(NULL) {
+    std::vector<bst_access_t> accesses;
+    Entry() : accesses() {
     }
-    Entry(uint64_t *c, uint64_t *s) : counts(c), sizes(s) {
+    Entry(const bst_access_t *a, uint32_t n) : accesses(a, a + n) {
     }
+    void merge(const bst_access_t *a, uint32_t n);
   };
 
   typedef cuckoohash_map<uint64_t, Entry, CityHasher<uint64_t> > Map;
@@ -44,6 +46,29 @@ namespace {
 BST::BST(size_t size) : Map(size) {
 }
 
+void
+Entry::merge(const bst_access_t *a, uint32_t n) {
+  std::vector<bst_access_t> merged;
+  merged.reserve(accesses.size() + n);
+  auto i = accesses.begin(), e = accesses.end();
+  for (uint32_t j = 0; j < n; ++j) {
+    while (i != e && i->rank < a[j].rank) {
+      merged.push_back(*i++);
+    }
+    if (i != e && i->rank == a[j].rank) {
+      bst_access_t sum = *i++;
+      sum.count += a[j].count;
+      sum.size  += a[j].size;
+      merged.push_back(sum);
+    }
+    else {
+      merged.push_back(a[j]);
+    }
+  }
+  merged.insert(merged.end(), i, e);
+  accesses.swap(merged);
+}
+
 void *
 bst_new(size_t size) {
   return new BST(size);
@@ -62,7 +87,7 @@ bst_delete(void* obj) {
 // This handler constructs a sparse graph in the compressed storage
 // format (CSR) from the global BST.
 static size_t
-_bst_serialize(void *obj, char *buf) {
+_bst_serialize(void *obj, char *buf, size_t edges) {
   BST *bst = static_cast<BST*>(obj);
   unsigned ranks = here->ranks;
 
@@ -83,7 +108,7 @@ _bst_serialize(void *obj, char *buf) {
 
   // the length of the next two arrays depends on the number of neighbors
   uint64_t *adjncy = (uint64_t*)buf;
-  uint64_t *adjwgt = (uint64_t*)malloc(ranks*nsize);
+  uint64_t *adjwgt = (uint64_t*)malloc(edges*sizeof(uint64_t));
 
   int id   = 0;
   int nbrs = 0;
@@ -91,17 +116,18 @@ _bst_serialize(void *obj, char *buf) {
   {
     auto lt = bst->lock_table();
     for (const auto& item : lt) {
-      Entry entry = item.second;
+      const Entry& entry = item.second;
       uint64_t total_vwgt  = 0;
       uint64_t total_vsize = 0;
       int prev_nbrs = nbrs;
-      for (unsigned k = 0; k < ranks; ++k) {
-        if (entry.counts[k] != 0) {
+      for (const bst_access_t& access : entry.accesses) {
+        if (access.count != 0) {
+          unsigned k = access.rank;
           lnbrs[k].push_back(id);
           adjncy[nbrs] = k;
-          adjwgt[nbrs] = entry.counts[k] * entry.sizes[k];
-          total_vwgt  += entry.counts[k];
-          total_vsize += entry.sizes[k];
+          adjwgt[nbrs] = access.count * access.size;
+          total_vwgt  += access.count;
+          total_vsize += access.size;
           nbrs++;
         }
       }
@@ -111,8 +137,6 @@ _bst_serialize(void *obj, char *buf) {
       vsizes[id] = total_vsize;
       xadj[id]   = nbrs - prev_nbrs;
       id++;
-      free(entry.counts);
-      free(entry.sizes);
     }
   }
   *nedges = nbrs;
@@ -150,6 +174,16 @@ bst_serialize_to_parcel(void* obj, hpx_parcel_t **parcel) {
   int ranks = here->ranks;
   size_t nsize = nvtxs*sizeof(uint64_t);
 
+  // The access records are sparse, so count the edges to size the buffer.
+  size_t edges = 0;
+  {
+    auto lt = bst->lock_table();
+    for (const auto& item : lt) {
+      edges += item.second.accesses.size();
+    }
+  }
+  size_t esize = edges*sizeof(uint64_t);
+
   // Serialization format:
   // nvtxs  : sizeof(uint64_t)
   // vtxs   : nsize
@@ -157,29 +191,28 @@ bst_serialize_to_parcel(void* obj, hpx_parcel_t **parcel) {
   // vsizes : nsize
   // xadj   : nsize
   // nedges : sizeof(uint64_t)
-  // adjncy : ranks * nsize
-  // adjwgt : ranks * nsize
-  // lnbrs  : ranks * sizeof(uint64_t) + ranks * nsize
+  // adjncy : esize
+  // adjwgt : esize
+  // lnbrs  : ranks * sizeof(uint64_t) + esize
 
   size_t buf_size = (4*nsize) + (ranks+2)*sizeof(uint64_t)
-    + (3*ranks*nsize);
+    + (3*esize);
   *parcel = hpx_parcel_acquire(NULL, buf_size);
   char *buf = static_cast<char*>(hpx_parcel_get_data(*parcel));
-  size_t size = _bst_serialize(bst, buf);
+  size_t size = _bst_serialize(bst, buf, edges);
   (*parcel)->size = size;
+
+  // the statistics have been consumed, start over for the next epoch
+  bst->clear();
   return size;
 }
 
 void
-bst_upsert(void *obj, uint64_t block, uint64_t *counts, uint64_t *sizes) {
+bst_upsert(void *obj, uint64_t block, const bst_access_t *accesses,
+           uint32_t n) {
   BST *bst = static_cast<BST*>(obj);
   auto updatefn = [&](Entry& entry) {
-    for (unsigned i = 0; i < here->ranks; ++i) {
-      entry.counts[i] += counts[i];
-      entry.sizes[i]  += sizes[i];
-    }
-    free(counts);
-    free(sizes);
+    entry.merge(accesses, n);
   };
-  bst->upsert(block, updatefn, Entry(counts, sizes));
+  bst->upsert(block, updatefn, Entry(accesses, n));
 }
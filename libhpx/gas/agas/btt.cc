@@ -21,6 +21,7 @@
 #include <cuckoohash_map.hh>
 #include <city_hasher.hh>
 #include "btt.h"
+#include "tcache.h"
 
 namespace {
   struct Entry {
@@ -139,6 +140,7 @@ btt_remove(void *obj, gva_t gva) {
   uint64_t key = gva_to_key(gva);
   bool erased = btt->erase(key);
   assert(erased);
+  tcache_invalidate();
   (void)erased;
 }
 
@@ -173,10 +175,18 @@ btt_lookup(const void* obj, gva_t gva) {
 
 bool
 btt_get_owner(const void* obj, gva_t gva, uint32_t *owner) {
+  if (tcache_lookup(gva, owner, NULL)) {
+    return true;
+  }
+
   const BTT *btt = static_cast<const BTT*>(obj);
   Entry entry;
   uint64_t key = gva_to_key(gva);
+  uint64_t epoch = tcache_epoch();
   bool found = btt->find(key, entry);
+  if (found) {
+    tcache_insert(gva, epoch, entry.owner, entry.attr);
+  }
   if (owner) {
     *owner = found ? entry.owner : gva.bits.home;
   }
@@ -192,14 +202,23 @@ btt_set_owner(void* obj, gva_t gva, uint32_t owner) {
       entry.owner = owner;
     });
   assert(found);
+  tcache_invalidate();
 }
 
 bool
 btt_get_attr(const void* obj, gva_t gva, uint32_t *attr) {
+  if (tcache_lookup(gva, NULL, attr)) {
+    return true;
+  }
+
   const BTT *btt = static_cast<const BTT*>(obj);
   Entry entry;
   uint64_t key = gva_to_key(gva);
+  uint64_t epoch = tcache_epoch();
   bool found = btt->find(key, entry);
+  if (found) {
+    tcache_insert(gva, epoch, entry.owner, entry.attr);
+  }
   *attr = found ? entry.attr : HPX_GAS_ATTR_NONE;
   return found;
 }
@@ -213,6 +232,7 @@ btt_set_attr(void* obj, gva_t gva, uint32_t attr) {
       entry.attr |= attr;
     });
   assert(found);
+  tcache_invalidate();
 }
 
 size_t
@@ -297,6 +317,7 @@ int btt_remove_when_count_zero(void *obj, gva_t gva, void **lva) {
   int e = _btt_wait_until_count_zero(obj, gva, lva, NULL);
   bool erased = btt->erase(key);
   assert(erased);
+  tcache_invalidate();
   return e;
   (void)erased;
 }
@@ -19,28 +19,41 @@
 #include <libhpx/config.h>
 #include <libhpx/debug.h>
 #include <libhpx/libhpx.h>
+#include <libhpx/locality.h>
 #include <libhpx/memory.h>
 #include <malloc-2.8.6.h>
 #include "agas.h"
 #include "chunk_table.h"
 
-void _agas_allocator_init(agas_t *agas, int id) {
+/// Create an mspace for an address space.
+///
+/// The mspace is half of the heap, but never more than @p limit bytes, so that
+/// it stays within the range of offsets that the address space owns.
+void _agas_allocator_init(agas_t *agas, int id, uint64_t offset, size_t limit) {
   dbg_assert(id < AS_COUNT);
   const libhpx_config_t *cfg = libhpx_get_config();
   size_t bytes = ceil_div_size_t(cfg->heapsize, 2);
-  void *base = system_mmap(NULL, NULL, bytes, agas->chunk_size);
+  if (bytes > limit) {
+    log_gas("clamping the %zu byte arena to %zu bytes\n", bytes, limit);
+    bytes = limit;
+  }
+  void *base = system_mmap_huge_pages(NULL, NULL, bytes, agas->chunk_size);
   dbg_assert(base);
-  chunk_table_insert(agas->chunk_table, base, 0);
+  chunk_table_insert(agas->chunk_table, base, offset);
   mspaces[id] = create_mspace_with_base(base, bytes, 1);
 }
 
 void
 agas_cyclic_allocator_init(agas_t *agas) {
-  _agas_allocator_init(agas, AS_CYCLIC);
+  // Each locality's cyclic arena must fit in its range of the cyclic address
+  // space, or the ranges of neighbouring localities would overlap.
+  uint64_t base = agas_cyclic_base(agas, here->rank);
+  size_t limit = UINT64_C(1) << agas->cyclic_bits;
+  _agas_allocator_init(agas, AS_CYCLIC, base, limit);
 }
 
 void
 agas_global_allocator_init(agas_t *agas) {
-  _agas_allocator_init(agas, AS_GLOBAL);
+  _agas_allocator_init(agas, AS_GLOBAL, 0, UINT64_C(1) << GVA_OFFSET_BITS);
 }
 
@@ -104,11 +104,20 @@ static int _agas_free_segment_handler(hpx_addr_t base) {
   hpx_lco_delete(and, HPX_NULL);
 
   // We need to release the memory backing the segment if it is part of a cyclic
-  // allocation and is not the rank 0 segment, which is dealt with by the
-  // _agas_free_async handler. These asymmetries are a result of the way that we
-  // do all cyclic memory management at rank 0.
-  if (gva.bits.cyclic && here->rank != 0) {
-    free(lva);
+  // allocation. The root of the allocation got its segment from its cyclic
+  // arena, which also returns the segment's address space, while the other
+  // localities allocated theirs with the system allocator.
+  if (gva.bits.cyclic) {
+    // Blocked allocations share the cyclic segment layout, but each locality
+    // also keeps a replica of their layout for address arithmetic.
+    agas_blocked_remove(agas, gva, blocks);
+
+    if (here->rank == agas_cyclic_root(agas, gva)) {
+      cyclic_free(lva);
+    }
+    else {
+      free(lva);
+    }
   }
 
   return HPX_SUCCESS;
@@ -132,18 +141,21 @@ static int _agas_free_async_handler(hpx_addr_t base) {
   gva_t   gva = { .addr = base };
   dbg_assert(gva.bits.home == here->rank);
 
-  // We need to free this after everything has been cleaned up.
-  void   *lva = btt_lookup(gas->btt, gva);
-  dbg_assert_str(lva, "No btt entry for %"PRIu64" at %d\n", gva.addr, here->rank);
-
   // Cyclic allocations have segments at each rank, so we broadcast the command
-  // to clean up the segment. Otherwise we just clean up the local segment. We
-  // optimize here for single-block allocations by skipping the segment code.
+  // to clean up the segment, and each segment's memory is released as part of
+  // that.
   if (gva.bits.cyclic) {
     dbg_check( hpx_bcast_rsync(_agas_free_segment, &base) );
-    cyclic_free(lva);
+    return HPX_SUCCESS;
   }
-  else if (btt_get_blocks(gas->btt, gva) == 1) {
+
+  // We need to free this after everything has been cleaned up.
+  void   *lva = btt_lookup(gas->btt, gva);
+  dbg_assert_str(lva, "No btt entry for %"PRIu64" at %d\n", gva.addr, here->rank);
+
+  // Otherwise we just clean up the local segment. We optimize here for
+  // single-block allocations by skipping the segment code.
+  if (btt_get_blocks(gas->btt, gva) == 1) {
     dbg_check( hpx_call_sync(base, _agas_free_block, NULL, 0, &base) );
     global_free(lva);
   }
@@ -44,6 +44,9 @@ static void *_cyclic_chunk_alloc(void *addr, size_t n, size_t align, bool *zero,
     return NULL;
   }
 
+  // Place the chunk before anything touches it.
+  as_chunk_place(chunk, n, arena);
+
   // If we are asked to zero a chunk, then we do so.
   if (*zero) {
     memset(chunk, 0, n);
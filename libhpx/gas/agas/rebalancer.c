@@ -17,6 +17,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <libhpx/action.h>
 #include <libhpx/config.h>
@@ -36,25 +37,78 @@
 // Block Statistics Table (BST) entry.
 //
 // The BST entry maintains statistics about block accesses. In
-// particular, the number of times a block was accessed (@p counts)
-// and the size of data transferred (@p sizes) is maintained. The
-// index in the @p counts and @p sizes array represents the node which
-// accessed this block. Each worker thread maintains its own private
-// thread-local BST so that insertions into the BST don't have to be
-// synchronized.
+// particular, the number of times a block was accessed and the size
+// of data transferred is maintained for each node that accessed the
+// block. Most blocks are only accessed by a few nodes, so the
+// @p accesses array is sparse, sorted by rank, and grows on
+// demand. Each worker thread maintains its own private thread-local
+// BST so that insertions into the BST don't have to be synchronized.
 typedef struct agas_bst {
   uint64_t block;
-  uint64_t *counts;
-  uint64_t *sizes;
+  uint32_t n;
+  uint32_t capacity;
+  bst_access_t *accesses;
   UT_hash_handle hh;
 } agas_bst_t;
 
+// The number of accesses to skip before the next sample, per worker.
+static __thread int _countdown = 0;
+
 // Per-locality BST.
 //
 // During statistics aggration, all of the thread-local BSTs are
 // aggregated into a per-locality BST.
 static void *_global_bst = NULL;
 
+// Decide if the current access should be sampled.
+//
+// Accesses are sampled at random intervals whose mean is the
+// configured sampling rate N, which avoids aliasing with periodic
+// access patterns. Each sample stands for N accesses.
+//
+// @returns The weight of the sample, or 0 if the access is skipped.
+static uint64_t _sample(void) {
+  int n = here->config->agas_rebalance_sample;
+  if (n <= 1) {
+    return 1;
+  }
+
+  if (--_countdown > 0) {
+    return 0;
+  }
+
+  _countdown = 1 + rand_r(&self->seed) % (2 * n - 1);
+  return n;
+}
+
+// Find the access record for @p rank in a BST entry, inserting it in
+// rank order if it does not exist yet.
+static bst_access_t *_get_access(agas_bst_t *entry, uint32_t rank) {
+  uint32_t i = 0;
+  while (i < entry->n && entry->accesses[i].rank < rank) {
+    ++i;
+  }
+
+  if (i < entry->n && entry->accesses[i].rank == rank) {
+    return &entry->accesses[i];
+  }
+
+  if (entry->n == entry->capacity) {
+    entry->capacity = (entry->capacity) ? 2 * entry->capacity : 2;
+    size_t bytes = entry->capacity * sizeof(bst_access_t);
+    entry->accesses = realloc(entry->accesses, bytes);
+    dbg_assert(entry->accesses);
+  }
+
+  memmove(&entry->accesses[i + 1], &entry->accesses[i],
+          (entry->n - i) * sizeof(bst_access_t));
+  entry->n++;
+  entry->accesses[i].count = 0;
+  entry->accesses[i].size = 0;
+  entry->accesses[i].rank = rank;
+  return &entry->accesses[i];
+}
+
 // Add an entry to the rebalancer's (thread-local) BST table.
 ///
 /// @param      src The "src" locality accessing the block.
@@ -68,6 +122,12 @@ void rebalancer_add_entry(int src, int dst, hpx_addr_t block, size_t size) {
     return;
   }
 
+  // only record a sample of the accesses, before doing any other work
+  uint64_t weight = _sample();
+  if (likely(!weight)) {
+    return;
+  }
+
   const agas_t *agas = here->gas;
   dbg_assert(agas && agas->btt);
 
@@ -88,14 +148,16 @@ void rebalancer_add_entry(int src, int dst, hpx_addr_t block, size_t size) {
     entry = malloc(sizeof(*entry));
     dbg_assert(entry);
     entry->block = block;
-    entry->counts = calloc(here->ranks, sizeof(uint64_t));
-    entry->sizes = calloc(here->ranks, sizeof(uint64_t));
+    entry->n = 0;
+    entry->capacity = 0;
+    entry->accesses = NULL;
     HASH_ADD(hh, *bst, block, sizeof(uint64_t), entry);
   }
 
-  // otherwise, simply update the counts and sizes
-  entry->counts[src]++;
-  entry->sizes[src] += size;
+  // then update the counts and sizes, scaled by the sampling rate
+  bst_access_t *access = _get_access(entry, src);
+  access->count += weight;
+  access->size += weight * size;
 }
 
 // Initialize the AGAS-based rebalancer.
@@ -129,8 +191,9 @@ int _local_to_global_bst(int id, void *UNUSED) {
   log_gas("Added %u entries to global BST.\n", HASH_COUNT(*bst));
   agas_bst_t *entry, *tmp;
   HASH_ITER(hh, *bst, entry, tmp) {
-    bst_upsert(_global_bst, entry->block, entry->counts, entry->sizes);
+    bst_upsert(_global_bst, entry->block, entry->accesses, entry->n);
     HASH_DEL(*bst, entry);
+    free(entry->accesses);
     free(entry);
   }
   HASH_CLEAR(hh, *bst);
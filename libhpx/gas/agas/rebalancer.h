@@ -20,10 +20,18 @@ extern "C" {
 
 #include <hpx/hpx.h>
     
+// The (estimated) accesses to a block from a single locality.
+typedef struct {
+  uint64_t count;
+  uint64_t  size;
+  uint32_t  rank;
+} bst_access_t;
+
 // Block Statistics Table (BST) API
 void *bst_new(size_t size);
 void bst_delete(void *bst);
-void bst_upsert(void *obj, uint64_t block, uint64_t *counts, uint64_t *sizes);
+void bst_upsert(void *obj, uint64_t block, const bst_access_t *accesses,
+                uint32_t n);
 size_t bst_serialize_to_parcel(void* obj, hpx_parcel_t **parcel);
 
 // AGAS Graph Partitioning API
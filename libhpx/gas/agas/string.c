@@ -283,3 +283,66 @@ int agas_memcpy_sync(void *gas, hpx_addr_t to, hpx_addr_t from, size_t size) {
   hpx_lco_delete(sync, HPX_NULL);
   return e;
 }
+
+/// Copy out the leading regions of a vector that are local.
+///
+/// We copy regions until we find one that we can't pin, and return its index
+/// so that the caller can forward the rest of the vector to the network with a
+/// single completion.
+static int _memget_vec_local(agas_t *agas, const hpx_gas_iovec_t *iov, int n) {
+  for (int i = 0; i < n; ++i) {
+    if (!iov[i].size) {
+      continue;
+    }
+
+    gva_t gva = { .addr = iov[i].global };
+    void *lfrom = NULL;
+    if (!btt_try_pin(agas->btt, gva, &lfrom)) {
+      return i;
+    }
+    memcpy(iov[i].local, lfrom, iov[i].size);
+    btt_unpin(agas->btt, gva);
+  }
+  return n;
+}
+
+/// Copy in the leading regions of a vector that are local.
+static int _memput_vec_local(agas_t *agas, const hpx_gas_iovec_t *iov, int n) {
+  for (int i = 0; i < n; ++i) {
+    if (!iov[i].size) {
+      continue;
+    }
+
+    gva_t gva = { .addr = iov[i].global };
+    void *lto = NULL;
+    if (!btt_try_pin(agas->btt, gva, &lto)) {
+      return i;
+    }
+    memcpy(lto, iov[i].local, iov[i].size);
+    btt_unpin(agas->btt, gva);
+  }
+  return n;
+}
+
+int agas_memget_vec(void *gas, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync) {
+  int i = _memget_vec_local(gas, iov, n);
+  if (i < n) {
+    return network_memget_vec(self->network, iov + i, n - i, lsync);
+  }
+
+  hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+  return HPX_SUCCESS;
+}
+
+int agas_memput_vec(void *gas, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync, hpx_addr_t rsync) {
+  int i = _memput_vec_local(gas, iov, n);
+  if (i < n) {
+    return network_memput_vec(self->network, iov + i, n - i, lsync, rsync);
+  }
+
+  hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+  hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+  return HPX_SUCCESS;
+}
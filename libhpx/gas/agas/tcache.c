@@ -0,0 +1,127 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <libhpx/config.h>
+#include <libhpx/debug.h>
+#include <libhpx/locality.h>
+#include <libhpx/stats.h>
+#include <libhpx/worker.h>
+#include <libsync/sync.h>
+#include "tcache.h"
+
+/// A translation cache entry.
+///
+/// An entry with an epoch of 0 is never valid, as the global epoch starts at 1.
+typedef struct {
+  uint64_t   key;
+  uint64_t epoch;
+  uint32_t owner;
+  uint32_t  attr;
+} _entry_t;
+
+/// The per-worker translation cache.
+typedef struct {
+  uint32_t     bits;
+  uint32_t     mask;
+  _entry_t entries[];
+} _tcache_t;
+
+/// The global translation epoch.
+static volatile uint64_t _epoch = 1;
+
+/// Get the calling worker's cache, allocating it on first use.
+///
+/// Threads that are not HPX workers, and configurations with the cache
+/// disabled, don't get a cache.
+static _tcache_t *_get(void) {
+  worker_t *w = self;
+  if (!w) {
+    return NULL;
+  }
+
+  if (likely(w->tcache != NULL)) {
+    return w->tcache;
+  }
+
+  int n = here->config->agas_tcache;
+  if (n <= 0) {
+    return NULL;
+  }
+
+  uint32_t bits = ceil_log2_32(n);
+  size_t entries = UINT64_C(1) << bits;
+  _tcache_t *tcache = calloc(1, sizeof(*tcache) + entries * sizeof(_entry_t));
+  dbg_assert(tcache);
+  tcache->bits = bits;
+  tcache->mask = entries - 1;
+  w->tcache = tcache;
+  return tcache;
+}
+
+/// Hash a block key into the cache.
+static uint32_t _index(const _tcache_t *tcache, uint64_t key) {
+  if (!tcache->bits) {
+    return 0;
+  }
+  return (key * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - tcache->bits);
+}
+
+uint64_t tcache_epoch(void) {
+  return sync_load(&_epoch, SYNC_ACQUIRE);
+}
+
+void tcache_invalidate(void) {
+  sync_fadd(&_epoch, 1, SYNC_ACQ_REL);
+}
+
+bool tcache_lookup(gva_t gva, uint32_t *owner, uint32_t *attr) {
+  _tcache_t *tcache = _get();
+  if (!tcache) {
+    return false;
+  }
+
+  uint64_t key = gva_to_key(gva);
+  const _entry_t *entry = &tcache->entries[_index(tcache, key)];
+  if (entry->key != key || entry->epoch != tcache_epoch()) {
+    COUNTER_SAMPLE(++self->stats.tcache_misses);
+    return false;
+  }
+
+  COUNTER_SAMPLE(++self->stats.tcache_hits);
+  if (owner) {
+    *owner = entry->owner;
+  }
+  if (attr) {
+    *attr = entry->attr;
+  }
+  return true;
+}
+
+void tcache_insert(gva_t gva, uint64_t epoch, uint32_t owner, uint32_t attr) {
+  _tcache_t *tcache = _get();
+  if (!tcache) {
+    return;
+  }
+
+  uint64_t key = gva_to_key(gva);
+  _entry_t *entry = &tcache->entries[_index(tcache, key)];
+  entry->key = key;
+  entry->epoch = epoch;
+  entry->owner = owner;
+  entry->attr = attr;
+}
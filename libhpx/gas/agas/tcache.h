@@ -0,0 +1,69 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_GAS_AGAS_TCACHE_H
+#define LIBHPX_GAS_AGAS_TCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "gva.h"
+
+/// The translation cache is a small, direct-mapped, per-worker cache of the
+/// read-only block metadata (owner and attributes) stored in the block
+/// translation table. It lets owner and attribute queries for hot blocks
+/// avoid the BTT's bucket locks.
+///
+/// Entries are tagged with the global translation epoch that was current when
+/// they were read from the BTT. Any BTT operation that changes the owner or
+/// attributes of a block, or removes it (i.e., hpx_gas_move() and
+/// hpx_gas_free()), bumps the epoch after it updates the table, which
+/// invalidates every cached translation at once. Pinning always goes to the
+/// BTT.
+
+/// Get the current translation epoch.
+///
+/// This must be read *before* the BTT lookup whose result is passed to
+/// tcache_insert().
+uint64_t tcache_epoch(void);
+
+/// Invalidate all of the cached translations on this locality.
+///
+/// This must be called *after* the BTT has been updated.
+void tcache_invalidate(void);
+
+/// Look up a block in the calling worker's translation cache.
+///
+/// @param          gva The global virtual address to look up.
+/// @param[out]   owner The owner of the block, if found (may be NULL).
+/// @param[out]    attr The attributes of the block, if found (may be NULL).
+///
+/// @returns            true if the translation was cached, false otherwise.
+bool tcache_lookup(gva_t gva, uint32_t *owner, uint32_t *attr);
+
+/// Insert a translation into the calling worker's translation cache.
+///
+/// @param          gva The global virtual address of the block.
+/// @param        epoch The epoch read before the BTT lookup.
+/// @param        owner The owner of the block.
+/// @param         attr The attributes of the block.
+void tcache_insert(gva_t gva, uint64_t epoch, uint32_t owner, uint32_t attr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHPX_GAS_AGAS_TCACHE_H
@@ -36,16 +36,35 @@ hpx_gas_dist_type_t gas_get_dist_type(hpx_gas_dist_t dist) {
   return ((uintptr_t)dist & GAS_DIST_TYPE_MASK);
 }
 
+/// Allocate an array with a user-defined distribution.
+///
+/// Global address spaces that can't place individual blocks (i.e., PGAS) fall
+/// back to a cyclic allocation, which still supports the same address
+/// arithmetic but ignores the requested placement.
 static hpx_addr_t _gas_alloc_user(size_t n, uint32_t bsize, uint32_t boundary,
-                                  hpx_gas_dist_t d) {
+                                  hpx_gas_dist_t d, uint32_t attr) {
   dbg_assert(gas_get_dist_type(d) == HPX_DIST_TYPE_USER);
-  dbg_error("User-defined GAS distributions are not supported.\n");
+  dbg_assert(here && here->gas);
+  gas_t *gas = here->gas;
+  if (gas->alloc_user) {
+    return gas->alloc_user(n, bsize, boundary, d, attr);
+  }
+  log_dflt("User-defined GAS distributions are not supported by %s, using a "
+           "cyclic distribution\n", HPX_GAS_TO_STRING[gas->type]);
+  return hpx_gas_alloc_cyclic_attr(n, bsize, boundary, attr);
 }
 
 static hpx_addr_t _gas_calloc_user(size_t n, uint32_t bsize, uint32_t boundary,
-                                   hpx_gas_dist_t d) {
+                                   hpx_gas_dist_t d, uint32_t attr) {
   dbg_assert(gas_get_dist_type(d) == HPX_DIST_TYPE_USER);
-  dbg_error("User-defined GAS distributions are not supported.\n");
+  dbg_assert(here && here->gas);
+  gas_t *gas = here->gas;
+  if (gas->calloc_user) {
+    return gas->calloc_user(n, bsize, boundary, d, attr);
+  }
+  log_dflt("User-defined GAS distributions are not supported by %s, using a "
+           "cyclic distribution\n", HPX_GAS_TO_STRING[gas->type]);
+  return hpx_gas_calloc_cyclic_attr(n, bsize, boundary, attr);
 }
 
 hpx_addr_t hpx_gas_alloc(size_t n, uint32_t bsize, uint32_t boundary,
@@ -60,7 +79,7 @@ hpx_addr_t hpx_gas_alloc(size_t n, uint32_t bsize, uint32_t boundary,
    case (HPX_DIST_TYPE_BLOCKED):
     return hpx_gas_alloc_blocked(n, bsize, boundary);
    case (HPX_DIST_TYPE_USER):
-    return _gas_alloc_user(n, bsize, boundary, dist);
+    return _gas_alloc_user(n, bsize, boundary, dist, attr);
    default: dbg_error("Unknown gas distribution type %d.\n", type);
   }
 }
@@ -77,7 +96,7 @@ hpx_addr_t hpx_gas_calloc(size_t n, uint32_t bsize, uint32_t boundary,
    case (HPX_DIST_TYPE_BLOCKED):
     return hpx_gas_calloc_blocked(n, bsize, boundary);
    case (HPX_DIST_TYPE_USER):
-    return _gas_calloc_user(n, bsize, boundary, dist);
+    return _gas_calloc_user(n, bsize, boundary, dist, attr);
    default: dbg_error("Unknown gas distribution type %d.\n", type);
   }
 }
@@ -324,6 +343,90 @@ int hpx_gas_memcpy_sync(hpx_addr_t to, hpx_addr_t from, size_t size) {
   return gas->string.memcpy_sync(here->gas, to, from, size);
 }
 
+int hpx_gas_memget_vec(const hpx_gas_iovec_t *iov, int n, hpx_addr_t lsync) {
+  dbg_assert(here && here->gas);
+  dbg_assert(n >= 0);
+  gas_t *gas = here->gas;
+  dbg_assert(gas->string.memget_vec);
+  return gas->string.memget_vec(here->gas, iov, n, lsync);
+}
+
+int hpx_gas_memget_vec_sync(const hpx_gas_iovec_t *iov, int n) {
+  hpx_addr_t lsync = hpx_lco_future_new(0);
+  dbg_assert_str(lsync, "could not allocate an LCO for memget_vec_sync.\n");
+  int e = hpx_gas_memget_vec(iov, n, lsync);
+  dbg_check(hpx_lco_wait(lsync), "failed memget_vec_sync\n");
+  hpx_lco_delete(lsync, HPX_NULL);
+  return e;
+}
+
+int hpx_gas_memput_vec(const hpx_gas_iovec_t *iov, int n, hpx_addr_t lsync,
+                       hpx_addr_t rsync) {
+  dbg_assert(here && here->gas);
+  dbg_assert(n >= 0);
+  gas_t *gas = here->gas;
+  dbg_assert(gas->string.memput_vec);
+  return gas->string.memput_vec(here->gas, iov, n, lsync, rsync);
+}
+
+int hpx_gas_memput_vec_rsync(const hpx_gas_iovec_t *iov, int n) {
+  hpx_addr_t rsync = hpx_lco_future_new(0);
+  dbg_assert_str(rsync, "could not allocate an LCO for memput_vec_rsync.\n");
+  int e = hpx_gas_memput_vec(iov, n, HPX_NULL, rsync);
+  dbg_check(hpx_lco_wait(rsync), "failed memput_vec_rsync\n");
+  hpx_lco_delete(rsync, HPX_NULL);
+  return e;
+}
+
+/// Expand a strided pattern into a list of regions.
+///
+/// The strided operations are just a compact way of describing a list, so we
+/// expand them here and let the vectored implementations do the work.
+static hpx_gas_iovec_t *_strided_iov(char *lva, size_t lstride,
+                                     hpx_addr_t gva, size_t gstride,
+                                     size_t size, int count, uint32_t bsize) {
+  hpx_gas_iovec_t *iov = malloc(count * sizeof(*iov));
+  dbg_assert(iov);
+  for (int i = 0; i < count; ++i) {
+    iov[i].local = lva + i * lstride;
+    iov[i].global = hpx_addr_add(gva, i * gstride, bsize);
+    iov[i].size = size;
+  }
+  return iov;
+}
+
+int hpx_gas_memget_strided(void *to, size_t to_stride, hpx_addr_t from,
+                           size_t from_stride, size_t size, int count,
+                           uint32_t bsize, hpx_addr_t lsync) {
+  if (count <= 0) {
+    hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
+  hpx_gas_iovec_t *iov = _strided_iov(to, to_stride, from, from_stride, size,
+                                      count, bsize);
+  int e = hpx_gas_memget_vec(iov, count, lsync);
+  free(iov);
+  return e;
+}
+
+int hpx_gas_memput_strided(hpx_addr_t to, size_t to_stride, const void *from,
+                           size_t from_stride, size_t size, int count,
+                           uint32_t bsize, hpx_addr_t lsync, hpx_addr_t rsync) {
+  if (count <= 0) {
+    hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+    hpx_lco_error(rsync, HPX_SUCCESS, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
+  // the local buffers are only read by the memput
+  hpx_gas_iovec_t *iov = _strided_iov((char*)from, from_stride, to, to_stride,
+                                      size, count, bsize);
+  int e = hpx_gas_memput_vec(iov, count, lsync, rsync);
+  free(iov);
+  return e;
+}
+
 static int _gas_alloc_local_at_handler(size_t n, uint32_t bsize,
                                        uint32_t boundary, uint32_t attr) {
   hpx_addr_t addr = hpx_gas_alloc_local_attr(n, bsize, boundary, attr);
@@ -36,6 +36,10 @@ global_allocator_init(void) {
   dbg_assert(global_heap);
   size_t offset = ceil_div_size_t(global_heap->nbytes, 2);
   size_t bytes = global_heap->nbytes - offset;
+  // The mspace manages its half of the heap directly, so it can't grow it.
+  if (heap_commit(global_heap, offset, bytes)) {
+    dbg_error("could not commit the global heap\n");
+  }
   mspaces[AS_GLOBAL] = create_mspace_with_base(global_heap->base+offset, bytes, 1);
 }
 
@@ -16,7 +16,9 @@
 #endif
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <libsync/sync.h>
 #include <hpx/builtins.h>
@@ -26,7 +28,9 @@
 #include <libhpx/libhpx.h>
 #include <libhpx/locality.h>
 #include <libhpx/memory.h>
+#include <libhpx/stats.h>
 #include <libhpx/system.h>
+#include <libhpx/worker.h>
 #include "heap.h"
 #include "pgas.h"
 
@@ -53,8 +57,362 @@ _chunks_are_used(const heap_t *heap, uint64_t offset, size_t n) {
   return bitmap_is_set(heap->chunks, from, to - from);
 }
 
+/// Commit memory to a segment of the heap.
+///
+/// This must be called while holding the segments lock.
+static int
+_segment_commit(heap_t *heap, size_t i) {
+  if (heap->segments[i] >= 0) {
+    return LIBHPX_OK;
+  }
+
+  uint64_t offset = i * heap->bytes_per_segment;
+  size_t bytes = min_size_t(heap->bytes_per_segment, heap->nbytes - offset);
+  int e = system_mmap_commit(heap->base + offset, bytes);
+  if (e == LIBHPX_OK) {
+    heap->segments[i] = 0;
+    log_gas("grew the global heap by segment %zu at offset %"PRIu64"\n", i,
+            offset);
+  }
+  return e;
+}
+
+/// Return the memory for an unused segment of the heap to the OS.
+///
+/// This must be called while holding the segments lock.
+static void
+_segment_decommit(heap_t *heap, size_t i) {
+  uint64_t offset = i * heap->bytes_per_segment;
+  if (heap->segments[i] || offset < heap_get_csbrk(heap)) {
+    return;
+  }
+
+  size_t bytes = min_size_t(heap->bytes_per_segment, heap->nbytes - offset);
+  system_mmap_decommit(heap->base + offset, bytes);
+  heap->segments[i] = -1;
+  log_gas("released segment %zu of the global heap at offset %"PRIu64"\n", i,
+          offset);
+}
+
+/// Account for @p n bytes of chunks at @p offset in the segments that they
+/// overlap, committing or releasing segments as they become used or unused.
+///
+/// @param         heap The heap.
+/// @param       offset The offset of the first chunk.
+/// @param            n The number of bytes of chunks.
+/// @param        delta +1 if the chunks were allocated, -1 if they were freed.
+///
+/// @returns LIBHPX_OK, or LIBHPX_ENOMEM if a segment could not be committed,
+///          in which case none of the chunks are accounted for.
+static int
+_segments_update(heap_t *heap, uint64_t offset, size_t n, int delta) {
+  if (!heap->bytes_per_segment) {
+    return LIBHPX_OK;
+  }
+
+  const size_t bps = heap->bytes_per_segment;
+  const size_t first = offset / bps;
+  const size_t last = (offset + n - 1) / bps;
+  int e = LIBHPX_OK;
+
+  sync_tatas_acquire(&heap->segments_lock);
+  for (size_t i = first; i <= last && delta > 0; ++i) {
+    if ((e = _segment_commit(heap, i)) != LIBHPX_OK) {
+      break;
+    }
+  }
+
+  for (size_t i = first; i <= last && e == LIBHPX_OK; ++i) {
+    uint64_t lo = max_u64(offset, i * bps);
+    uint64_t hi = min_u64(offset + n, (i + 1) * bps);
+    heap->segments[i] += delta * (int32_t)((hi - lo) / heap->bytes_per_chunk);
+    dbg_assert(heap->segments[i] >= 0);
+    _segment_decommit(heap, i);
+  }
+  sync_tatas_release(&heap->segments_lock);
+  return e;
+}
+
+/// Commit all of the segments that overlap a range of the heap.
+///
+/// This must be called while holding the segments lock.
+static int
+_segments_commit(heap_t *heap, uint64_t offset, size_t n) {
+  if (!heap->bytes_per_segment || !n) {
+    return LIBHPX_OK;
+  }
+
+  const size_t first = offset / heap->bytes_per_segment;
+  const size_t last = (offset + n - 1) / heap->bytes_per_segment;
+  int e = LIBHPX_OK;
+  for (size_t i = first; i <= last && e == LIBHPX_OK; ++i) {
+    e = _segment_commit(heap, i);
+  }
+  return e;
+}
+
+/// The largest request, in chunks, that the per-worker free lists cache.
+#define HEAP_CACHE_CLASSES 8
+
+/// A per-worker chunk cache.
+///
+/// Each worker keeps a run of chunks that it reserved from the bitmap in a
+/// single batch, which it uses to satisfy single-chunk requests, and a free
+/// list for each request size (in chunks) with the chunks that it has
+/// released. The free lists are threaded through the first word of the free
+/// chunks. Cached chunks stay reserved in the bitmap, so the bitmap remains
+/// the source of truth for which parts of the heap are available.
+///
+/// A cache is only ever used by the worker that owns it, except when a
+/// reservation fails and all of the caches are flushed back to the bitmap. The
+/// lock is there for that case, and is otherwise uncontended.
+typedef struct heap_cache {
+  tatas_lock_t              lock;      //!< taken by the owner and flushes
+  uint32_t                   run;      //!< the first bit of the cached run
+  uint32_t               run_end;      //!< the end of the cached run
+  uint32_t               nchunks;      //!< the chunks in the free lists
+  void *lists[HEAP_CACHE_CLASSES];     //!< the free lists, by size - 1
+} HPX_ALIGNED(HPX_CACHELINE_SIZE) heap_cache_t;
+
+/// Get the calling worker's chunk cache.
+///
+/// Threads that are not HPX workers, and configurations with the cache
+/// disabled, don't get a cache.
+static heap_cache_t *
+_cache(const heap_t *heap) {
+  worker_t *w = self;
+  if (!w || !heap->caches || w->id < 0 || w->id >= here->config->threads) {
+    return NULL;
+  }
+  return &heap->caches[w->id];
+}
+
+/// Release chunks to the bitmap.
+static void
+_chunks_release(heap_t *heap, uint32_t bit, uint32_t bits) {
+  bitmap_release(heap->chunks, bit, bits);
+  _segments_update(heap, bit * heap->bytes_per_chunk,
+                   bits * heap->bytes_per_chunk, -1);
+}
+
+/// Allocate the per-worker chunk caches.
+static void
+_caches_init(heap_t *heap) {
+  heap->cache_limit = 0;
+  heap->caches = NULL;
+  if (!here || !here->config || here->config->heap_chunkcache <= 0) {
+    return;
+  }
+
+  // The thread count is resolved from the core count before the heap is
+  // created.
+  dbg_assert(here->config->threads > 0);
+  size_t bytes = here->config->threads * sizeof(heap_cache_t);
+  if (posix_memalign((void**)&heap->caches, HPX_CACHELINE_SIZE, bytes)) {
+    dbg_error("failed to allocate the global heap chunk caches.\n");
+  }
+  memset(heap->caches, 0, bytes);
+  for (int i = 0, e = here->config->threads; i < e; ++i) {
+    sync_tatas_init(&heap->caches[i].lock);
+  }
+
+  // A worker can hold up to twice its limit (its run and its free lists), so
+  // keep the total that the caches can hold to an eighth of the heap.
+  size_t limit = heap->nchunks / (16 * here->config->threads);
+  heap->cache_limit = min_size_t(here->config->heap_chunkcache, limit);
+  if (!heap->cache_limit) {
+    free(heap->caches);
+    heap->caches = NULL;
+    log_gas("heap is too small to cache chunks\n");
+    return;
+  }
+  log_gas("each worker caches up to %u chunks\n", heap->cache_limit);
+}
+
+/// Return the chunks held by one cache to the bitmap, with its lock held.
+static void
+_cache_flush(heap_t *heap, heap_cache_t *cache) {
+  if (cache->run != cache->run_end) {
+    _chunks_release(heap, cache->run, cache->run_end - cache->run);
+  }
+  cache->run = cache->run_end = 0;
+
+  for (uint32_t i = 0; i < HEAP_CACHE_CLASSES; ++i) {
+    void *chunk;
+    while ((chunk = cache->lists[i])) {
+      cache->lists[i] = *(void**)chunk;
+      uint64_t offset = (char*)chunk - heap->base;
+      _chunks_release(heap, offset / heap->bytes_per_chunk, i + 1);
+    }
+  }
+  cache->nchunks = 0;
+}
+
+/// Return the chunks held by all of the workers' caches to the bitmap.
+///
+/// This is only done when a reservation fails, so that chunks sitting unused in
+/// other workers' caches don't cause an out-of-memory error.
+///
+/// @returns true if any caches exist, i.e., if retrying might succeed.
+static bool
+_caches_flush(heap_t *heap) {
+  if (!heap->caches) {
+    return false;
+  }
+
+  log_gas("flushing the chunk caches\n");
+  for (int i = 0, e = here->config->threads; i < e; ++i) {
+    heap_cache_t *cache = &heap->caches[i];
+    sync_tatas_acquire(&cache->lock);
+    _cache_flush(heap, cache);
+    sync_tatas_release(&cache->lock);
+  }
+  return true;
+}
+
+/// Reserve chunks from the bitmap for global allocation, once.
+///
+/// @returns LIBHPX_OK, LIBHPX_ENOMEM if there wasn't space, or LIBHPX_ERROR if
+///          the memory couldn't be committed.
+static int
+_chunks_reserve_once(heap_t *heap, uint32_t bits, uint32_t log2_align,
+                     bool try, uint32_t *bit) {
+  if (try) {
+    if (bitmap_try_rreserve(heap->chunks, bits, log2_align, bit)) {
+      return LIBHPX_ENOMEM;
+    }
+  }
+  else if (bitmap_rreserve(heap->chunks, bits, log2_align, bit)) {
+    return LIBHPX_ENOMEM;
+  }
+
+  uint64_t offset = *bit * heap->bytes_per_chunk;
+  size_t bytes = bits * heap->bytes_per_chunk;
+  if (offset < heap->csbrk) {
+    bitmap_release(heap->chunks, *bit, bits);
+    return LIBHPX_ENOMEM;
+  }
+
+  if (_segments_update(heap, offset, bytes, 1)) {
+    bitmap_release(heap->chunks, *bit, bits);
+    return LIBHPX_ERROR;
+  }
+  return LIBHPX_OK;
+}
+
+/// Reserve chunks from the bitmap for global allocation.
+///
+/// If there isn't space we flush the workers' chunk caches and try again before
+/// reporting that we're out of memory.
+///
+/// @param         heap The heap.
+/// @param         bits The number of chunks to reserve.
+/// @param   log2_align The log of the required alignment.
+/// @param          try If true, failure is not reported as an error, and the
+///                     caches are not flushed.
+/// @param[out]     bit The first reserved chunk.
+///
+/// @returns LIBHPX_OK, or an error if the chunks couldn't be reserved.
+static int
+_chunks_reserve(heap_t *heap, uint32_t bits, uint32_t log2_align, bool try,
+                uint32_t *bit) {
+  int e = _chunks_reserve_once(heap, bits, log2_align, try, bit);
+  if (e != LIBHPX_ENOMEM || try) {
+    return e;
+  }
+
+  if (_caches_flush(heap)) {
+    e = _chunks_reserve_once(heap, bits, log2_align, false, bit);
+  }
+  if (e == LIBHPX_ENOMEM) {
+    dbg_error("out-of-memory detected\n");
+  }
+  return e;
+}
+
+/// Try to satisfy a global chunk allocation from a worker's cache.
+///
+/// Single-chunk requests that miss in the free lists are satisfied from the
+/// cached run, which is refilled from the bitmap when it is empty.
+///
+/// @returns The chunk, or NULL if the request can't be satisfied by the cache.
+static void *
+_cache_alloc(heap_t *heap, heap_cache_t *cache, uint32_t bits, size_t align) {
+  if (bits <= HEAP_CACHE_CLASSES) {
+    void **list = &cache->lists[bits - 1];
+    void *chunk = *list;
+    if (chunk && !((uintptr_t)chunk & (align - 1))) {
+      *list = *(void**)chunk;
+      cache->nchunks -= bits;
+      return chunk;
+    }
+  }
+
+  if (bits != 1 || align > heap->bytes_per_chunk) {
+    return NULL;
+  }
+
+  if (cache->run == cache->run_end) {
+    uint32_t n = heap->cache_limit;
+    uint32_t log2_align = ceil_log2_size_t(heap->bytes_per_chunk);
+    uint32_t bit;
+    if (_chunks_reserve(heap, n, log2_align, true, &bit)) {
+      return NULL;
+    }
+    cache->run = bit;
+    cache->run_end = bit + n;
+  }
+
+  // Hand out the run from the top, to match the bitmap's global allocation.
+  return heap->base + --cache->run_end * heap->bytes_per_chunk;
+}
+
+/// Try to cache a released global chunk.
+///
+/// @returns true if the chunk was cached, false if it should be released to
+///          the bitmap.
+static bool
+_cache_dalloc(heap_t *heap, heap_cache_t *cache, void *chunk, uint32_t bits) {
+  if (HEAP_CACHE_CLASSES < bits || heap->cache_limit < cache->nchunks + bits) {
+    return false;
+  }
+
+  void **list = &cache->lists[bits - 1];
+  *(void**)chunk = *list;
+  *list = chunk;
+  cache->nchunks += bits;
+  return true;
+}
+
+/// Set up the segments for a heap that grows on demand.
+static void
+_segments_init(heap_t *heap, size_t segment) {
+  heap->bytes_per_segment = 0;
+  heap->nsegments = 0;
+  heap->segments = NULL;
+  sync_tatas_init(&heap->segments_lock);
+  if (!segment) {
+    return;
+  }
+
+  // Segments are a power of two number of chunks, so that they stay aligned
+  // with the (aligned) heap base.
+  segment = max_size_t(segment, heap->bytes_per_chunk);
+  heap->bytes_per_segment = UINT64_C(1) << ceil_log2_size_t(segment);
+  heap->nsegments = ceil_div_size_t(heap->nbytes, heap->bytes_per_segment);
+  heap->segments = malloc(heap->nsegments * sizeof(heap->segments[0]));
+  if (!heap->segments) {
+    dbg_error("failed to allocate the global heap segment table.\n");
+  }
+  for (size_t i = 0, e = heap->nsegments; i < e; ++i) {
+    heap->segments[i] = -1;
+  }
+  log_gas("heap grows by %zu byte segments, up to %zu segments\n",
+          heap->bytes_per_segment, heap->nsegments);
+}
+
 int
-heap_init(heap_t *heap, size_t size) {
+heap_init(heap_t *heap, size_t size, size_t segment) {
   assert(heap);
   assert(size);
 
@@ -80,19 +438,33 @@ heap_init(heap_t *heap, size_t size) {
   heap->max_block_lg_size = min_int(GPA_MAX_LG_BSIZE, ceil_log2_size_t(heap->nbytes));
   size_t align = (1lu << heap->max_block_lg_size);
   void *addr = (void*)align;
-  heap->base = system_mmap_huge_pages(NULL, addr, heap->nbytes, align);
+  _segments_init(heap, segment);
+  if (heap->bytes_per_segment) {
+    heap->base = system_mmap_reserve(addr, heap->nbytes, align);
+  }
+  else {
+    heap->base = system_mmap_huge_pages(NULL, addr, heap->nbytes, align);
+  }
   if (!heap->base) {
     log_error("could not allocate %zu bytes for the global heap\n",
               heap->nbytes);
     return LIBHPX_ENOMEM;
   }
-  log_gas("allocated %zu bytes for the global heap\n", heap->nbytes);
+  if (heap->bytes_per_segment) {
+    log_gas("reserved %zu bytes for the global heap\n", heap->nbytes);
+  }
+  else {
+    log_gas("allocated %zu bytes for the global heap with %zu byte pages\n",
+            heap->nbytes, system_mmap_page_size(heap->base));
+  }
 
   assert((uintptr_t)heap->base % heap->bytes_per_chunk == 0);
 
   heap->chunks = _new_bitmap(heap);
   log_gas("allocated chunk bitmap to manage %zu chunks.\n", heap->nchunks);
 
+  _caches_init(heap);
+
   log_gas("allocated heap.\n");
   return LIBHPX_OK;
 }
@@ -102,9 +474,23 @@ heap_fini(heap_t *heap) {
   if (heap->chunks)
     bitmap_delete(heap->chunks);
 
-  if (heap->base) {
+  if (heap->base && heap->bytes_per_segment) {
+    system_munmap(NULL, heap->base, heap->nbytes);
+  }
+  else if (heap->base) {
     system_munmap_huge_pages(NULL, heap->base, heap->nbytes);
   }
+
+  free(heap->segments);
+  free(heap->caches);
+}
+
+int
+heap_commit(heap_t *heap, uint64_t offset, size_t bytes) {
+  sync_tatas_acquire(&heap->segments_lock);
+  int e = _segments_commit(heap, offset, bytes);
+  sync_tatas_release(&heap->segments_lock);
+  return e;
 }
 
 void *
@@ -114,18 +500,25 @@ heap_chunk_alloc(heap_t *heap, void *addr, size_t bytes, size_t align) {
   uint32_t bits = bytes / heap->bytes_per_chunk;
   uint32_t log2_align = ceil_log2_size_t(align);
 
+  heap_cache_t *cache = _cache(heap);
+  if (cache) {
+    sync_tatas_acquire(&cache->lock);
+    void *chunk = _cache_alloc(heap, cache, bits, align);
+    sync_tatas_release(&cache->lock);
+    if (chunk) {
+      COUNTER_SAMPLE(++self->stats.chunk_cache_hits);
+      return chunk;
+    }
+    COUNTER_SAMPLE(++self->stats.chunk_cache_misses);
+  }
+
   uint32_t bit = 0;
-  if (bitmap_rreserve(heap->chunks, bits, log2_align, &bit)) {
-    dbg_error("out-of-memory detected\n");
+  if (_chunks_reserve(heap, bits, log2_align, false, &bit)) {
+    return NULL;
   }
 
   uint64_t offset = bit * heap->bytes_per_chunk;
   assert(offset % align == 0);
-
-  if (offset < heap->csbrk) {
-    dbg_error("out-of-memory detected\n");
-  }
-
   return heap->base + offset;
 }
 
@@ -138,10 +531,18 @@ heap_cyclic_chunk_alloc(heap_t *heap, void *addr, size_t bytes, size_t align) {
 
   uint32_t bit = 0;
   if (bitmap_reserve(heap->chunks, bits, log2_align, &bit)) {
-    dbg_error("out-of-memory detected\n");
+    if (!_caches_flush(heap) ||
+        bitmap_reserve(heap->chunks, bits, log2_align, &bit)) {
+      dbg_error("out-of-memory detected\n");
+    }
   }
 
   uint64_t offset = bit * heap->bytes_per_chunk;
+  if (_segments_update(heap, offset, bytes, 1)) {
+    bitmap_release(heap->chunks, bit, bits);
+    return NULL;
+  }
+
   heap_set_csbrk(heap, offset + bytes);
   void *p = heap_offset_to_lva(heap, offset);
   dbg_assert(((uintptr_t)p & (align - 1)) == 0);
@@ -157,7 +558,18 @@ heap_chunk_dalloc(heap_t *heap, void *chunk, size_t size) {
   const uint64_t    bit = offset / heap->bytes_per_chunk;
   const uint64_t  nbits = size / heap->bytes_per_chunk;
 
-  bitmap_release(heap->chunks, bit, nbits);
+  // Cyclic chunks are never cached.
+  heap_cache_t *cache = _cache(heap);
+  if (cache && heap_get_csbrk(heap) <= offset) {
+    sync_tatas_acquire(&cache->lock);
+    bool cached = _cache_dalloc(heap, cache, chunk, nbits);
+    sync_tatas_release(&cache->lock);
+    if (cached) {
+      return true;
+    }
+  }
+
+  _chunks_release(heap, bit, nbits);
   return true;
 }
 
@@ -246,7 +658,17 @@ heap_set_csbrk(heap_t *heap, uint64_t offset) {
   // larger than the new offset, it means that this is happening out of order
   uint64_t old = sync_load(&heap->csbrk, SYNC_RELAXED);
   if (old < offset) {
+    // Cyclic memory is used by every locality, so we need to commit it here
+    // even though we didn't allocate any chunks for it. Holding the segments
+    // lock keeps the segments from being released before the csbrk covers
+    // them.
+    sync_tatas_acquire(&heap->segments_lock);
+    if (_segments_commit(heap, old, offset - old)) {
+      sync_tatas_release(&heap->segments_lock);
+      return LIBHPX_ENOMEM;
+    }
     sync_cas(&heap->csbrk, &old, offset, SYNC_RELAXED, SYNC_RELAXED);
+    sync_tatas_release(&heap->segments_lock);
     int used = _chunks_are_used(heap, old, offset - old);
     return (used) ? HPX_ERROR : HPX_SUCCESS;
   }
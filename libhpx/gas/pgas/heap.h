@@ -46,6 +46,14 @@ extern "C" {
 /// has no way of knowing how much acyclic allocation each locality has
 /// performed, which it would need to know to do the check.
 ///
+/// The heap can also grow on demand (--hpx-heap-segmentsize). In that case the
+/// heap size is only reserved as address space, which is divided into
+/// fixed-size segments. Memory is committed to a segment when the first chunk
+/// in it is allocated, and returned to the OS when its last chunk is
+/// released. The address space stays contiguous, so translation is still a
+/// simple offset from the base. The PWC network registers the whole heap at
+/// startup, so it can't be used with a heap that grows.
+///
 /// @todo Implement a debugging mode where cyclic allocation is broadcast, so we
 ///       can detect intersections and report meaningful errors. Without this,
 ///       intersections lead to untraceable errors.
@@ -53,12 +61,14 @@ extern "C" {
 
 #include <stddef.h>
 #include <hpx/attributes.h>
+#include <libsync/locks.h>
 
 #define HEAP_USE_CYCLIC_CSBRK_BARRIER 0
 
 /// Forward declarations.
 /// @{
 struct bitmap;
+struct heap_cache;
 /// @}
 
 /// The global heap instance.
@@ -77,6 +87,17 @@ extern struct heap *global_heap;
 /// requests, while the "top" of the heap is used to satisfy normal global
 /// allocation. The csbrk value indicates the upper bound on cyclic allocations,
 /// so that we can quickly tell if an address is cylic or not.
+///
+/// When the heap grows on demand, each entry in the segments array is the
+/// number of allocated chunks in the corresponding segment, or -1 if the
+/// segment has no memory committed to it. Segments below the csbrk stay
+/// committed, because remote cyclic allocations use them without being
+/// recorded in the local bitmap.
+///
+/// Each worker also caches up to cache_limit chunks for global allocation, so
+/// that concurrent chunk allocation doesn't serialize on the bitmap. Cached
+/// chunks remain reserved in the bitmap, and are returned to it when a
+/// reservation would otherwise fail.
 /// @{
 typedef struct heap {
   volatile uint64_t     csbrk;
@@ -86,22 +107,43 @@ typedef struct heap {
   size_t               nbytes;
   char                  *base;
   uint32_t  max_block_lg_size;
+  size_t    bytes_per_segment;
+  size_t            nsegments;
+  int32_t           *segments;
+  tatas_lock_t  segments_lock;
+  uint32_t        cache_limit;
+  struct heap_cache   *caches;
 } heap_t;
 
 /// Initialize a heap to manage the specified number of bytes.
 ///
 /// @param         heap The heap pointer to initialize.
 /// @param         size The number of bytes to allocate for the heap.
+/// @param      segment The size of the segments that the heap grows by, or 0
+///                       to commit the entire heap up front.
 ///
 /// @returns LIBHPX_OK, or LIBHPX_ENOMEM if there is a problem allocating the
 ///          requested heap size.
-int heap_init(heap_t *heap, size_t size);
+int heap_init(heap_t *heap, size_t size, size_t segment);
 
 /// Finalize a heap.
 ///
 /// @param         heap The heap pointer to finalize.
 void heap_fini(heap_t *heap);
 
+/// Commit memory to a range of the heap that is managed outside of the chunk
+/// bitmap.
+///
+/// This is used by allocators that manage the heap directly rather than
+/// through chunks. The range stays committed until the heap is finalized.
+///
+/// @param         heap The heap object.
+/// @param       offset The offset of the range within the heap.
+/// @param        bytes The number of bytes in the range.
+///
+/// @returns LIBHPX_OK, or LIBHPX_ENOMEM if the memory could not be committed.
+int heap_commit(heap_t *heap, uint64_t offset, size_t bytes);
+
 /// Allocate a chunk of the global address space.
 ///
 /// This satisfies requests from jemalloc's chunk allocator for global memory.
@@ -245,6 +245,8 @@ static gas_t _pgas_vtable = {
     .memput_rsync = pgas_memput_rsync,
     .memcpy       = pgas_memcpy,
     .memcpy_sync  = pgas_memcpy_sync,
+    .memget_vec   = pgas_memget_vec,
+    .memput_vec   = pgas_memput_vec
   },
   .dealloc        = _pgas_dealloc,
   .local_size     = _pgas_local_size,
@@ -258,6 +260,8 @@ static gas_t _pgas_vtable = {
   .calloc_cyclic  = _pgas_gas_calloc_cyclic,
   .alloc_blocked  = NULL,
   .calloc_blocked = NULL,
+  .alloc_user     = NULL,
+  .calloc_user    = NULL,
   .alloc_local    = _pgas_gas_alloc_local,
   .calloc_local   = _pgas_gas_calloc_local,
   .free           = _pgas_gas_free,
@@ -266,20 +270,40 @@ static gas_t _pgas_vtable = {
   .owner_of       = _pgas_owner_of
 };
 
+/// Check if the heap will be registered with the PWC network.
+///
+/// PWC registers the heap once at startup and exchanges a single key for it,
+/// so it can't use a heap that grows in segments.
+static bool _heap_is_registered(const config_t *cfg) {
+  libhpx_network_t network = cfg->network;
+#ifdef HAVE_PHOTON
+  if (network == HPX_NETWORK_DEFAULT) {
+    network = HPX_NETWORK_PWC;
+  }
+#endif
+  return (network == HPX_NETWORK_PWC);
+}
+
 gas_t *gas_pgas_new(const config_t *cfg, boot_t *boot) {
   size_t heap_size = cfg->heapsize;
+  size_t segment_size = cfg->heap_segmentsize;
 
   if (global_heap) {
     return &_pgas_vtable;
   }
 
+  if (segment_size && _heap_is_registered(cfg)) {
+    log_error("--hpx-heap-segmentsize is not supported by the PWC network\n");
+    return NULL;
+  }
+
   global_heap = malloc(sizeof(*global_heap));
   if (!global_heap) {
     dbg_error("could not allocate global heap\n");
     return NULL;
   }
 
-  if (heap_init(global_heap, heap_size) != LIBHPX_OK) {
+  if (heap_init(global_heap, heap_size, segment_size) != LIBHPX_OK) {
     dbg_error("failed to allocate global heap\n");
     free(global_heap);
     return NULL;
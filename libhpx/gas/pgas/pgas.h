@@ -219,5 +219,36 @@ int pgas_memcpy(void *obj, hpx_addr_t to, hpx_addr_t from, size_t size,
 /// @returns            HPX_SUCCESS;
 int pgas_memcpy_sync(void *obj, hpx_addr_t to, hpx_addr_t from, size_t size);
 
+/// The asynchronous vectored memget operation.
+///
+/// Leading regions that are local are copied immediately, and the rest of the
+/// vector is forwarded to the network.
+///
+/// @param          obj The pgas object.
+/// @param          iov The regions to get.
+/// @param            n The number of regions.
+/// @param        lsync An LCO to set when all of the local buffers are written.
+///
+/// @returns            HPX_SUCCESS
+int pgas_memget_vec(void *obj, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync);
+
+/// The asynchronous vectored memput operation.
+///
+/// Leading regions that are local are copied immediately, and the rest of the
+/// vector is forwarded to the network.
+///
+/// @param          obj The pgas object.
+/// @param          iov The regions to put.
+/// @param            n The number of regions.
+/// @param        lsync An LCO to set when all of the local buffers can be
+///                       reused.
+/// @param        rsync An LCO to set when all of the remote regions have been
+///                       written.
+///
+/// @returns            HPX_SUCCESS
+int pgas_memput_vec(void *obj, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync, hpx_addr_t rsync);
+
 
 #endif // LIBHPX_GAS_PGAS_H
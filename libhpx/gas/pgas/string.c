@@ -156,3 +156,62 @@ int pgas_memget_lsync(void *gas, void *to, hpx_addr_t from, size_t n) {
 
   return network_memget_lsync(self->network, to, from, n);
 }
+
+/// Copy out the leading regions of a vector that are local.
+///
+/// We copy regions until we find a remote one, and return its index so that
+/// the caller can forward the rest of the vector to the network with a single
+/// completion.
+static int _memget_vec_local(const hpx_gas_iovec_t *iov, int n) {
+  for (int i = 0; i < n; ++i) {
+    if (!iov[i].size) {
+      continue;
+    }
+
+    if (gpa_to_rank(iov[i].global) != here->rank) {
+      return i;
+    }
+    const void *lfrom = pgas_gpa_to_lva(iov[i].global);
+    memcpy(iov[i].local, lfrom, iov[i].size);
+  }
+  return n;
+}
+
+/// Copy in the leading regions of a vector that are local.
+static int _memput_vec_local(const hpx_gas_iovec_t *iov, int n) {
+  for (int i = 0; i < n; ++i) {
+    if (!iov[i].size) {
+      continue;
+    }
+
+    if (gpa_to_rank(iov[i].global) != here->rank) {
+      return i;
+    }
+    void *lto = pgas_gpa_to_lva(iov[i].global);
+    memcpy(lto, iov[i].local, iov[i].size);
+  }
+  return n;
+}
+
+int pgas_memget_vec(void *gas, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync) {
+  int i = _memget_vec_local(iov, n);
+  if (i < n) {
+    return network_memget_vec(self->network, iov + i, n - i, lsync);
+  }
+
+  hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+  return HPX_SUCCESS;
+}
+
+int pgas_memput_vec(void *gas, const hpx_gas_iovec_t *iov, int n,
+                    hpx_addr_t lsync, hpx_addr_t rsync) {
+  int i = _memput_vec_local(iov, n);
+  if (i < n) {
+    return network_memput_vec(self->network, iov + i, n - i, lsync, rsync);
+  }
+
+  hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+  hpx_lco_error(rsync, HPX_SUCCESS, HPX_NULL);
+  return HPX_SUCCESS;
+}
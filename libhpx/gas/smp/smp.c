@@ -113,6 +113,23 @@ _smp_gas_calloc_cyclic(size_t n, uint32_t bsize, uint32_t boundary,
   return _smp_lva_to_gva(p);
 }
 
+/// Allocate a global array with a user-defined distribution.
+///
+/// There is only one locality, so every distribution places all of the blocks
+/// here.
+static hpx_addr_t
+_smp_gas_alloc_user(size_t n, uint32_t bsize, uint32_t boundary,
+                    hpx_gas_dist_t dist, uint32_t attr) {
+  return _smp_gas_alloc_cyclic(n, bsize, boundary, attr);
+}
+
+/// Allocate a 0-filled global array with a user-defined distribution.
+static hpx_addr_t
+_smp_gas_calloc_user(size_t n, uint32_t bsize, uint32_t boundary,
+                     hpx_gas_dist_t dist, uint32_t attr) {
+  return _smp_gas_calloc_cyclic(n, bsize, boundary, attr);
+}
+
 /// Allocate a bunch of global memory
 static hpx_addr_t
 _smp_gas_alloc_local(size_t n, uint32_t bsize, uint32_t boundary,
@@ -241,6 +258,41 @@ _smp_memget(void *gas, void *to, hpx_addr_t from, size_t size,
   return HPX_SUCCESS;
 }
 
+/// Gather a vector of global regions into local buffers.
+static int
+_smp_memget_vec(void *gas, const hpx_gas_iovec_t *iov, int n,
+                hpx_addr_t lsync) {
+  for (int i = 0; i < n; ++i) {
+    if (iov[i].size) {
+      dbg_assert(iov[i].local != NULL);
+      dbg_assert(iov[i].global != HPX_NULL);
+
+      const void *lfrom = (void*)(size_t)iov[i].global;
+      memcpy(iov[i].local, lfrom, iov[i].size);
+    }
+  }
+  hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+  return HPX_SUCCESS;
+}
+
+/// Scatter local buffers to a vector of global regions.
+static int
+_smp_memput_vec(void *gas, const hpx_gas_iovec_t *iov, int n,
+                hpx_addr_t lsync, hpx_addr_t rsync) {
+  for (int i = 0; i < n; ++i) {
+    if (iov[i].size) {
+      dbg_assert(iov[i].local != NULL);
+      dbg_assert(iov[i].global != HPX_NULL);
+
+      void *lto = (void*)(size_t)iov[i].global;
+      memcpy(lto, iov[i].local, iov[i].size);
+    }
+  }
+  hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+  hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+  return HPX_SUCCESS;
+}
+
 /// Move memory from one locality to another.
 static void
 _smp_move(void *gas, hpx_addr_t src, hpx_addr_t dst, hpx_addr_t sync) {
@@ -272,7 +324,9 @@ static gas_t _smp_vtable = {
     .memput_lsync = _smp_memput_lsync,
     .memput_rsync = _smp_memput_rsync,
     .memcpy       = _smp_memcpy,
-    .memcpy_sync  = _smp_memcpy_sync
+    .memcpy_sync  = _smp_memcpy_sync,
+    .memget_vec   = _smp_memget_vec,
+    .memput_vec   = _smp_memput_vec
   },
   .dealloc        = _smp_dealloc,
   .local_size     = _smp_local_size,
@@ -286,6 +340,8 @@ static gas_t _smp_vtable = {
   .calloc_cyclic  = _smp_gas_calloc_cyclic,
   .alloc_blocked  = NULL,
   .calloc_blocked = NULL,
+  .alloc_user     = _smp_gas_alloc_user,
+  .calloc_user    = _smp_gas_calloc_user,
   .alloc_local    = _smp_gas_alloc_local,
   .calloc_local   = _smp_gas_calloc_local,
   .free           = _smp_gas_free,
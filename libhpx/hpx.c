@@ -63,6 +63,8 @@ static void _stop(locality_t *l) {
   if (!l)
     return;
 
+  libhpx_stats_export_stop();
+
   if (l->sched) {
     scheduler_delete(l->sched);
     l->sched = NULL;
@@ -186,6 +188,17 @@ int hpx_init(int *argc, char ***argv) {
     goto unwind1;
   }
 
+  // Resolve the number of worker threads before anything sizes per-worker
+  // state from it.
+  int cores = system_get_available_cores();
+  dbg_assert(cores > 0);
+
+  if (!here->config->threads) {
+    here->config->threads = cores;
+  }
+  log_dflt("HPX running %d worker threads on %d cores\n", here->config->threads,
+           cores);
+
   // Initialize our instrumentation.
   if (inst_init(here->config)) {
     log_dflt("error detected while initializing instrumentation\n");
@@ -205,15 +218,6 @@ int hpx_init(int *argc, char ***argv) {
     goto unwind1;
   }
 
-  int cores = system_get_available_cores();
-  dbg_assert(cores > 0);
-
-  if (!here->config->threads) {
-    here->config->threads = cores;
-  }
-  log_dflt("HPX running %d worker threads on %d cores\n", here->config->threads,
-           cores);
-
   here->net = network_new(here->config, here->boot, here->gas);
   if (!here->net) {
     status = log_error("failed to create network.\n");
@@ -227,6 +231,11 @@ int hpx_init(int *argc, char ***argv) {
     goto unwind1;
   }
 
+  // export runtime statistics, if requested
+  if (libhpx_stats_export_start(here->config)) {
+    log_dflt("error detected while starting statistics export\n");
+  }
+
 #ifdef HAVE_APEX
   // initialize APEX, give this main thread a name
   apex_init("HPX WORKER THREAD");
@@ -359,10 +368,7 @@ void hpx_finalize(void) {
   // this will add the stats to the APEX data set
   libhpx_save_apex_stats();
 #endif
-  _stop(here);
-
-#if defined(ENABLE_PROFILING)
   libhpx_stats_print();
-#endif
+  _stop(here);
   _cleanup(here);
 }
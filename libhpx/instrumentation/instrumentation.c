@@ -26,6 +26,7 @@
 #include <limits.h>
 #include <unistd.h>
 #include <pwd.h>
+#include <pthread.h>
 
 #include <hpx/hpx.h>
 #include <libhpx/action.h>
@@ -37,7 +38,11 @@
 #include <libhpx/locality.h>
 #include <libhpx/parcel.h>
 #include <libhpx/profiling.h>
+#include <libhpx/system.h>
+#include <libsync/locks.h>
+#include <libsync/sync.h>
 #include "logtable.h"
+#include "trace_ring.h"
 
 #ifndef HOST_NAME_MAX
 #define HOST_NAME_MAX 255
@@ -53,6 +58,24 @@ static bool _detailed_prof = false;
 /// We're keeping one log per event per locality. Here are their headers.
 static logtable_t _logs[TRACE_NUM_EVENTS] = {LOGTABLE_INIT};
 
+/// Workers trace into their own rings, which the trace writer thread streams
+/// into the logs. Threads that aren't workers (and workers before
+/// inst_start()) share a single ring under a lock.
+/// @{
+static volatile bool _tracing = false;
+static trace_ring_t **_rings = NULL;
+static volatile int _nrings = 0;
+static trace_ring_t *_shared = NULL;
+static tatas_lock_t _shared_lock = SYNC_TATAS_LOCK_INIT;
+/// @}
+
+/// The trace writer polls the rings this often (in microseconds) when it finds
+/// nothing to write.
+#define TRACE_WRITER_INTERVAL 1000
+
+static pthread_t _writer;
+static volatile bool _writing = false;
+
 /// Concatenate two paths. Callee must free returned char*.
 static char *_get_complete_path(const char *path, const char *filename) {
   int len_path = strlen(path);
@@ -93,7 +116,7 @@ static void _dump_actions(void) {
   }
 }
 
-static void _log_create(int class, int id, size_t size, hpx_time_t now) {
+static void _log_create(int class, int id, size_t size) {
   char filename[256];
   snprintf(filename, 256, "event.%d.%d.%d.%s.%s.log",
            class, id, hpx_get_my_rank(),
@@ -156,6 +179,114 @@ static const char *_get_log_path(const char *dir) {
   return NULL;
 }
 
+static void _write_entry(const trace_entry_t *entry, void *env) {
+  logtable_append(&_logs[entry->id], entry->worker, entry->n, entry->fields);
+}
+
+/// Move everything that is currently in the rings into the logs.
+static size_t _drain(void) {
+  size_t n = trace_ring_drain(_shared, _write_entry, NULL);
+  for (int i = 0, e = sync_load(&_nrings, SYNC_ACQUIRE); i < e; ++i) {
+    n += trace_ring_drain(_rings[i], _write_entry, NULL);
+  }
+  return n;
+}
+
+static void *_trace_writer(void *UNUSED) {
+  while (sync_load(&_writing, SYNC_ACQUIRE)) {
+    if (!_drain()) {
+      system_usleep(TRACE_WRITER_INTERVAL);
+    }
+  }
+  return NULL;
+}
+
+static int _trace_start(const config_t *cfg) {
+  _shared = trace_ring_new(cfg->trace_buffersize, cfg->trace_backpressure);
+  if (!_shared) {
+    return LIBHPX_ERROR;
+  }
+
+  sync_store(&_writing, true, SYNC_RELEASE);
+  if (pthread_create(&_writer, NULL, _trace_writer, NULL)) {
+    _writing = false;
+    trace_ring_delete(_shared);
+    _shared = NULL;
+    return LIBHPX_ERROR;
+  }
+  return LIBHPX_OK;
+}
+
+/// Write the number of events that were recorded and dropped to a summary
+/// file, so that truncated traces are never silent.
+static void _dump_trace_summary(void) {
+  char filename[256];
+  snprintf(filename, 256, "trace.%d", HPX_LOCALITY_ID);
+  char *filepath = _get_complete_path(_log_path, filename);
+  FILE *f = fopen(filepath, "w");
+  if (f == NULL) {
+    log_error("failed to open trace summary file %s\n", filepath);
+    free(filepath);
+    return;
+  }
+
+  size_t dropped = 0;
+  fprintf(f, "%-32s%-16s%-16s\n", "Event", "Recorded", "Dropped (size)");
+  for (int i = 0, e = TRACE_NUM_EVENTS; i < e; ++i) {
+    logtable_t *log = &_logs[i];
+    if (log->buffer) {
+      fprintf(f, "%-32s%-16zu%-16zu\n", TRACE_EVENT_TO_STRING[i],
+              log->records, log->dropped);
+      dropped += log->dropped;
+    }
+  }
+
+  fprintf(f, "\n%-32s%-16s\n", "Buffer", "Dropped (full)");
+  fprintf(f, "%-32s%-16"PRIu64"\n", "shared", _shared->dropped);
+  dropped += _shared->dropped;
+  for (int i = 0, e = _nrings; i < e; ++i) {
+    fprintf(f, "worker %-25d%-16"PRIu64"\n", i, _rings[i]->dropped);
+    dropped += _rings[i]->dropped;
+  }
+
+  int e = fclose(f);
+  if (e != 0) {
+    log_error("failed to write trace summary to %s\n", filepath);
+  }
+  free(filepath);
+
+  if (dropped) {
+    log_dflt("dropped %zu trace events, see %s/%s\n", dropped, _log_path,
+             filename);
+  }
+}
+
+/// Stop the trace writer and write out everything that it hasn't yet.
+static void _trace_stop(void) {
+  if (!sync_load(&_writing, SYNC_ACQUIRE)) {
+    return;
+  }
+
+  sync_store(&_writing, false, SYNC_RELEASE);
+  int e = pthread_join(_writer, NULL);
+  if (e) {
+    log_error("failed to join the trace writer\n");
+  }
+
+  _tracing = false;
+  _drain();
+  _dump_trace_summary();
+
+  for (int i = 0, e = _nrings; i < e; ++i) {
+    trace_ring_delete(_rings[i]);
+  }
+  free(_rings);
+  _rings = NULL;
+  _nrings = 0;
+  trace_ring_delete(_shared);
+  _shared = NULL;
+}
+
 int inst_init(config_t *cfg) {
 #ifndef ENABLE_INSTRUMENTATION
   return LIBHPX_OK;
@@ -170,12 +301,12 @@ int inst_init(config_t *cfg) {
   }
 
   // create log files
-  hpx_time_t start = hpx_time_now();
   int nclasses = _HPX_NELEM(HPX_TRACE_CLASS_TO_STRING);
   for (int cl = 0, e = nclasses; cl < e; ++cl) {
     if (inst_trace_class(1 << cl)) {
       for (int id = TRACE_OFFSETS[cl], e = TRACE_OFFSETS[cl + 1]; id < e; ++id) {
-        _log_create(cl, id, cfg->trace_filesize, start);
+        _log_create(cl, id, cfg->trace_filesize);
+        _tracing = true;
       }
     }
   }
@@ -186,6 +317,11 @@ int inst_init(config_t *cfg) {
   }
   _detailed_prof = cfg->prof_detailed;
 
+  if (_tracing && _trace_start(cfg)) {
+    log_error("failed to start the trace writer\n");
+    _tracing = false;
+  }
+
   inst_trace(HPX_TRACE_BOOKEND, TRACE_EVENT_BOOKEND_BOOKEND);
   return LIBHPX_OK;
 }
@@ -230,16 +366,31 @@ int inst_start(void) {
     _dump_hostnames();
   }
 
+  // give each worker its own trace ring, now that we know how many there are
+  if (_tracing && !_rings) {
+    const config_t *cfg = here->config;
+    int n = cfg->threads;
+    _rings = calloc(n, sizeof(*_rings));
+    dbg_assert(_rings);
+    for (int i = 0; i < n; ++i) {
+      _rings[i] = trace_ring_new(cfg->trace_buffersize, cfg->trace_backpressure);
+      dbg_assert(_rings[i]);
+    }
+    sync_store(&_nrings, n, SYNC_RELEASE);
+  }
+
   return 0;
 }
 
 void inst_fini(void) {
   inst_trace(HPX_TRACE_BOOKEND, TRACE_EVENT_BOOKEND_BOOKEND);
   prof_fini();
+  _trace_stop();
   for (int i = 0, e = TRACE_NUM_EVENTS; i < e; ++i) {
     logtable_fini(&_logs[i]);
   }
   free((void*)_log_path);
+  _log_path = NULL;
 }
 
 void inst_prof_dump(profile_log_t log) {
@@ -346,13 +497,20 @@ void inst_prof_dump(profile_log_t log) {
 }
 
 void inst_vtrace(int UNUSED, int n, int id, ...) {
-  logtable_t *log = &_logs[id];
-  if (!log->records) {
+  if (!_tracing || !_logs[id].buffer) {
     return;
   }
 
   va_list vargs;
   va_start(vargs, id);
-  logtable_vappend(log, n, &vargs);
+  int worker = HPX_THREAD_ID;
+  if (0 <= worker && worker < _nrings) {
+    trace_ring_vappend(_rings[worker], worker, id, n, &vargs);
+  }
+  else {
+    sync_tatas_acquire(&_shared_lock);
+    trace_ring_vappend(_shared, worker, id, n, &vargs);
+    sync_tatas_release(&_shared_lock);
+  }
   va_end(vargs);
 }
@@ -15,14 +15,13 @@
 # include "config.h"
 #endif
 
+#include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include <unistd.h>
-#include <sys/mman.h>
-
-#include <libsync/sync.h>
+#include <sys/stat.h>
 
 #include <libhpx/debug.h>
 #include <libhpx/libhpx.h>
@@ -30,46 +29,33 @@
 #include "file_header.h"
 #include "logtable.h"
 
-static size_t _header_size(logtable_t *log) {
-  return (size_t)((uintptr_t)log->records - (uintptr_t)log->header);
-}
+/// The size of the staging buffer for each log. This must be larger than the
+/// file header.
+#define LOGTABLE_BUFFER_SIZE (1u << 16)
 
-static int _create_file(const char *filename, size_t size) {
-  static const int flags = O_RDWR | O_CREAT;
+static int _create_file(const char *filename) {
+  static const int flags = O_WRONLY | O_CREAT | O_TRUNC;
   static const int perm = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
   int fd = open(filename, flags, perm);
   if (fd == -1) {
     log_error("failed to open a log file for %s\n", filename);
-    return -1;
-  }
-
-  lseek(fd, size - 1, SEEK_SET);
-  if (write(fd, "", 1) != 1) {
-    log_error("could not create log file %s\n", filename);
-    close(fd);
-    return -1;
   }
-
   return fd;
 }
 
-static void *_create_mmap(size_t size, int file) {
-  static const int prot = PROT_WRITE;
-  static const int flags = MAP_SHARED | MAP_NORESERVE;
-  void *base = mmap(NULL, size * sizeof(record_t), prot, flags, file, 0);
-  if (base == MAP_FAILED) {
-    log_error("could not mmap log file\n");
-    return NULL;
-  }
-  else {
-    log_dflt("mapped %zu byte trace file at %p.\n", size * sizeof(record_t), base);
-  }
-
-  if ((uintptr_t)base % HPX_CACHELINE_SIZE) {
-    log_dflt("log records are not cacheline aligned\n");
+static int _write(int fd, const char *buffer, size_t bytes) {
+  while (bytes) {
+    ssize_t n = write(fd, buffer, bytes);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return LIBHPX_ERROR;
+    }
+    buffer += n;
+    bytes -= n;
   }
-
-  return base;
+  return LIBHPX_OK;
 }
 
 int logtable_init(logtable_t *log, const char* filename, size_t size,
@@ -77,80 +63,91 @@ int logtable_init(logtable_t *log, const char* filename, size_t size,
   log->fd = -1;
   log->class = class;
   log->id = id;
-  sync_store(&log->next, 0, SYNC_RELEASE);
-  sync_store(&log->last, 0, SYNC_RELEASE);
+  log->record_size = sizeof(record_t) + TRACE_EVENT_NUM_FIELDS[id] * sizeof(uint64_t);
   log->max_size = size;
-  log->records = NULL;
+  log->size = 0;
+  log->records = 0;
+  log->dropped = 0;
+  log->buffered = 0;
+  log->buffer = NULL;
 
-  if (filename == NULL || size == 0) {
+  if (filename == NULL) {
     return LIBHPX_OK;
   }
 
-  log->fd = _create_file(filename, size);
+  log->fd = _create_file(filename);
   if (log->fd == -1) {
-    goto unwind;
+    return LIBHPX_ERROR;
   }
 
-  log->header = _create_mmap(size, log->fd);
-  if (!log->header) {
-    goto unwind;
+  log->buffer = malloc(LOGTABLE_BUFFER_SIZE);
+  if (!log->buffer) {
+    log_error("could not allocate a buffer for %s\n", filename);
+    close(log->fd);
+    log->fd = -1;
+    return LIBHPX_ERROR;
   }
 
-  log->record_size = sizeof(record_t) + TRACE_EVENT_NUM_FIELDS[id] * sizeof(uint64_t);
-
-  size_t header_size = write_trace_header(log->header, class, id);
-  assert(((uintptr_t)log->header + header_size) % 8 == 0);
-  log->records = (void*)((uintptr_t)log->header + header_size);
-
+  // The header goes through the staging buffer like everything else.
+  log->buffered = write_trace_header(log->buffer, class, id);
+  assert(log->buffered % 8 == 0);
+  assert(log->buffered + log->record_size <= LOGTABLE_BUFFER_SIZE);
   return LIBHPX_OK;
-
- unwind:
-  logtable_fini(log);
-  return LIBHPX_ERROR;
 }
 
 void logtable_fini(logtable_t *log) {
-  if (!log->max_size) {
+  if (!log->buffer) {
     return;
   }
 
-  if (log->header) {
-    int e = munmap(log->header, log->max_size);
-    if (e) {
-      log_error("failed to unmap trace file\n");
-    }
-  }
+  logtable_flush(log);
+  free(log->buffer);
+  log->buffer = NULL;
 
-  if (log->fd != -1) {
-    size_t filesize =
-      (uintptr_t)&log->records[log->last] - (uintptr_t)log->header;
-    int e = ftruncate(log->fd, filesize);
-    if (e) {
-      log_error("failed to truncate trace file\n");
-    }
-    e = close(log->fd);
-    if (e) {
-      log_error("failed to close trace file\n");
-    }
+  int e = close(log->fd);
+  if (e) {
+    log_error("failed to close trace file\n");
   }
+  log->fd = -1;
 }
 
-void logtable_append(logtable_t *log, uint64_t u1, uint64_t u2, uint64_t u3,
-                     uint64_t u4) {
+void logtable_flush(logtable_t *log) {
+  if (!log->buffered) {
+    return;
+  }
+
+  if (_write(log->fd, log->buffer, log->buffered)) {
+    log_error("failed to write %zu bytes to trace file for event %d\n",
+              log->buffered, log->id);
+  }
+  log->size += log->buffered;
+  log->buffered = 0;
 }
 
-void logtable_vappend(logtable_t *log, int n, va_list *args) {
-  size_t i = sync_fadd(&log->next, 1, SYNC_ACQ_REL);
-  if (_header_size(log) + (i+1) * log->record_size > log->max_size) {
+void logtable_append(logtable_t *log, int worker, int n,
+                     const uint64_t *fields) {
+  if (!log->buffer) {
     return;
   }
-  sync_fadd(&log->last, 1, SYNC_ACQ_REL); // update size
-
-  record_t *r = &log->records[i] + i*(n+1)*sizeof(uint64_t)/sizeof(record_t);
-  r->worker = HPX_THREAD_ID;
-  uint64_t *user = r->user;
-  user[0] = hpx_time_from_start_ns(hpx_time_now());
-  for (int i = 0; i < n; ++i) {
-    user[i+1] = va_arg(*args, uint64_t);
+
+  if (log->max_size &&
+      log->size + log->buffered + log->record_size > log->max_size) {
+    log->dropped++;
+    return;
   }
+
+  if (log->buffered + log->record_size > LOGTABLE_BUFFER_SIZE) {
+    logtable_flush(log);
+  }
+
+  // Events may be traced with fewer values than the log declares, in which
+  // case we zero the remaining columns.
+  record_t *r = (void*)(log->buffer + log->buffered);
+  int m = TRACE_EVENT_NUM_FIELDS[log->id];
+  n = (n < m) ? n : m;
+  r->worker = worker;
+  memcpy(r->user, fields, n * sizeof(uint64_t));
+  memset(&r->user[n], 0, (m - n) * sizeof(uint64_t));
+  log->buffered += log->record_size;
+  log->records++;
 }
@@ -14,19 +14,27 @@
 #ifndef LIBHPX_INSTRUMENTATION_LOGTABLE_H
 #define LIBHPX_INSTRUMENTATION_LOGTABLE_H
 
-struct record;
+#include <stddef.h>
+#include <stdint.h>
 
-/// All of the data needed to keep the state of an individual event log
+/// All of the data needed to keep the state of an individual event log.
+///
+/// Event logs are written by a single thread (the trace writer), which appends
+/// records to a small staging buffer and streams it to the end of the file
+/// whenever it fills. Files therefore grow with the run rather than being
+/// preallocated. If @p max_size is non-zero then records that would grow the
+/// file past it are counted in @p dropped rather than written.
 typedef struct {
   int                 fd;       //!< file backing the log
   int              class;       //!< the class we're logging
   int                 id;       //!< the event we're logging
   int        record_size;       //!< record size
-  size_t        max_size;       //!< max size in bytes
-  void           *header;       //!< pointer to file header
-  struct record *records;       //!< pointer to data for log
-  volatile size_t   next;       //!< the next element to write
-  volatile size_t   last;       //!< the last element written
+  size_t        max_size;       //!< max size in bytes (0 for unlimited)
+  size_t            size;       //!< bytes written to the file so far
+  size_t         records;       //!< number of records written
+  size_t         dropped;       //!< number of records dropped at max_size
+  size_t        buffered;       //!< bytes staged in the buffer
+  char           *buffer;       //!< the staging buffer
 } logtable_t;
 
 #define LOGTABLE_INIT {             \
@@ -35,21 +43,32 @@ typedef struct {
   .id          = -1,                \
   .record_size = 0,                 \
   .max_size    = 0,                 \
-  .header      = NULL,              \
-  .records     = NULL,              \
-  .next        = 0,                 \
-  .last        = 0                  \
+  .size        = 0,                 \
+  .records     = 0,                 \
+  .dropped     = 0,                 \
+  .buffered    = 0,                 \
+  .buffer      = NULL               \
 }
 
 /// Initialize a logtable.
 ///
-/// If filename is NULL or size == 0 this will not generate a file.
+/// If filename is NULL this will not generate a file.
 int logtable_init(logtable_t *lt, const char* filename, size_t size,
                   int class, int event);
 
+/// Flush and close a logtable.
 void logtable_fini(logtable_t *lt);
 
 /// Append a record to a log table.
-void logtable_vappend(logtable_t *log, int n, va_list *args);
+///
+/// @param          log The log to append to.
+/// @param       worker The worker that generated the event.
+/// @param            n The number of values in @p fields (timestamp first).
+/// @param       fields The values to record.
+void logtable_append(logtable_t *log, int worker, int n,
+                     const uint64_t *fields);
+
+/// Write any staged records to the file.
+void logtable_flush(logtable_t *log);
 
 #endif // LIBHPX_INSTRUMENTATION_LOGTABLE_H
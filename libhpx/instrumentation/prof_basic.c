@@ -42,11 +42,9 @@ int prof_init(struct config *cfg) {
 }
 
 void prof_fini(void) {
+  profile_merge();
   inst_prof_dump(_profile_log);
-  for (int i = 0; i < _profile_log.num_events; i++) {
-    free(_profile_log.events[i].entries);
-  }
-  free(_profile_log.events);
+  profile_fini();
 }
 
 int prof_get_averages(int64_t *values, char *key) {
@@ -65,71 +63,80 @@ int prof_get_maximums(int64_t *values, char *key) {
   return LIBHPX_OK;
 }
 
-int prof_start_hardware_counters(char *key, int *tag) {
-  prof_start_timing(key, tag);
+int prof_start_hardware_counters_id(int id, int *tag) {
+  prof_start_timing_id(id, tag);
   return LIBHPX_OK;
 }
 
-int prof_stop_hardware_counters(char *key, int *tag) {
-  prof_stop_timing(key, tag);
+int prof_stop_hardware_counters_id(int id, int *tag) {
+  prof_stop_timing_id(id, tag);
   return LIBHPX_OK;
 }
 
-int prof_pause(char *key, int *tag) {
+int prof_pause_id(int event, int *tag) {
   hpx_time_t end = hpx_time_now();
-  int event = profile_get_event(key);
-  if (event < 0) {
+  profile_log_t *log = profile_local_log();
+  if (!profile_local_event(log, event)) {
     return LIBHPX_EINVAL;
   }
 
+  int entry = HPX_PROF_NO_TAG;
   if (*tag == HPX_PROF_NO_TAG) {
-    for (int i = _profile_log.events[event].num_entries - 1; i >= 0; i--) {
-      if (!_profile_log.events[event].entries[i].marked &&
-         !_profile_log.events[event].entries[i].paused) {
-        *tag = i;
+    for (int i = log->events[event].num_entries - 1; i >= 0; i--) {
+      if (!log->events[event].entries[i].marked &&
+         !log->events[event].entries[i].paused) {
+        entry = i;
+        *tag = profile_tag(log, i);
         break;
       }
     }
   }
-  if (*tag == HPX_PROF_NO_TAG ||
-     _profile_log.events[event].entries[*tag].marked ||
-     _profile_log.events[event].entries[*tag].paused) {
+  else {
+    entry = profile_tag_entry(log, event, *tag);
+  }
+  if (entry == HPX_PROF_NO_TAG ||
+     log->events[event].entries[entry].marked ||
+     log->events[event].entries[entry].paused) {
     return LIBHPX_EINVAL;
   }
 
   // first store timing information
   hpx_time_t dur;
-  hpx_time_diff(_profile_log.events[event].entries[*tag].ref_time, end, &dur);
-  _profile_log.events[event].entries[*tag].run_time =
-      hpx_time_add(_profile_log.events[event].entries[*tag].run_time, dur);
+  hpx_time_diff(log->events[event].entries[entry].ref_time, end, &dur);
+  log->events[event].entries[entry].run_time =
+      hpx_time_add(log->events[event].entries[entry].run_time, dur);
 
-  _profile_log.events[event].entries[*tag].paused = true;
+  log->events[event].entries[entry].paused = true;
   return LIBHPX_OK;
 }
 
-int prof_resume(char *key, int *tag) {
-  int event = profile_get_event(key);
-  if (event < 0) {
+int prof_resume_id(int event, int *tag) {
+  profile_log_t *log = profile_local_log();
+  if (!profile_local_event(log, event)) {
     return LIBHPX_EINVAL;
   }
 
+  int entry = HPX_PROF_NO_TAG;
   if (*tag == HPX_PROF_NO_TAG) {
-    for (int i = _profile_log.events[event].num_entries - 1; i >= 0; i--) {
-      if (!_profile_log.events[event].entries[i].marked &&
-         _profile_log.events[event].entries[i].paused) {
-        *tag = i;
+    for (int i = log->events[event].num_entries - 1; i >= 0; i--) {
+      if (!log->events[event].entries[i].marked &&
+         log->events[event].entries[i].paused) {
+        entry = i;
+        *tag = profile_tag(log, i);
         break;
       }
     }
   }
-  if (*tag == HPX_PROF_NO_TAG) {
+  else {
+    entry = profile_tag_entry(log, event, *tag);
+  }
+  if (entry == HPX_PROF_NO_TAG) {
     return LIBHPX_EINVAL;
   }
 
-  _profile_log.events[event].entries[*tag].paused = false;
-  _profile_log.events[event].entries[*tag].start_time = hpx_time_now();
-  _profile_log.events[event].entries[*tag].ref_time =
-    _profile_log.events[event].entries[*tag].start_time;
+  log->events[event].entries[entry].paused = false;
+  log->events[event].entries[entry].start_time = hpx_time_now();
+  log->events[event].entries[entry].ref_time =
+    log->events[event].entries[entry].start_time;
   return LIBHPX_OK;
 }
-
@@ -53,20 +53,19 @@ int prof_get_maximums(int64_t *values, char *key) {
   return LIBHPX_OK;
 }
 
-int prof_start_hardware_counters(char *key, int *tag) {
+int prof_start_hardware_counters_id(int id, int *tag) {
   return LIBHPX_OK;
 }
 
-int prof_stop_hardware_counters(char *key, int *tag) {
-  prof_stop_timing(key, tag);
+int prof_stop_hardware_counters_id(int id, int *tag) {
+  prof_stop_timing_id(id, tag);
   return LIBHPX_OK;
 }
 
-int prof_pause(char *key, int *tag) {
+int prof_pause_id(int id, int *tag) {
   return LIBHPX_OK;
 }
 
-int prof_resume(char *key, int *tag) {
+int prof_resume_id(int id, int *tag) {
   return LIBHPX_OK;
 }
-
@@ -97,16 +97,9 @@ int prof_init(config_t *cfg) {
 }
 
 void prof_fini(void) {
+  profile_merge();
   inst_prof_dump(_profile_log);
-  for (int i = 0; i < _profile_log.num_events; i++) {
-    if (!_profile_log.events[i].simple) {
-      for (int j = 0; j < _profile_log.events[i].num_entries; j++) {
-        free(_profile_log.events[i].entries[j].counter_totals);
-      }
-    }
-    free(_profile_log.events[i].entries);
-  }
-  free(_profile_log.events);
+  profile_fini();
   free(_profile_log.counters);
 }
 
@@ -209,188 +202,204 @@ int prof_get_maximums(int64_t *values, char *key) {
   return LIBHPX_OK;
 }
 
-static int _create_new_event(char *key) {
+/// PAPI eventsets are bound to the thread that starts them, so each thread
+/// creates its own eventset for each event the first time it counts it.
+static void _create_eventset(profile_log_t *log, profile_list_t *list) {
   int eventset = PAPI_NULL;
   int retval = PAPI_create_eventset(&eventset);
   if (retval != PAPI_OK) {
     log_error("unable to create eventset with error code %d\n", retval);
   } else {
-    for (int i = 0; i < _profile_log.num_counters; i++) {
-      PAPI_add_event(eventset, _papi_events[_profile_log.counters[i]]);
+    for (int i = 0; i < log->num_counters; i++) {
+      PAPI_add_event(eventset, _papi_events[log->counters[i]]);
     }
   }
-
-  return profile_new_event(key, false, eventset);
+  list->eventset = eventset;
 }
 
-int prof_start_hardware_counters(char *key, int *tag) {
+int prof_start_hardware_counters_id(int event, int *tag) {
   hpx_time_t end = hpx_time_now();
-  int event = profile_get_event(key);
-  if (event < 0) {
-    event = _create_new_event(key);
-  }
-  if(event < 0){
+  profile_log_t *log = profile_local_log();
+  profile_list_t *list = profile_local_event(log, event);
+  if (!list) {
     return LIBHPX_ERROR;
   }
 
-  if (_profile_log.events[event].simple) {
+  if (list->simple) {
     return LIBHPX_EINVAL;
   }
+
+  if (list->eventset == PAPI_NULL) {
+    _create_eventset(log, list);
+  }
   
   // update the current event and entry being recorded
-  if (_profile_log.current_event >= 0 && 
-     !_profile_log.events[_profile_log.current_event].entries[
-                          _profile_log.current_entry].marked &&
-     !_profile_log.events[_profile_log.current_event].entries[
-                          _profile_log.current_entry].paused) {
+  if (log->current_event >= 0 && 
+     !log->events[log->current_event].entries[
+                          log->current_entry].marked &&
+     !log->events[log->current_event].entries[
+                          log->current_entry].paused) {
     // left as long long instead of int64_t to suppress a warning
     // at compile time
-    long long values[_profile_log.num_counters];
-    for (int i = 0; i < _profile_log.num_counters; i++) {
+    long long values[log->num_counters];
+    for (int i = 0; i < log->num_counters; i++) {
       values[i] = -1;
     }
-    PAPI_stop(_profile_log.events[_profile_log.current_event].eventset, 
+    PAPI_stop(log->events[log->current_event].eventset, 
               values);
 
     hpx_time_t dur;
-    hpx_time_diff(_profile_log.events[
-                  _profile_log.current_event].entries[
-                  _profile_log.current_entry].ref_time, end, &dur);
-    _profile_log.events[_profile_log.current_event].entries[
-                        _profile_log.current_entry].run_time =
-             hpx_time_add(_profile_log.events[_profile_log.current_event].entries[
-                        _profile_log.current_entry].run_time, dur);
-
-    for (int i = 0; i < _profile_log.num_counters; i++) {
-      _profile_log.events[_profile_log.current_event].entries[
-                          _profile_log.current_entry].counter_totals[i] 
+    hpx_time_diff(log->events[
+                  log->current_event].entries[
+                  log->current_entry].ref_time, end, &dur);
+    log->events[log->current_event].entries[
+                        log->current_entry].run_time =
+             hpx_time_add(log->events[log->current_event].entries[
+                        log->current_entry].run_time, dur);
+
+    for (int i = 0; i < log->num_counters; i++) {
+      log->events[log->current_event].entries[
+                          log->current_entry].counter_totals[i] 
                           += (int64_t) values[i];
     }
   }
 
-  int index = profile_new_entry(event);
+  int index = profile_new_entry(log, event);
   
-  _profile_log.events[event].entries[index].last_entry = _profile_log.current_entry;
-  _profile_log.events[event].entries[index].last_event = _profile_log.current_event;
-  _profile_log.current_entry = index;
-  _profile_log.current_event = event;
-  *tag = index;
-  PAPI_reset(_profile_log.events[_profile_log.current_event].eventset);
-  _profile_log.events[event].entries[index].start_time = hpx_time_now();
-  _profile_log.events[event].entries[index].ref_time = 
-    _profile_log.events[event].entries[index].start_time;
-  return PAPI_start(_profile_log.events[event].eventset);
+  log->events[event].entries[index].last_entry = log->current_entry;
+  log->events[event].entries[index].last_event = log->current_event;
+  log->current_entry = index;
+  log->current_event = event;
+  *tag = profile_tag(log, index);
+  PAPI_reset(log->events[log->current_event].eventset);
+  log->events[event].entries[index].start_time = hpx_time_now();
+  log->events[event].entries[index].ref_time = 
+    log->events[event].entries[index].start_time;
+  return PAPI_start(log->events[event].eventset);
 }
 
-int prof_stop_hardware_counters(char *key, int *tag) {
-  int event = prof_stop_timing(key, tag);
+int prof_stop_hardware_counters_id(int id, int *tag) {
+  int event = prof_stop_timing_id(id, tag);
   if (event < 0 || *tag == HPX_PROF_NO_TAG) {
     return LIBHPX_EINVAL;
   }
 
+  profile_log_t *log = profile_local_log();
+  int entry = profile_tag_entry(log, event, *tag);
+
   // left as long long instead of int64_t to suppress a warning
   // at compile time
-  long long values[_profile_log.num_counters];
-  for (int i = 0; i < _profile_log.num_counters; i++) {
+  long long values[log->num_counters];
+  for (int i = 0; i < log->num_counters; i++) {
     values[i] = -1;
   }
-  int retval = PAPI_stop(_profile_log.events[event].eventset, values);
-  PAPI_reset(_profile_log.events[event].eventset);
+  int retval = PAPI_stop(log->events[event].eventset, values);
+  PAPI_reset(log->events[event].eventset);
   if (retval != PAPI_OK) {
     return retval;
   }
   
-  for (int i = 0; i < _profile_log.num_counters; i++) {
-    _profile_log.events[event].entries[*tag].counter_totals[i] 
+  for (int i = 0; i < log->num_counters; i++) {
+    log->events[event].entries[entry].counter_totals[i] 
       += (int64_t) values[i];
   }
 
   // if another event/entry was being measured prior to switching to the current
   // event/entry, then pick up where we left off (check current_event because it
   // was already updated in prof_stop_timing())
-  if (_profile_log.current_event >= 0 && 
-     !_profile_log.events[event].entries[_profile_log.current_entry].paused) {
-    PAPI_start(_profile_log.events[_profile_log.current_event].eventset);
+  if (log->current_event >= 0 && 
+     !log->events[log->current_event].entries[log->current_entry].paused) {
+    PAPI_start(log->events[log->current_event].eventset);
   }
 
   return LIBHPX_OK;
 }
 
-int prof_pause(char *key, int *tag) {
+int prof_pause_id(int event, int *tag) {
   hpx_time_t end = hpx_time_now();
-  int event = profile_get_event(key);
-  if (event < 0) {
+  profile_log_t *log = profile_local_log();
+  if (!profile_local_event(log, event)) {
     return LIBHPX_EINVAL;
   }
 
+  int entry = HPX_PROF_NO_TAG;
   if (*tag == HPX_PROF_NO_TAG) {
-    for (int i = _profile_log.events[event].num_entries - 1; i >= 0; i--) {
-      if (!_profile_log.events[event].entries[i].marked && 
-         !_profile_log.events[event].entries[i].paused) {
-        *tag = i;
+    for (int i = log->events[event].num_entries - 1; i >= 0; i--) {
+      if (!log->events[event].entries[i].marked && 
+         !log->events[event].entries[i].paused) {
+        entry = i;
+        *tag = profile_tag(log, i);
         break;
       }
     }
   }
-  if (*tag == HPX_PROF_NO_TAG ||
-     _profile_log.events[event].entries[*tag].marked ||
-     _profile_log.events[event].entries[*tag].paused) {
+  else {
+    entry = profile_tag_entry(log, event, *tag);
+  }
+  if (entry == HPX_PROF_NO_TAG ||
+     log->events[event].entries[entry].marked ||
+     log->events[event].entries[entry].paused) {
     return LIBHPX_EINVAL;
   }
 
   // first store timing information
   hpx_time_t dur;
-  hpx_time_diff(_profile_log.events[event].entries[*tag].ref_time, end, &dur);
-  _profile_log.events[event].entries[*tag].run_time = 
-      hpx_time_add(_profile_log.events[event].entries[*tag].run_time, dur);
+  hpx_time_diff(log->events[event].entries[entry].ref_time, end, &dur);
+  log->events[event].entries[entry].run_time = 
+      hpx_time_add(log->events[event].entries[entry].run_time, dur);
 
   // then store counter information if necessary
-  if (!_profile_log.events[event].simple) {
+  if (!log->events[event].simple) {
     // I leave this as type long long instead of int64_t to suppress a warning
     // at compile time that appears if I do otherwise
-    long long values[_profile_log.num_counters];
-    for (int i = 0; i < _profile_log.num_counters; i++) {
+    long long values[log->num_counters];
+    for (int i = 0; i < log->num_counters; i++) {
       values[i] = -1;
     }
-    int retval = PAPI_stop(_profile_log.events[event].eventset, values);
-    PAPI_reset(_profile_log.events[event].eventset);
+    int retval = PAPI_stop(log->events[event].eventset, values);
+    PAPI_reset(log->events[event].eventset);
     if (retval != PAPI_OK) {
       return retval;
     }
     
-    for (int i = 0; i < _profile_log.num_counters; i++) {
-      _profile_log.events[event].entries[*tag].counter_totals[i] 
+    for (int i = 0; i < log->num_counters; i++) {
+      log->events[event].entries[entry].counter_totals[i] 
         += (int64_t) values[i];
     }
   }
-  _profile_log.events[event].entries[*tag].paused = true;
+  log->events[event].entries[entry].paused = true;
   return LIBHPX_OK;
 }
 
-int prof_resume(char *key, int *tag) {
-  int event = profile_get_event(key);
-  if (event < 0) {
+int prof_resume_id(int event, int *tag) {
+  profile_log_t *log = profile_local_log();
+  if (!profile_local_event(log, event)) {
     return LIBHPX_EINVAL;
   }
 
+  int entry = HPX_PROF_NO_TAG;
   if (*tag == HPX_PROF_NO_TAG) {
-    for (int i = _profile_log.events[event].num_entries - 1; i >= 0; i--) {
-      if (!_profile_log.events[event].entries[i].marked && 
-         _profile_log.events[event].entries[i].paused) {
-        *tag = i;
+    for (int i = log->events[event].num_entries - 1; i >= 0; i--) {
+      if (!log->events[event].entries[i].marked && 
+         log->events[event].entries[i].paused) {
+        entry = i;
+        *tag = profile_tag(log, i);
         break;
       }
     }
   }
-  if (*tag == HPX_PROF_NO_TAG) {
+  else {
+    entry = profile_tag_entry(log, event, *tag);
+  }
+  if (entry == HPX_PROF_NO_TAG) {
     return LIBHPX_EINVAL;
   }
 
-  _profile_log.events[event].entries[*tag].paused = false;
-  _profile_log.events[event].entries[*tag].ref_time = hpx_time_now();
-  if (!_profile_log.events[event].simple) {
-    PAPI_reset(_profile_log.events[_profile_log.current_event].eventset);
-    return PAPI_start(_profile_log.events[event].eventset);
+  log->events[event].entries[entry].paused = false;
+  log->events[event].entries[entry].ref_time = hpx_time_now();
+  if (!log->events[event].simple) {
+    PAPI_reset(log->events[log->current_event].eventset);
+    return PAPI_start(log->events[event].eventset);
   }
   return LIBHPX_OK;
 }
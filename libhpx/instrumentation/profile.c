@@ -16,6 +16,7 @@
 #endif
 
 #include <errno.h>
+#include <limits.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
@@ -28,49 +29,240 @@
 #include <libhpx/libhpx.h>
 #include <libhpx/locality.h>
 #include <libhpx/profiling.h>
+#include <libsync/locks.h>
 #include <libsync/sync.h>
 
 profile_log_t _profile_log = PROFILE_INIT;
 
-int profile_new_event(char *key, bool simple, int eventset) {
-  if (_profile_log.events == NULL) {
+/// The registered events are the events in the locality's profile log, which
+/// only hold entries once the per-thread logs are merged. The registry index
+/// is an open-addressed hash table from key to handle. Both are protected by
+/// the registry lock, and are only touched when an event is registered, or
+/// when a thread first records a particular event.
+/// @{
+static tatas_lock_t _registry_lock = SYNC_TATAS_LOCK_INIT;
+static int *_index = NULL;
+static uint32_t _index_mask = 0;
+/// @}
+
+/// The number of keys that each thread caches.
+#define PROFILE_KEY_CACHE_SIZE 64
+
+/// A thread's profile log, along with a small cache of the key strings that
+/// it has looked up, so that the string interface doesn't need to go to the
+/// registry each time.
+typedef struct _local {
+  profile_log_t    log;
+  struct _local  *next;
+  struct {
+    const char *key;
+    int       event;
+  } cache[PROFILE_KEY_CACHE_SIZE];
+} _local_t;
+
+static __thread _local_t *_local = NULL;
+static _local_t *_locals = NULL;
+static int _next_log_id = 0;
+
+/// Tags hold the index of an entry along with the low bits of the id of the
+/// thread log that holds it.
+#define PROFILE_TAG_LOG_BITS 10
+#define PROFILE_TAG_LOG_MASK ((1 << PROFILE_TAG_LOG_BITS) - 1)
+
+static uint32_t _hash(const char *key) {
+  uint32_t h = 2166136261u;
+  for (const char *c = key; *c; ++c) {
+    h = (h ^ (uint8_t)*c) * 16777619u;
+  }
+  return h;
+}
+
+/// Find a key in the registry index. The registry lock must be held.
+static int _index_find(const char *key) {
+  if (!_index) {
     return LIBHPX_ERROR;
   }
+  for (uint32_t i = _hash(key) & _index_mask; _index[i] >= 0;
+       i = (i + 1) & _index_mask) {
+    if (strcmp(key, _profile_log.events[_index[i]].key) == 0) {
+      return _index[i];
+    }
+  }
+  return LIBHPX_ERROR;
+}
+
+/// Insert an event into the registry index, growing it so that it stays at
+/// most half full. The registry lock must be held.
+static void _index_insert(int event) {
+  uint32_t size = _index_mask + 1;
+  if (!_index || 2 * (uint32_t)_profile_log.num_events > size) {
+    size = (_index) ? 2 * size : 2 * _profile_log.max_events;
+    free(_index);
+    _index = malloc(size * sizeof(*_index));
+    dbg_assert(_index);
+    memset(_index, -1, size * sizeof(*_index));
+    _index_mask = size - 1;
+    for (int e = 0; e < event; ++e) {
+      _index_insert(e);
+    }
+  }
+
+  uint32_t i = _hash(_profile_log.events[event].key) & _index_mask;
+  while (_index[i] >= 0) {
+    i = (i + 1) & _index_mask;
+  }
+  _index[i] = event;
+}
+
+int prof_register_event(const char *key, bool simple) {
+  sync_tatas_acquire(&_registry_lock);
+  int event = _index_find(key);
+  if (event >= 0 || _profile_log.events == NULL) {
+    sync_tatas_release(&_registry_lock);
+    return event;
+  }
+
   if (_profile_log.num_events == _profile_log.max_events) {
     _profile_log.max_events *= 2;
     size_t bytes = _profile_log.max_events * sizeof(profile_list_t);
     _profile_log.events = realloc(_profile_log.events, bytes);
     dbg_assert(_profile_log.events);
   }
-  int index = _profile_log.num_events++;
-  profile_list_t *list = &_profile_log.events[index];
-  if (list == NULL) {
-    _profile_log.num_events--;
-    return LIBHPX_ERROR;
-  }
-  list->entries = malloc(_profile_log.max_events * sizeof(profile_entry_t));
-  dbg_assert(list->entries);
+  event = _profile_log.num_events;
+  profile_list_t *list = &_profile_log.events[event];
+  list->entries = NULL;
   list->num_entries = 0;
-  list->max_entries = _profile_log.max_events;
-  list->key = key;
+  list->max_entries = 0;
+  list->key = strdup(key);
   list->simple = simple;
-  list->eventset = eventset;
-  return index;
+  list->eventset = -1;
+  sync_store(&_profile_log.num_events, event + 1, SYNC_RELEASE);
+  _index_insert(event);
+  sync_tatas_release(&_registry_lock);
+  return event;
 }
 
-// Returns index of matching key or returns -1 if the event
-// does not exist.
-int profile_get_event(char *key) {
-  for (int i = 0; i < _profile_log.num_events; i++) {
-    if (strcmp(key, _profile_log.events[i].key) == 0) {
-      return i;
+int profile_get_event(const char *key) {
+  sync_tatas_acquire(&_registry_lock);
+  int event = _index_find(key);
+  sync_tatas_release(&_registry_lock);
+  return event;
+}
+
+profile_log_t *profile_local_log(void) {
+  if (likely(_local != NULL)) {
+    return &_local->log;
+  }
+
+  if (_profile_log.events == NULL) {
+    return NULL;
+  }
+
+  _local_t *local = calloc(1, sizeof(*local));
+  dbg_assert(local);
+  local->log.num_counters = _profile_log.num_counters;
+  local->log.counters = _profile_log.counters;
+  local->log.current_entry = -1;
+  local->log.current_event = -1;
+  for (int i = 0; i < PROFILE_KEY_CACHE_SIZE; ++i) {
+    local->cache[i].event = LIBHPX_ERROR;
+  }
+
+  sync_tatas_acquire(&_registry_lock);
+  local->log.id = _next_log_id++;
+  local->next = _locals;
+  _locals = local;
+  sync_tatas_release(&_registry_lock);
+
+  _local = local;
+  return &local->log;
+}
+
+profile_list_t *profile_local_event(profile_log_t *log, int event) {
+  if (!log || event < 0) {
+    return NULL;
+  }
+
+  if (event >= log->num_events &&
+      event >= sync_load(&_profile_log.num_events, SYNC_ACQUIRE)) {
+    return NULL;
+  }
+
+  if (event >= log->max_events) {
+    int n = (log->max_events) ? log->max_events : 16;
+    while (n <= event) {
+      n *= 2;
     }
+    log->events = realloc(log->events, n * sizeof(profile_list_t));
+    dbg_assert(log->events);
+    memset(&log->events[log->max_events], 0,
+           (n - log->max_events) * sizeof(profile_list_t));
+    log->max_events = n;
   }
-  return LIBHPX_ERROR;
+
+  profile_list_t *list = &log->events[event];
+  if (unlikely(list->key == NULL)) {
+    sync_tatas_acquire(&_registry_lock);
+    list->key = _profile_log.events[event].key;
+    list->simple = _profile_log.events[event].simple;
+    sync_tatas_release(&_registry_lock);
+    list->eventset = -1;
+    list->max_entries = 64;
+    list->num_entries = 0;
+    list->entries = malloc(list->max_entries * sizeof(profile_entry_t));
+    dbg_assert(list->entries);
+    if (log->num_events <= event) {
+      log->num_events = event + 1;
+    }
+  }
+  return list;
 }
 
-int profile_new_entry(int event) {
-  profile_list_t *list = &_profile_log.events[event];
+/// Look up the handle for a key, using the calling thread's key cache, and
+/// optionally registering the key if it does not exist.
+static int _lookup(const char *key, bool simple, bool create) {
+  profile_log_t *log = profile_local_log();
+  if (!log) {
+    return LIBHPX_ERROR;
+  }
+
+  _local_t *local = (_local_t*)log;
+  uintptr_t i = ((uintptr_t)key >> 3) % PROFILE_KEY_CACHE_SIZE;
+  int event = local->cache[i].event;
+  if (local->cache[i].key == key && event >= 0 &&
+      strcmp(key, log->events[event].key) == 0) {
+    return event;
+  }
+
+  event = (create) ? prof_register_event(key, simple) : profile_get_event(key);
+  if (profile_local_event(log, event)) {
+    local->cache[i].key = key;
+    local->cache[i].event = event;
+  }
+  return event;
+}
+
+int profile_tag(const profile_log_t *log, int entry) {
+  if (entry < 0 || entry > (INT_MAX >> PROFILE_TAG_LOG_BITS)) {
+    return HPX_PROF_NO_TAG;
+  }
+  return (entry << PROFILE_TAG_LOG_BITS) | (log->id & PROFILE_TAG_LOG_MASK);
+}
+
+int profile_tag_entry(const profile_log_t *log, int event, int tag) {
+  if (tag < 0 || (tag & PROFILE_TAG_LOG_MASK) !=
+      (log->id & PROFILE_TAG_LOG_MASK)) {
+    return HPX_PROF_NO_TAG;
+  }
+  int entry = tag >> PROFILE_TAG_LOG_BITS;
+  if (entry >= log->events[event].num_entries) {
+    return HPX_PROF_NO_TAG;
+  }
+  return entry;
+}
+
+int profile_new_entry(profile_log_t *log, int event) {
+  profile_list_t *list = &log->events[event];
   dbg_assert(list->max_entries > 0);
   if (list->num_entries == list->max_entries) {
     list->max_entries *= 2;
@@ -90,14 +282,69 @@ int profile_new_entry(int event) {
     list->entries[index].counter_totals = NULL;
   } else {
     list->entries[index].counter_totals =
-        malloc(_profile_log.num_counters * sizeof(int64_t));
-    for (int i = 0; i < _profile_log.num_counters; ++i) {
+        malloc(log->num_counters * sizeof(int64_t));
+    for (int i = 0; i < log->num_counters; ++i) {
       list->entries[index].counter_totals[i] = -1;
     }
   }
   return index;
 }
 
+void profile_merge(void) {
+  sync_tatas_acquire(&_registry_lock);
+  while (_locals) {
+    _local_t *local = _locals;
+    _locals = local->next;
+
+    profile_log_t *log = &local->log;
+    for (int i = 0; i < log->num_events; ++i) {
+      profile_list_t *from = &log->events[i];
+      profile_list_t *to = &_profile_log.events[i];
+      if (!from->num_entries) {
+        free(from->entries);
+        continue;
+      }
+
+      int n = to->num_entries + from->num_entries;
+      if (n > to->max_entries) {
+        to->max_entries = n;
+        size_t bytes = to->max_entries * sizeof(profile_entry_t);
+        to->entries = realloc(to->entries, bytes);
+        dbg_assert(to->entries);
+      }
+      memcpy(&to->entries[to->num_entries], from->entries,
+             from->num_entries * sizeof(profile_entry_t));
+      to->num_entries = n;
+      free(from->entries);
+    }
+    free(log->events);
+    if (local == _local) {
+      _local = NULL;
+    }
+    free(local);
+  }
+  sync_tatas_release(&_registry_lock);
+}
+
+void profile_fini(void) {
+  for (int i = 0; i < _profile_log.num_events; i++) {
+    profile_list_t *list = &_profile_log.events[i];
+    if (!list->simple) {
+      for (int j = 0; j < list->num_entries; j++) {
+        free(list->entries[j].counter_totals);
+      }
+    }
+    free(list->entries);
+    free(list->key);
+  }
+  free(_profile_log.events);
+  _profile_log.events = NULL;
+  _profile_log.num_events = 0;
+  free(_index);
+  _index = NULL;
+  _index_mask = 0;
+}
+
 double prof_get_user_total(char *key) {
   int event = profile_get_event(key);
   if (event < 0) {
@@ -242,105 +489,135 @@ int prof_get_num_counters() {
   return _profile_log.num_counters;
 }
 
-void prof_record_user_val(char *key, double amount) {
-  int event = profile_get_event(key);
-  if (event < 0) {
-    event = profile_new_event(key, true, 0);
-  }
-  if (event < 0) {
+void prof_record_user_val_id(int id, double amount) {
+  profile_log_t *log = profile_local_log();
+  profile_list_t *list = profile_local_event(log, id);
+  if (!list) {
     return;
   }
-  int index = profile_new_entry(event);
-  _profile_log.events[event].entries[index].start_time = hpx_time_now();
-  _profile_log.events[event].entries[index].user_val = amount;
+  int index = profile_new_entry(log, id);
+  list->entries[index].start_time = hpx_time_now();
+  list->entries[index].user_val = amount;
 }
 
-void prof_mark(char *key) {
-  int event = profile_get_event(key);
-  if (event < 0) {
-    event = profile_new_event(key, true, 0);
-  }
-  if (event < 0) {
+void prof_record_user_val(char *key, double amount) {
+  prof_record_user_val_id(_lookup(key, true, true), amount);
+}
+
+void prof_mark_id(int id) {
+  profile_log_t *log = profile_local_log();
+  profile_list_t *list = profile_local_event(log, id);
+  if (!list) {
     return;
   }
-  int index = profile_new_entry(event);
-  _profile_log.events[event].entries[index].start_time = hpx_time_now();
+  int index = profile_new_entry(log, id);
+  list->entries[index].start_time = hpx_time_now();
 }
 
-void prof_start_timing(char *key, int *tag) {
+void prof_mark(char *key) {
+  prof_mark_id(_lookup(key, true, true));
+}
+
+void prof_start_timing_id(int event, int *tag) {
   hpx_time_t now = hpx_time_now();
-  int event = profile_get_event(key);
-  if (event < 0) {
-    event = profile_new_event(key, true, 0);
-  }
-  if (event < 0) {
+  profile_log_t *log = profile_local_log();
+  if (!profile_local_event(log, event)) {
     return;
   }
 
   // interrupt current timing
-  if (_profile_log.current_event >= 0 && 
-     !_profile_log.events[_profile_log.current_event].entries[
-                          _profile_log.current_entry].marked &&
-     !_profile_log.events[_profile_log.current_event].entries[
-                          _profile_log.current_entry].paused) {
+  if (log->current_event >= 0 &&
+     !log->events[log->current_event].entries[
+                          log->current_entry].marked &&
+     !log->events[log->current_event].entries[
+                          log->current_entry].paused) {
     hpx_time_t dur;
-    hpx_time_diff(_profile_log.events[_profile_log.current_event].entries[
-                  _profile_log.current_entry].ref_time, now, &dur);
-    _profile_log.events[_profile_log.current_event].entries[
-                        _profile_log.current_entry].run_time =
-             hpx_time_add(_profile_log.events[_profile_log.current_event].entries[
-                        _profile_log.current_entry].run_time, dur);
+    hpx_time_diff(log->events[log->current_event].entries[
+                  log->current_entry].ref_time, now, &dur);
+    log->events[log->current_event].entries[
+                        log->current_entry].run_time =
+             hpx_time_add(log->events[log->current_event].entries[
+                        log->current_entry].run_time, dur);
   }
 
-  int index = profile_new_entry(event);
-  _profile_log.events[event].entries[index].last_entry = _profile_log.current_entry;
-  _profile_log.events[event].entries[index].last_event = _profile_log.current_event;
-  _profile_log.current_entry = index;
-  _profile_log.current_event = event;
-  _profile_log.events[event].entries[index].start_time = hpx_time_now();
-  _profile_log.events[event].entries[index].ref_time = 
-    _profile_log.events[event].entries[index].start_time;
-  *tag = index;
+  int index = profile_new_entry(log, event);
+  log->events[event].entries[index].last_entry = log->current_entry;
+  log->events[event].entries[index].last_event = log->current_event;
+  log->current_entry = index;
+  log->current_event = event;
+  log->events[event].entries[index].start_time = hpx_time_now();
+  log->events[event].entries[index].ref_time =
+    log->events[event].entries[index].start_time;
+  *tag = profile_tag(log, index);
 }
 
-int prof_stop_timing(char *key, int *tag) {
+void prof_start_timing(char *key, int *tag) {
+  prof_start_timing_id(_lookup(key, true, true), tag);
+}
+
+int prof_stop_timing_id(int event, int *tag) {
   hpx_time_t end = hpx_time_now();
-  int event = profile_get_event(key);
-  if (event < 0) {
-    return event;
+  profile_log_t *log = profile_local_log();
+  if (!profile_local_event(log, event)) {
+    return LIBHPX_ERROR;
   }
 
+  int entry = HPX_PROF_NO_TAG;
   if (*tag == HPX_PROF_NO_TAG) {
-    for (int i = _profile_log.events[event].num_entries - 1; i >= 0; i--) {
-      if (!_profile_log.events[event].entries[i].marked) {
-        *tag = i;
+    for (int i = log->events[event].num_entries - 1; i >= 0; i--) {
+      if (!log->events[event].entries[i].marked) {
+        entry = i;
+        *tag = profile_tag(log, i);
         break;
       }
     }
+    if (entry == HPX_PROF_NO_TAG) {
+      return event;
+    }
   }
-  if (*tag == HPX_PROF_NO_TAG) {
-    return event;
+  else if ((entry = profile_tag_entry(log, event, *tag)) == HPX_PROF_NO_TAG) {
+    log_dflt("profiling tag %d is not valid on this thread\n", *tag);
+    return LIBHPX_ERROR;
   }
 
-  if (!_profile_log.events[event].entries[*tag].paused) {
+  profile_entry_t *e = &log->events[event].entries[entry];
+  if (!e->paused) {
     hpx_time_t dur;
-    hpx_time_diff(_profile_log.events[event].entries[*tag].ref_time, end, &dur);
-
-    _profile_log.events[event].entries[*tag].run_time = 
-        hpx_time_add(_profile_log.events[event].entries[*tag].run_time, dur);
+    hpx_time_diff(e->ref_time, end, &dur);
+    e->run_time = hpx_time_add(e->run_time, dur);
   }
-  _profile_log.events[event].entries[*tag].marked = true;
-  
+  e->marked = true;
+
   // if another event/entry was being measured prior to switching to the current
   // event/entry, then pick up where we left off
-  if (_profile_log.events[event].entries[*tag].last_event >= 0) {
-    _profile_log.current_entry = _profile_log.events[event].entries[*tag].last_entry;
-    _profile_log.current_event = _profile_log.events[event].entries[*tag].last_event;
-    if (!_profile_log.events[event].entries[_profile_log.current_entry].paused) {
-      _profile_log.events[_profile_log.current_event].entries
-                       [_profile_log.current_entry].ref_time
+  if (e->last_event >= 0) {
+    log->current_entry = e->last_entry;
+    log->current_event = e->last_event;
+    if (!log->events[log->current_event].entries[log->current_entry].paused) {
+      log->events[log->current_event].entries
+                       [log->current_entry].ref_time
                         = hpx_time_now();
     }
   }
   return event;
 }
+
+int prof_stop_timing(char *key, int *tag) {
+  return prof_stop_timing_id(_lookup(key, true, false), tag);
+}
+
+int prof_start_hardware_counters(char *key, int *tag) {
+  return prof_start_hardware_counters_id(_lookup(key, false, true), tag);
+}
+
+int prof_stop_hardware_counters(char *key, int *tag) {
+  return prof_stop_hardware_counters_id(_lookup(key, false, false), tag);
+}
+
+int prof_pause(char *key, int *tag) {
+  return prof_pause_id(_lookup(key, true, false), tag);
+}
+
+int prof_resume(char *key, int *tag) {
+  return prof_resume_id(_lookup(key, true, false), tag);
+}
@@ -0,0 +1,86 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <hpx/hpx.h>
+#include <libhpx/debug.h>
+#include <libhpx/instrumentation.h>
+#include <libsync/backoff.h>
+#include <libsync/sync.h>
+#include "trace_ring.h"
+
+_HPX_ASSERT(sizeof(trace_entry_t) == HPX_CACHELINE_SIZE, trace_entry_size);
+
+trace_ring_t *trace_ring_new(uint32_t capacity, bool backpressure) {
+  uint32_t bits = ceil_log2_32((capacity) ? capacity : 1);
+  uint64_t n = UINT64_C(1) << bits;
+  trace_ring_t *ring = NULL;
+  size_t bytes = sizeof(*ring) + n * sizeof(trace_entry_t);
+  int e = posix_memalign((void**)&ring, HPX_CACHELINE_SIZE, bytes);
+  if (e) {
+    log_error("could not allocate a %zu byte trace ring\n", bytes);
+    return NULL;
+  }
+  ring->head = 0;
+  ring->tail = 0;
+  ring->dropped = 0;
+  ring->mask = n - 1;
+  ring->backpressure = backpressure;
+  return ring;
+}
+
+void trace_ring_delete(trace_ring_t *ring) {
+  free(ring);
+}
+
+void trace_ring_vappend(trace_ring_t *ring, int worker, int id, int n,
+                        va_list *args) {
+  uint64_t time = hpx_time_from_start_ns(hpx_time_now());
+  uint64_t tail = ring->tail;
+  unsigned backoff = 1;
+  while (tail - sync_load(&ring->head, SYNC_ACQUIRE) > ring->mask) {
+    if (!ring->backpressure) {
+      sync_store(&ring->dropped, ring->dropped + 1, SYNC_RELAXED);
+      return;
+    }
+    sync_backoff_exp_r(&backoff);
+  }
+
+  trace_entry_t *entry = &ring->entries[tail & ring->mask];
+  n = (n < TRACE_RING_FIELDS - 1) ? n : TRACE_RING_FIELDS - 1;
+  entry->id = id;
+  entry->n = n + 1;
+  entry->worker = worker;
+  entry->fields[0] = time;
+  for (int i = 0; i < n; ++i) {
+    entry->fields[i + 1] = va_arg(*args, uint64_t);
+  }
+  sync_store(&ring->tail, tail + 1, SYNC_RELEASE);
+}
+
+size_t trace_ring_drain(trace_ring_t *ring,
+                        void (*f)(const trace_entry_t *, void *), void *env) {
+  uint64_t head = ring->head;
+  uint64_t tail = sync_load(&ring->tail, SYNC_ACQUIRE);
+  for (uint64_t i = head; i != tail; ++i) {
+    f(&ring->entries[i & ring->mask], env);
+  }
+  sync_store(&ring->head, tail, SYNC_RELEASE);
+  return tail - head;
+}
@@ -0,0 +1,87 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_INSTRUMENTATION_TRACE_RING_H
+#define LIBHPX_INSTRUMENTATION_TRACE_RING_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <hpx/attributes.h>
+#include <libhpx/padding.h>
+
+/// The maximum number of values (including the timestamp) in a trace entry.
+#define TRACE_RING_FIELDS 7
+
+/// A single traced event, sized to fill a cacheline.
+typedef struct {
+  uint16_t       id;                    //!< the event id
+  uint16_t        n;                    //!< the number of valid fields
+  int32_t    worker;                    //!< the worker that traced it
+  uint64_t   fields[TRACE_RING_FIELDS]; //!< timestamp, then the user values
+} trace_entry_t;
+
+/// A bounded single-producer, single-consumer ring of trace entries.
+///
+/// Each worker owns one ring that only it appends to, so tracing an event
+/// touches no shared cachelines except when the ring's consumer (the trace
+/// writer) has advanced the head. The producer and consumer indices are
+/// free-running and live on separate cachelines.
+///
+/// When the ring is full the producer either drops the event and counts it,
+/// or, if the ring was created with back-pressure enabled, spins until the
+/// writer makes room.
+typedef struct {
+  volatile uint64_t head;               //!< next entry to consume
+  PAD_TO_CACHELINE(sizeof(uint64_t));
+  volatile uint64_t tail;               //!< next entry to produce
+  volatile uint64_t dropped;            //!< events dropped when full
+  uint64_t     mask;                    //!< capacity - 1
+  bool backpressure;                    //!< block rather than drop
+  PAD_TO_CACHELINE(3 * sizeof(uint64_t) + sizeof(bool));
+  trace_entry_t entries[];
+} trace_ring_t;
+
+/// Allocate a ring.
+///
+/// @param     capacity The minimum number of entries, rounded up to a power
+///                     of 2.
+/// @param backpressure True if producers should wait when the ring is full.
+trace_ring_t *trace_ring_new(uint32_t capacity, bool backpressure);
+
+/// Free a ring.
+void trace_ring_delete(trace_ring_t *ring);
+
+/// Append an event to a ring. This must only be called by the ring's producer.
+///
+/// @param         ring The ring.
+/// @param       worker The id of the tracing worker.
+/// @param           id The event id.
+/// @param            n The number of values in @p args.
+/// @param         args The values to record.
+void trace_ring_vappend(trace_ring_t *ring, int worker, int id, int n,
+                        va_list *args)
+  HPX_NON_NULL(1);
+
+/// Consume all of the available entries in a ring.
+///
+/// @param         ring The ring.
+/// @param            f The function to call for each entry, in order.
+/// @param          env The environment for @p f.
+///
+/// @returns            The number of entries consumed.
+size_t trace_ring_drain(trace_ring_t *ring,
+                        void (*f)(const trace_entry_t *, void *), void *env)
+  HPX_NON_NULL(1, 2);
+
+#endif // LIBHPX_INSTRUMENTATION_TRACE_RING_H
@@ -16,8 +16,14 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <libhpx/config.h>
 #include <libhpx/debug.h>
+#include <libhpx/locality.h>
 #include <libhpx/memory.h>
+#include <libhpx/topology.h>
+#include <libhpx/worker.h>
+#include <libsync/locks.h>
 
 const char *je_malloc_conf = "lg_chunk:22";
 
@@ -30,6 +36,64 @@ __thread int as_flags[AS_COUNT] = {0};
 static const chunk_hooks_t *_hooks[AS_COUNT] = {NULL};
 /// @}
 
+/// When a first-touch or partitioned NUMA heap policy is selected, the workers
+/// on each NUMA node share one arena for the registered and global address
+/// spaces, so that the chunks backing an arena are only touched (or bound) on
+/// its node. These arrays map NUMA nodes to arenas, 0 means no arena yet.
+/// @{
+static unsigned *_numa_arenas[AS_COUNT] = {NULL};
+static tatas_lock_t _numa_lock = SYNC_TATAS_LOCK_INIT;
+/// @}
+
+/// Check if an address space uses per-NUMA node arenas.
+static bool _numa_arenas_enabled(int id) {
+  if (id != AS_REGISTERED && id != AS_GLOBAL) {
+    return false;
+  }
+  if (!here || !here->config || !here->topology) {
+    return false;
+  }
+  libhpx_heap_numa_t policy = here->config->heap_numa;
+  return (policy == HPX_HEAP_NUMA_FIRSTTOUCH ||
+          policy == HPX_HEAP_NUMA_PARTITION);
+}
+
+/// Create a new arena that uses the given hooks.
+static unsigned _new_arena(const chunk_hooks_t *hooks) {
+  unsigned arena;
+  size_t sz = sizeof(arena);
+  dbg_check( je_mallctl("arenas.extend", &arena, &sz, NULL, 0) );
+
+  char path[128];
+  snprintf(path, 128, "arena.%u.chunk_hooks", arena);
+  dbg_check( je_mallctl(path, NULL, NULL, (void*)hooks, sizeof(*hooks)) );
+
+  // // Disable dirty page purging for this arena
+  // snprintf(path, 124, "arena.%u.lg_dirty_mult", arena);
+  // ssize_t i = -1;
+  // dbg_check( je_mallctl(path, NULL, NULL, (void*)&i, sizeof(i)) );
+  return arena;
+}
+
+/// Get the shared arena for an address space on a NUMA node, creating it if
+/// this is the first thread on the node to join.
+static unsigned _numa_arena(int id, int node, const chunk_hooks_t *hooks) {
+  sync_tatas_acquire(&_numa_lock);
+  if (!_numa_arenas[id]) {
+    _numa_arenas[id] = calloc(here->topology->nnodes, sizeof(unsigned));
+    dbg_assert(_numa_arenas[id]);
+  }
+  unsigned arena = _numa_arenas[id][node];
+  if (!arena) {
+    arena = _new_arena(hooks);
+    _numa_arenas[id][node] = arena;
+    log_gas("created arena %u for address space %d on NUMA node %d\n",
+            arena, id, node);
+  }
+  sync_tatas_release(&_numa_lock);
+  return arena;
+}
+
 void as_set_allocator(int id, const chunk_hooks_t *hooks) {
   dbg_assert(0 <= id && id < AS_COUNT);
   dbg_assert(hooks);
@@ -54,23 +118,20 @@ void as_join(int id) {
     return;
   }
 
-  // Create an arena that uses the right hooks.
+  // Create an arena that uses the right hooks, or share the arena for our NUMA
+  // node if that is the policy.
+  worker_t *w = self;
   unsigned arena;
-  size_t sz = sizeof(arena);
-  dbg_check( je_mallctl("arenas.extend", &arena, &sz, NULL, 0) );
-
-  char path[128];
-  snprintf(path, 128, "arena.%u.chunk_hooks", arena);
-  dbg_check( je_mallctl(path, NULL, NULL, (void*)hooks, sizeof(*hooks)) );
-
-  // // Disable dirty page purging for this arena
-  // snprintf(path, 124, "arena.%u.lg_dirty_mult", arena);
-  // ssize_t i = -1;
-  // dbg_check( je_mallctl(path, NULL, NULL, (void*)&i, sizeof(i)) );
+  if (w && _numa_arenas_enabled(id)) {
+    arena = _numa_arena(id, w->numa_node, hooks);
+  }
+  else {
+    arena = _new_arena(hooks);
+  }
 
   // Create a cache.
   unsigned cache;
-  sz = sizeof(cache);
+  size_t sz = sizeof(cache);
   dbg_check( je_mallctl("tcache.create", &cache, &sz, NULL, 0) );
 
   // And set the flags.
@@ -80,6 +141,38 @@ void as_join(int id) {
 void as_leave(void) {
 }
 
+int as_arena_numa_node(unsigned arena) {
+  for (int id = 0; id < AS_COUNT; ++id) {
+    const unsigned *arenas = sync_load(&_numa_arenas[id], SYNC_ACQUIRE);
+    for (int i = 0, e = (arenas) ? here->topology->nnodes : 0; i < e; ++i) {
+      if (arenas[i] == arena) {
+        return i;
+      }
+    }
+  }
+  return -1;
+}
+
+void as_chunk_place(void *chunk, size_t n, unsigned arena) {
+  if (!here || !here->config || !here->topology) {
+    return;
+  }
+
+  libhpx_heap_numa_t policy = here->config->heap_numa;
+  if (policy == HPX_HEAP_NUMA_DEFAULT) {
+    return;
+  }
+
+  int node = as_arena_numa_node(arena);
+  if (policy == HPX_HEAP_NUMA_PARTITION && node < 0) {
+    return;
+  }
+
+  if (topology_set_membind(here->topology, chunk, n, policy, node)) {
+    log_gas("could not place chunk %p in arena %u\n", chunk, arena);
+  }
+}
+
 size_t as_bytes_per_chunk(void) {
   size_t log2_bytes_per_chunk = 0;
   size_t sz = sizeof(log2_bytes_per_chunk);
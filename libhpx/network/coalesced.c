@@ -27,6 +27,8 @@
 #include <libhpx/libhpx.h>
 #include <libhpx/network.h>
 #include <libhpx/parcel.h>
+#include <libhpx/worker.h>
+#include "coalesced.h"
 
 typedef struct {
   network_t          vtable;
@@ -52,25 +54,46 @@ static void _coalesced_network_delete(void *obj) {
   free(obj);
 }
 
-/// Demultiplex coalesced parcels on the receiver side.
-///
-/// @param       buffer The buffer of coalesced parcels.
-/// @param            n The number of coalesced bytes.
-static int _demux_handler(char* buffer, int n) {
-  // retrieve the next parcel from the fat parcel
+void coalesced_demux(const void *buffer, size_t n) {
+  // Clone all of the parcels before we launch any of them, since the buffer
+  // might be reused by the parcels that we launch.
+  const char *next = buffer;
+  hpx_parcel_t *chain = NULL;
   while (n) {
-    hpx_parcel_t *p = parcel_clone((void*)buffer);
+    hpx_parcel_t *p = parcel_clone((const void*)next);
     size_t bytes = parcel_size(p);
-    buffer += bytes;
+    dbg_assert(bytes <= n);
+    next += bytes;
     n -= bytes;
-    dbg_assert(n >= 0);
+    parcel_stack_push(&chain, p);
+  }
+
+  hpx_parcel_t *p = NULL;
+  while ((p = parcel_stack_pop(&chain))) {
     parcel_launch(p);
   }
+}
+
+/// Demultiplex coalesced parcels on the receiver side.
+///
+/// @param       buffer The buffer of coalesced parcels.
+/// @param            n The number of coalesced bytes.
+static int _demux_handler(char* buffer, int n) {
+  coalesced_demux(buffer, n);
   return HPX_SUCCESS;
 }
 static LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _demux, _demux_handler,
                      HPX_POINTER, HPX_INT);
 
+/// Batches that contain compressed parcels are compressed as a whole by the
+/// compressed network, which is where small parcels actually compress well.
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED | HPX_COMPRESSED,
+                     _demux_compressed, _demux_handler, HPX_POINTER, HPX_INT);
+
+bool coalesced_is_batch(const hpx_parcel_t *p) {
+  return (p->action == _demux || p->action == _demux_compressed);
+}
+
 /// Send parcels from the coalesced network.
 static void _send_n(_coalesced_network_t *network, int n) {
   // 0) Allocate temporary storage.
@@ -78,6 +101,7 @@ static void _send_n(_coalesced_network_t *network, int n) {
     hpx_parcel_t *fatp;
     char         *next;
     int        n_bytes;
+    int     compressed;
   } *locs = calloc(HPX_LOCALITIES, sizeof(*locs));
 
   // 1) We'll pull n parcels off the global send queue, and store them
@@ -91,6 +115,7 @@ static void _send_n(_coalesced_network_t *network, int n) {
     size_t bytes = parcel_size(p);
     uint32_t   l = gas_owner_of(gas, p->target);
     locs[l].n_bytes += bytes;
+    locs[l].compressed |= action_is_compressed(p->action);
     parcel_stack_push(&chain, p);
   }
 
@@ -99,7 +124,8 @@ static void _send_n(_coalesced_network_t *network, int n) {
   for (int l = 0, e = HPX_LOCALITIES; l < e; ++l) {
     int n = locs[l].n_bytes;
     if (n) {
-      locs[l].fatp = action_new_parcel(_demux, HPX_THERE(l), 0, 0, 2, NULL, n);
+      hpx_action_t demux = (locs[l].compressed) ? _demux_compressed : _demux;
+      locs[l].fatp = action_new_parcel(demux, HPX_THERE(l), 0, 0, 2, NULL, n);
       locs[l].next = hpx_parcel_get_data(locs[l].fatp);
     }
   }
@@ -116,6 +142,7 @@ static void _send_n(_coalesced_network_t *network, int n) {
   // 4) Send the fat parcel to each target.
   for (int l = 0, e = HPX_LOCALITIES; l < e; ++l) {
     if (locs[l].fatp) {
+      STATS_ADD(coalesced, 1);
       network_send(network->next, locs[l].fatp);
     }
   }
@@ -14,6 +14,8 @@
 #ifndef LIBHPX_NETWORK_COALESCED_H
 #define LIBHPX_NETWORK_COALESCED_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <hpx/attributes.h>
 #include <libhpx/network.h>
 
@@ -25,4 +27,17 @@ struct config;
 network_t* coalesced_network_new (network_t *network, const struct config *cfg)
   HPX_MALLOC;
 
+/// Check to see if a parcel is a batch of coalesced parcels.
+bool coalesced_is_batch(const hpx_parcel_t *p)
+  HPX_NON_NULL(1);
+
+/// Launch the parcels in a batch of coalesced parcels.
+///
+/// The parcels are copied out of the batch, so @p buffer can be reused as
+/// soon as this returns.
+///
+/// @param       buffer The serialized parcels.
+/// @param            n The number of bytes in @p buffer.
+void coalesced_demux(const void *buffer, size_t n);
+
 #endif // LIBHPX_NETWORK_COALESCED_H
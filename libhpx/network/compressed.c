@@ -15,6 +15,8 @@
 # include "config.h"
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <libsync/queues.h>
@@ -25,18 +27,51 @@
 #include <libhpx/debug.h>
 #include <libhpx/gas.h>
 #include <libhpx/libhpx.h>
+#include <libhpx/locality.h>
 #include <libhpx/memory.h>
 #include <libhpx/network.h>
 #include <libhpx/parcel.h>
+#include <libhpx/stats.h>
+#include <libhpx/worker.h>
 #include <lz4.h>
+#include "coalesced.h"
 
-// TODO:
-// 1. in-place compression and decompression.
-// 2. compression and coalescing.
+/// Compressed parcels carry this header in front of the compressed bytes.
+typedef struct {
+  uint32_t bytes;                               //!< the uncompressed size
+  uint32_t batch;                               //!< is it a coalesced batch
+} _header_t;
+
+/// A per-worker scratch buffer, which we compress into and decompress
+/// coalesced batches into so that we don't need to allocate for each parcel.
+typedef struct {
+  size_t bytes;
+  char buffer[];
+} _scratch_t;
+
+/// The number of entries in the compression sample table.
+#define _SAMPLES 1024
+
+/// A compression sample for an action and destination pair.
+///
+/// The table is shared by all of the workers and updated without
+/// synchronization. A racy update can only perturb the heuristic, since each
+/// parcel is still compressed (or not) as a unit.
+typedef struct {
+  uint64_t    key;                   //!< (action << 32) | rank, plus one
+  uint32_t  ratio;                   //!< average compressed size per 1024
+  uint32_t   skip;                   //!< parcels to skip before reprobing
+} _sample_t;
 
 typedef struct {
   network_t          vtable;
   network_t           *impl;
+  uint32_t        threshold;         //!< worthwhile compressed size per 1024
+  uint32_t            probe;         //!< parcels skipped before reprobing
+  uint32_t        bandwidth;         //!< link bandwidth in MB/s (bytes/us)
+  size_t          largesize;         //!< parcels that use the faster level
+  int                 accel;         //!< the faster level
+  _sample_t samples[_SAMPLES];
 } _compressed_network_t;
 
 static void _compressed_network_delete(void *obj) {
@@ -45,17 +80,61 @@ static void _compressed_network_delete(void *obj) {
   free(obj);
 }
 
+/// Get a scratch buffer of at least @p bytes.
+///
+/// Workers reuse their scratch buffer, other threads get a temporary buffer
+/// that must be released with _scratch_release().
+static char *_scratch(size_t bytes) {
+  worker_t *w = self;
+  _scratch_t *scratch = (w) ? w->compress : NULL;
+  if (!scratch || scratch->bytes < bytes) {
+    free(scratch);
+    scratch = malloc(sizeof(*scratch) + bytes);
+    dbg_assert(scratch);
+    scratch->bytes = bytes;
+    if (w) {
+      w->compress = scratch;
+    }
+  }
+  return scratch->buffer;
+}
+
+/// Release a scratch buffer from _scratch().
+static void _scratch_release(char *buffer) {
+  worker_t *w = self;
+  if (!w) {
+    free(buffer - offsetof(_scratch_t, buffer));
+  }
+}
+
 /// Decompress parcels on the receiver side.
 ///
+/// Coalesced batches are decompressed into scratch space and launched
+/// directly from there, other parcels are decompressed directly into a new
+/// parcel.
+///
 /// @param       buffer The compressed parcel.
 /// @param            n The size of @p buffer.
 static int _decompress_handler(char* buffer, int n) {
-  // retrieve the original size from the payload.
-  size_t size = *(size_t*)buffer;
-  hpx_parcel_t *p = as_memalign(AS_REGISTERED, HPX_CACHELINE_SIZE, size);
-  buffer += sizeof(size_t);
-  size_t osize = LZ4_decompress_fast(buffer, (char*)p, size);
-  dbg_assert(osize == n);
+  const _header_t *header = (const void*)buffer;
+  const char *data = buffer + sizeof(*header);
+  int size = n - sizeof(*header);
+
+  if (header->batch) {
+    char *batch = _scratch(header->bytes);
+    int osize = LZ4_decompress_safe(data, batch, size, header->bytes);
+    dbg_assert(osize == header->bytes);
+    const hpx_parcel_t *p = (const void*)batch;
+    coalesced_demux(batch + sizeof(*p), p->size);
+    _scratch_release(batch);
+    return HPX_SUCCESS;
+  }
+
+  hpx_parcel_t *p = as_memalign(AS_REGISTERED, HPX_CACHELINE_SIZE,
+                                header->bytes);
+  int osize = LZ4_decompress_safe(data, (char*)p, size, header->bytes);
+  dbg_assert(osize == header->bytes);
+  (void)osize;
 
   p->ustack = NULL;
   p->next = NULL;
@@ -66,36 +145,110 @@ static int _decompress_handler(char* buffer, int n) {
 static LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _decompress, _decompress_handler,
                      HPX_POINTER, HPX_INT);
 
+/// Find the sample for a parcel's action and destination.
+///
+/// The table is direct mapped, a colliding pair simply evicts the current
+/// sample and starts over.
+static _sample_t *_sample(_compressed_network_t *network,
+                          const hpx_parcel_t *p) {
+  uint64_t rank = gas_owner_of(here->gas, p->target);
+  uint64_t key = (((uint64_t)p->action << 32) | rank) + 1;
+  uint64_t i = (key * UINT64_C(0x9E3779B97F4A7C15)) >> 32;
+  _sample_t *sample = &network->samples[i % _SAMPLES];
+  if (sample->key != key) {
+    sample->key = key;
+    sample->ratio = 0;
+    sample->skip = 0;
+  }
+  return sample;
+}
+
+/// Update a sample with the result of compressing a parcel.
+///
+/// The ratio is a running average over the parcels that we compressed. If it
+/// rises above the threshold, or if the compression took longer than the
+/// estimated time it saves on the link, we stop compressing for this action
+/// and destination for a while. The average restarts at the next probe so
+/// that a change in the data is noticed immediately.
+///
+/// @param      network The compressed network.
+/// @param       sample The sample to update.
+/// @param        isize The uncompressed size.
+/// @param        osize The compressed size (0 if compression failed).
+/// @param           ns The time spent compressing (0 if not measured).
+///
+/// @returns            true if the compressed parcel should be sent.
+static bool _sample_update(_compressed_network_t *network, _sample_t *sample,
+                           size_t isize, size_t osize, uint64_t ns) {
+  uint32_t ratio = (osize && osize < isize) ? (osize << 10) / isize : 1024;
+  if (sample->ratio) {
+    ratio = (3 * sample->ratio + ratio) >> 2;
+  }
+  sample->ratio = ratio;
+
+  bool pays = (ratio <= network->threshold);
+  if (pays && network->bandwidth) {
+    uint64_t saved = (osize < isize) ? isize - osize : 0;
+    pays = (ns < saved * 1000 / network->bandwidth);
+  }
+
+  if (!pays) {
+    sample->ratio = 0;
+    sample->skip = network->probe;
+  }
+  return pays;
+}
+
 static int _compressed_network_send(void *obj, hpx_parcel_t *p) {
   _compressed_network_t *network = obj;
   if (!action_is_compressed(p->action)) {
     return network_send(network->impl, p);
   }
 
-  // allocate a new enclosing parcel
-  size_t isize = parcel_size(p);
-  size_t bytes = LZ4_compressBound(isize) + sizeof(size_t);
+  // skip compression for action and destination pairs where it hasn't been
+  // paying off
+  //
+  // NB: samples are shared by all senders without synchronization, so we read
+  //     the skip count once, concurrent updates may lose a decrement, which
+  //     only delays the next probe
+  _sample_t *sample = _sample(network, p);
+  uint32_t skip = sync_load(&sample->skip, SYNC_RELAXED);
+  if (skip) {
+    sync_store(&sample->skip, skip - 1, SYNC_RELAXED);
+    STATS_ADD(compress_skips, 1);
+    return network_send(network->impl, p);
+  }
 
-  hpx_parcel_t *cp = parcel_new(p->target, _decompress, 0, 0,
-                                p->pid, 0, bytes);
-  dbg_assert(cp);
+  // compress the original parcel into scratch space, large parcels use the
+  // faster level
+  size_t isize = parcel_size(p);
+  size_t bound = LZ4_compressBound(isize);
+  int accel = (isize < network->largesize) ? 1 : network->accel;
+  char *scratch = _scratch(bound);
+  hpx_time_t start = (network->bandwidth) ? hpx_time_now() : HPX_TIME_NULL;
+  int osize = LZ4_compress_fast((const char*)p, scratch, isize, bound, accel);
+  uint64_t ns = (network->bandwidth) ? hpx_time_elapsed_ns(start) : 0;
 
-  // the original size is stored in the payload since we need it
-  // during decompression.
-  char *data = hpx_parcel_get_data(cp);
-  *(size_t*)data = isize;
-  data += sizeof(size_t);
-
-  // compress the original parcel
-  size_t osize = LZ4_compress_fast((const char*)p, data, isize, bytes, 1);
-  // if compression fails, send the original parcel
-  if (!osize) {
-    parcel_delete(cp);
-    cp = p;
-  } else {
-    parcel_delete(p);
-    cp->size = osize + sizeof(size_t);
+  // if compression fails, doesn't make the parcel smaller, or doesn't pay
+  // off, send the original parcel
+  size_t bytes = sizeof(_header_t) + osize;
+  bool pays = _sample_update(network, sample, isize, osize, ns);
+  if (!pays || !osize || sizeof(*p) + bytes >= isize) {
+    _scratch_release(scratch);
+    return network_send(network->impl, p);
   }
+
+  // otherwise allocate a right-sized enclosing parcel, the original size is
+  // stored in the header since we need it during decompression.
+  hpx_parcel_t *cp = parcel_new(p->target, _decompress, 0, 0, p->pid, 0, bytes);
+  dbg_assert(cp);
+  _header_t *header = hpx_parcel_get_data(cp);
+  header->bytes = isize;
+  header->batch = coalesced_is_batch(p);
+  memcpy(header + 1, scratch, osize);
+  _scratch_release(scratch);
+  parcel_delete(p);
+  STATS_ADD(compressed, 1);
   return network_send(network->impl, cp);
 }
 
@@ -137,9 +290,10 @@ static int _compressed_network_lco_get(void *obj, hpx_addr_t lco, size_t n,
   return network_lco_get(network->impl, lco, n, out, reset);
 }
 
-network_t* compressed_network_new(network_t *impl) {
+network_t* compressed_network_new(network_t *impl, const config_t *cfg) {
   dbg_assert(impl);
-  _compressed_network_t *network = malloc(sizeof(*network));
+  _compressed_network_t *network = calloc(1, sizeof(*network));
+  dbg_assert(network);
 
   network->vtable.string       = impl->string;
   network->vtable.type         = impl->type;
@@ -154,7 +308,17 @@ network_t* compressed_network_new(network_t *impl) {
   network->vtable.lco_wait     = _compressed_network_lco_wait;
 
   network->impl = impl;
+  network->threshold = (cfg->parcel_compression_threshold << 10) / 100;
+  network->probe = (cfg->parcel_compression_probe > 0) ?
+                   cfg->parcel_compression_probe : 0;
+  network->bandwidth = (cfg->parcel_compression_bandwidth > 0) ?
+                       cfg->parcel_compression_bandwidth : 0;
+  network->largesize = cfg->parcel_compression_largesize;
+  network->accel = (cfg->parcel_compression_accel > 1) ?
+                   cfg->parcel_compression_accel : 1;
 
-  log_net("Enabled parcel compression.\n");
+  log_net("Enabled parcel compression (threshold %d%%, accel %d for %zu+).\n",
+          cfg->parcel_compression_threshold, network->accel,
+          network->largesize);
   return &network->vtable;
 }
@@ -23,7 +23,15 @@ struct config;
 /// @}
 
 
-network_t* compressed_network_new (network_t *network)
+/// Create a network that compresses parcels for HPX_COMPRESSED actions.
+///
+/// Compression is adaptive. The network samples the compression ratio for
+/// each action and destination, and stops compressing for pairs where it
+/// doesn't pay off, probing again periodically.
+///
+/// @param      network The network to send the (compressed) parcels through.
+/// @param          cfg The configuration with the compression parameters.
+network_t* compressed_network_new (network_t *network, const struct config *cfg)
   HPX_MALLOC;
 
 #endif // LIBHPX_NETWORK_COMPRESSED_H
@@ -17,6 +17,7 @@
 
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
 #include <hpx/builtins.h>
 #include <libsync/queues.h>
 
@@ -123,9 +124,25 @@ static int _funneled_coll_sync(void *network, hpx_parcel_t *in, void* out, coll_
 
   while (!sync_swap(&isir->progress_lock, 0, SYNC_ACQUIRE))
     ;
-  if(c->type == ALL_REDUCE) {
+  switch (c->type) {
+   case ALL_REDUCE:
     isir->xport->allreduce(sendbuf, out, count, NULL, &c->op, comm);
-  } else {
+    break;
+   case ALL_GATHER:
+    isir->xport->allgather(sendbuf, out, count, comm);
+    break;
+   case ALL_TO_ALL:
+    isir->xport->alltoall(sendbuf, out, count / c->group_sz, comm);
+    break;
+   case BROADCAST:
+    memcpy(out, sendbuf, count);
+    isir->xport->bcast(out, count, c->root, comm);
+    break;
+   case REDUCE_SCATTER:
+    isir->xport->reduce_scatter(sendbuf, out, count / c->group_sz, NULL,
+                                &c->op, comm);
+    break;
+   default:
     log_dflt("Collective type descriptor : %d is Invalid! \n", c->type);
   }
   sync_store(&isir->progress_lock, 1, SYNC_RELEASE);
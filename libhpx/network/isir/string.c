@@ -15,7 +15,9 @@
 # include "config.h"
 #endif
 
+#include <stdlib.h>
 #include <string.h>
+#include <libsync/sync.h>
 #include <libhpx/action.h>
 #include <libhpx/debug.h>
 #include <libhpx/parcel.h>
@@ -218,6 +220,190 @@ static int _isir_memcpy_sync(void *obj, hpx_addr_t to, hpx_addr_t from,
   return action_call_rsync(_isir_memcpy_request, from, NULL, 0, 2, &n, &to);
 }
 
+/// The vectored operations.
+///
+/// Each region is satisfied by a single parcel, like the scalar operations,
+/// but rather than attaching an LCO to each parcel we count completions in a
+/// local countdown that sets the user's LCO once. The countdown is only ever
+/// touched at the rank that allocated it.
+/// @{
+typedef struct {
+  volatile int remaining;
+  hpx_addr_t         lco;
+} _isir_countdown_t;
+
+static _isir_countdown_t *_isir_countdown_new(int n, hpx_addr_t lco) {
+  _isir_countdown_t *c = malloc(sizeof(*c));
+  dbg_assert(c);
+  c->remaining = n;
+  c->lco = lco;
+  return c;
+}
+
+static void _isir_countdown_signal(_isir_countdown_t *c) {
+  if (sync_addf(&c->remaining, -1, SYNC_ACQ_REL) == 0) {
+    hpx_lco_set(c->lco, 0, NULL, HPX_NULL, HPX_NULL);
+    free(c);
+  }
+}
+
+/// Count the regions that actually need to move data.
+static int _isir_count_vec(const hpx_gas_iovec_t *iov, int n) {
+  int k = 0;
+  for (int i = 0; i < n; ++i) {
+    k += (iov[i].size != 0);
+  }
+  return k;
+}
+
+typedef struct {
+  void             *to;
+  _isir_countdown_t *c;
+  char           from[];
+} _isir_memget_vec_reply_args_t;
+
+/// This handler implements the vectored memget reply operation.
+///
+/// @param         args The marshaled argument type.
+/// @param            n The size of the arguments.
+///
+/// @returns            HPX_SUCCESS
+static int
+_isir_memget_vec_reply_handler(_isir_memget_vec_reply_args_t *args, size_t n) {
+  memcpy(args->to, args->from, n - sizeof(*args));
+  _isir_countdown_signal(args->c);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _isir_memget_vec_reply,
+                     _isir_memget_vec_reply_handler, HPX_POINTER, HPX_SIZE_T);
+
+/// This handler satisfies the vectored memget request operation.
+///
+/// @param         from The pinned buffer we are copying out of.
+/// @param           to The local virtual address we're copying back to.
+/// @param            n The number of bytes to copy.
+/// @param            c The countdown at the source.
+///
+/// @returns            HPX_SUCCESS
+static int _isir_memget_vec_request_handler(const void *from, void *to,
+                                            size_t n, _isir_countdown_t *c) {
+  hpx_parcel_t *current = self->current;
+  size_t          bytes = sizeof(_isir_memget_vec_reply_args_t) + n;
+  hpx_addr_t     target = HPX_THERE(current->src);
+  hpx_action_t       op = _isir_memget_vec_reply;
+  hpx_pid_t         pid = current->pid;
+
+  hpx_parcel_t *p = parcel_new(target, op, 0, 0, pid, NULL, bytes);
+  _isir_memget_vec_reply_args_t *args = hpx_parcel_get_data(p);
+  args->to = to;
+  args->c = c;
+  memcpy(args->from, from, n);
+  parcel_launch(p);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_PINNED, _isir_memget_vec_request,
+                     _isir_memget_vec_request_handler, HPX_POINTER, HPX_POINTER,
+                     HPX_SIZE_T, HPX_POINTER);
+
+static int _isir_memget_vec(void *obj, const hpx_gas_iovec_t *iov, int n,
+                            hpx_addr_t lsync) {
+  int k = _isir_count_vec(iov, n);
+  if (!k) {
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
+  hpx_action_t op = _isir_memget_vec_request;
+  _isir_countdown_t *c = _isir_countdown_new(k, lsync);
+  for (int i = 0; i < n; ++i) {
+    if (iov[i].size) {
+      hpx_addr_t from = iov[i].global;
+      void *to = iov[i].local;
+      size_t size = iov[i].size;
+      hpx_parcel_t *p = action_new_parcel(op, from, 0, 0, 3, &to, &size, &c);
+      parcel_launch(p);
+    }
+  }
+  return HPX_SUCCESS;
+}
+
+typedef struct {
+  _isir_countdown_t *c;
+  char           from[];
+} _isir_memput_vec_args_t;
+
+/// The vectored memput completion handler, run at the source.
+///
+/// @param            c The marshaled countdown pointer.
+/// @param            n The size of the arguments.
+///
+/// @returns            HPX_SUCCESS
+static int _isir_memput_vec_reply_handler(_isir_countdown_t **c, size_t n) {
+  _isir_countdown_signal(*c);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _isir_memput_vec_reply,
+                     _isir_memput_vec_reply_handler, HPX_POINTER, HPX_SIZE_T);
+
+/// The vectored memput handler.
+///
+/// This copies the passed buffer to the target address, and continues the
+/// countdown pointer back to the source if it needs to know about remote
+/// completion.
+///
+/// @param           to The pinned target buffer to copy into.
+/// @param         args The marshaled countdown and data.
+/// @param            n The size of the arguments.
+///
+/// @returns            HPX_SUCCESS
+static int _isir_memput_vec_request_handler(void *to,
+                                            _isir_memput_vec_args_t *args,
+                                            size_t n) {
+  memcpy(to, args->from, n - sizeof(*args));
+  if (args->c) {
+    return hpx_thread_continue(&args->c, sizeof(args->c));
+  }
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED,
+                     _isir_memput_vec_request, _isir_memput_vec_request_handler,
+                     HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+
+/// The vectored memput operation.
+///
+/// The data is copied into the request parcels, so we can signal the @p lsync
+/// LCO as soon as they have all been created.
+static int _isir_memput_vec(void *obj, const hpx_gas_iovec_t *iov, int n,
+                            hpx_addr_t lsync, hpx_addr_t rsync) {
+  int k = _isir_count_vec(iov, n);
+  if (!k) {
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
+  hpx_action_t   op = _isir_memput_vec_request;
+  hpx_action_t  rop = (rsync) ? _isir_memput_vec_reply : 0;
+  hpx_addr_t    src = (rsync) ? HPX_HERE : HPX_NULL;
+  hpx_pid_t     pid = hpx_thread_current_pid();
+  _isir_countdown_t *c = (rsync) ? _isir_countdown_new(k, rsync) : NULL;
+  for (int i = 0; i < n; ++i) {
+    if (iov[i].size) {
+      size_t bytes = sizeof(_isir_memput_vec_args_t) + iov[i].size;
+      hpx_parcel_t *p = parcel_new(iov[i].global, op, src, rop, pid, NULL,
+                                   bytes);
+      _isir_memput_vec_args_t *args = hpx_parcel_get_data(p);
+      args->c = c;
+      memcpy(args->from, iov[i].local, iov[i].size);
+      parcel_launch(p);
+    }
+  }
+
+  hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+  return HPX_SUCCESS;
+}
+/// @}
+
 const class_string_t isir_string_vtable = {
   .memget       = _isir_memget,
   .memget_rsync = _isir_memget_rsync,
@@ -226,5 +412,7 @@ const class_string_t isir_string_vtable = {
   .memput_lsync = _isir_memput_lsync,
   .memput_rsync = _isir_memput_rsync,
   .memcpy       = _isir_memcpy,
-  .memcpy_sync  = _isir_memcpy_sync
+  .memcpy_sync  = _isir_memcpy_sync,
+  .memget_vec   = _isir_memget_vec,
+  .memput_vec   = _isir_memput_vec
 };
@@ -36,6 +36,10 @@ typedef struct isir_xport {
   void   (*finish)(void *request, int *src, int *bytes);
   void   (*create_comm)(void *comm, void* active_ranks, int num_active, int total);
   void   (*allreduce)(void *sendbuf, void* out, int count, void* datatype, void* op, void* comm);
+  void   (*reduce_scatter)(void *sendbuf, void* out, int count, void* datatype, void* op, void* comm);
+  void   (*allgather)(void *sendbuf, void* out, int count, void* comm);
+  void   (*alltoall)(void *sendbuf, void* out, int count, void* comm);
+  void   (*bcast)(void *buffer, int count, int root, void* comm);
   void   (*testsome)(int n, void *requests, int *cnt, int *out, void *statuses);
   void   (*pin)(const void *base, size_t bytes, void *key);
   void   (*unpin)(const void *base, size_t bytes);
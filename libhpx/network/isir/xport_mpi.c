@@ -198,45 +198,78 @@ static void _mpi_create_comm(void *c, void *active_ranks, int num_active,
   }
 }
 
-typedef struct {
-  hpx_monoid_op_t op;
+/// The monoid operation for the reduction in progress.
+///
+/// MPI user-defined operations don't take a context argument, and a function
+/// pointer sent along with the data is not meaningful at other ranks, so the
+/// operation is passed to the handler here. Collectives are serialized by the
+/// network's progress lock.
+static hpx_monoid_op_t _op;
+
+/// Handle for reduction operations.
+///
+/// MPI will call this function in a collective reduction, with @p len elements
+/// of the contiguous type we created for the value, and we delegate to the
+/// real operation.
+static void _op_handler(void *in, void *inout, int *len, MPI_Datatype *dp) {
   int bytes;
-  char operands[];
-} val_t;
-
-/// handle for reduction operation
-/// MPI will call this function in a colelctive reduction op
-/// and then delegate to the real action
-void op_handler(void *in, void *inout, int *len, MPI_Datatype *dp) {
-  val_t *v = (val_t *)in;
-  val_t *out = (val_t *)inout;
-  v->op(out->operands, v->operands, v->bytes);
+  MPI_Type_size(*dp, &bytes);
+  for (int i = 0, e = *len; i < e; ++i) {
+    _op((char*)inout + i * bytes, (char*)in + i * bytes, bytes);
+  }
+}
+
+/// Run a reduction over values of @p count bytes.
+///
+/// The values are treated as a single element of a contiguous type so that MPI
+/// never splits a value that the monoid operation expects to see whole.
+static void _mpi_reduction(int count, void *op, MPI_Datatype *type,
+                           MPI_Op *mpi_op) {
+  _op = *(hpx_monoid_op_t *)op;
+  MPI_Type_contiguous(count, MPI_BYTE, type);
+  MPI_Type_commit(type);
+  // we assume this function is commutative for now, hence 1
+  MPI_Op_create(_op_handler, 1, mpi_op);
+}
+
+static void _mpi_reduction_fini(MPI_Datatype *type, MPI_Op *mpi_op) {
+  MPI_Op_free(mpi_op);
+  MPI_Type_free(type);
 }
 
 static void _mpi_allreduce(void *sendbuf, void *out, int count, void *datatype,
                            void *op, void *c) {
   MPI_Comm *comm = c;
-  hpx_monoid_op_t *hpx_handle = (hpx_monoid_op_t *)op;
-  int bytes = sizeof(val_t) + count;
-
-  // prepare operands for function
-  char *val = malloc(bytes);
-  char *result = malloc(bytes);
-  val_t *in = (val_t *)val;
-  val_t *res = (val_t *)result;
-  in->op = *hpx_handle;
-  in->bytes = count;
-  memcpy(in->operands, sendbuf, count);
-
-  MPI_Op usrOp;
-  // we assume this function is commutative for now, hence 1
-  MPI_Op_create(op_handler, 1, &usrOp);
+  MPI_Datatype type;
+  MPI_Op mpi_op;
+  _mpi_reduction(count, op, &type, &mpi_op);
+  MPI_Allreduce(sendbuf, out, 1, type, mpi_op, *comm);
+  _mpi_reduction_fini(&type, &mpi_op);
+}
 
-  MPI_Allreduce(val, result, bytes, MPI_BYTE, usrOp, *comm);
-  memcpy(out, res->operands, count);
+static void _mpi_reduce_scatter(void *sendbuf, void *out, int count,
+                                void *datatype, void *op, void *c) {
+  MPI_Comm *comm = c;
+  MPI_Datatype type;
+  MPI_Op mpi_op;
+  _mpi_reduction(count, op, &type, &mpi_op);
+  MPI_Reduce_scatter_block(sendbuf, out, 1, type, mpi_op, *comm);
+  _mpi_reduction_fini(&type, &mpi_op);
+}
+
+static void _mpi_allgather(void *sendbuf, void *out, int count, void *c) {
+  MPI_Comm *comm = c;
+  MPI_Allgather(sendbuf, count, MPI_BYTE, out, count, MPI_BYTE, *comm);
+}
 
-  free(val);
-  free(result);
+static void _mpi_alltoall(void *sendbuf, void *out, int count, void *c) {
+  MPI_Comm *comm = c;
+  MPI_Alltoall(sendbuf, count, MPI_BYTE, out, count, MPI_BYTE, *comm);
+}
+
+static void _mpi_bcast(void *buffer, int count, int root, void *c) {
+  MPI_Comm *comm = c;
+  MPI_Bcast(buffer, count, MPI_BYTE, root, *comm);
 }
 
 isir_xport_t *
@@ -261,6 +294,10 @@ isir_xport_new_mpi(const config_t *cfg, gas_t *gas) {
   xport->unpin          = _mpi_unpin;
   xport->create_comm    = _mpi_create_comm;
   xport->allreduce      = _mpi_allreduce;
+  xport->reduce_scatter = _mpi_reduce_scatter;
+  xport->allgather      = _mpi_allgather;
+  xport->alltoall       = _mpi_alltoall;
+  xport->bcast          = _mpi_bcast;
 
   // local = address_space_new_default(cfg);
   // registered = address_space_new_default(cfg);
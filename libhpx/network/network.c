@@ -109,7 +109,7 @@ network_t *network_new(config_t *cfg, boot_t *boot, struct gas *gas) {
   }
 
   if (cfg->parcel_compression) {
-    network = compressed_network_new(network);
+    network = compressed_network_new(network, cfg);
   }
 
   if (cfg->coalescing_buffersize) {
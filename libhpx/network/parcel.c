@@ -42,6 +42,7 @@
 #include <libhpx/parcel_block.h>
 #include <libhpx/scheduler.h>
 #include <libhpx/topology.h>
+#include <libhpx/worker.h>
 
 // this will only be used during instrumentation
 __thread uint64_t parcel_count = 0;
@@ -140,6 +141,8 @@ void parcel_launch(hpx_parcel_t *p) {
     scheduler_spawn(p);
   }
   else {
+    STATS_ADD(parcels_sent, 1);
+    STATS_ADD(bytes_sent, parcel_size(p));
     int e = network_send(self->network, p);
     dbg_check(e, "failed to perform a network send\n");
   }
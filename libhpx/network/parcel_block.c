@@ -17,6 +17,7 @@
 
 #include <libsync/sync.h>
 #include <hpx/builtins.h>
+#include <libhpx/config.h>
 #include <libhpx/debug.h>
 #include <libhpx/locality.h>
 #include <libhpx/memory.h>
@@ -32,11 +33,18 @@ struct parcel_block {
 
 _HPX_ASSERT(sizeof(parcel_block_t) == HPX_CACHELINE_SIZE, block_header_size);
 
+size_t parcel_block_max_size(const config_t *cfg) {
+  size_t n = cfg->pwc_parcelbuffersize;
+  size_t max = cfg->pwc_parcelbuffermax;
+  return (n < max) ? max : n;
+}
+
 parcel_block_t *parcel_block_new(size_t align, size_t n, size_t *offset) {
-  dbg_assert_str(align == here->config->pwc_parcelbuffersize,
-                 "Parcel block alignment is currently limited to "
-                 "--hpx-pwc-parcelbuffersize (%zu), %zu requested\n",
-                 here->config->pwc_parcelbuffersize, align);
+  dbg_assert_str(align == parcel_block_max_size(here->config),
+                 "Parcel block alignment is currently limited to the largest "
+                 "parcel block size (%zu), %zu requested\n",
+                 parcel_block_max_size(here->config), align);
+  dbg_assert(n <= align);
   size_t bytes = n - sizeof(parcel_block_t);
   dbg_assert(bytes < n);
   parcel_block_t *block = registered_memalign(align, n);
@@ -71,7 +79,7 @@ void parcel_block_deduct(parcel_block_t *block, size_t bytes) {
 }
 
 void parcel_block_delete_parcel(hpx_parcel_t *p) {
-    uintptr_t block_size = here->config->pwc_parcelbuffersize;
+    uintptr_t block_size = parcel_block_max_size(here->config);
     dbg_assert(1lu << ceil_log2_uintptr_t(block_size) == block_size);
     uintptr_t block_mask = ~(block_size - 1);
     parcel_block_t *block = (void*)((uintptr_t)p & block_mask);
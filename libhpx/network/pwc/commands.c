@@ -15,6 +15,8 @@
 # include "config.h"
 #endif
 
+#include <stdlib.h>
+#include <libsync/sync.h>
 #include <libhpx/action.h>
 #include <libhpx/debug.h>
 #include <libhpx/gpa.h>
@@ -52,6 +54,45 @@ void handle_resume_parcel_source(int src, command_t cmd) {
   dbg_check( pwc_cmd(pwc_network, src, (command_t){0}, cmd) );
 }
 
+/// A countdown runs its command when it has been run a number of times.
+typedef struct {
+  volatile int remaining;
+  command_t          cmd;
+} _countdown_t;
+
+command_t command_countdown_new(int n, hpx_addr_t lco) {
+  if (!lco) {
+    return (command_t){ .op = NOP };
+  }
+
+  _countdown_t *c = malloc(sizeof(*c));
+  dbg_assert(c);
+  c->remaining = n;
+  if (gpa_to_rank(lco) == here->rank) {
+    c->cmd = (command_t){ .op = LCO_SET, .arg = lco };
+  }
+  else {
+    hpx_parcel_t *p = action_new_parcel(hpx_lco_set_action, lco, 0, 0, 0);
+    dbg_assert(p);
+    c->cmd = (command_t){ .op = RESUME_PARCEL, .arg = (uintptr_t)p };
+  }
+  return (command_t){ .op = COUNTDOWN, .arg = (uintptr_t)c };
+}
+
+void handle_countdown(int src, command_t cmd) {
+  _countdown_t *c = (_countdown_t *)(uintptr_t)cmd.arg;
+  if (sync_addf(&c->remaining, -1, SYNC_ACQ_REL) == 0) {
+    command_t op = c->cmd;
+    free(c);
+    command_run(here->rank, op);
+  }
+}
+
+void handle_countdown_source(int src, command_t cmd) {
+  cmd.op = COUNTDOWN;
+  dbg_check( pwc_cmd(pwc_network, src, (command_t){0}, cmd) );
+}
+
 static HPX_USED const char *_straction(hpx_action_t id) {
   dbg_assert(here);
   CHECK_ACTION(id);
@@ -71,7 +112,9 @@ void command_run(int src, command_t cmd) {
     handle_recv_parcel,
     handle_rendezvous_launch,
     handle_reload_request,
-    handle_reload_reply
+    handle_reload_reply,
+    handle_countdown,
+    handle_countdown_source
   };
 
   commands[cmd.op](src, cmd);
@@ -19,6 +19,7 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include <hpx/hpx.h>
 
 typedef uint8_t op_t;
 typedef uint64_t arg_t;
@@ -42,6 +43,8 @@ void handle_recv_parcel(int src, command_t cmd);
 void handle_rendezvous_launch(int src, command_t cmd);
 void handle_reload_request(int src, command_t cmd);
 void handle_reload_reply(int src, command_t cmd);
+void handle_countdown(int src, command_t cmd);
+void handle_countdown_source(int src, command_t cmd);
 
 enum {
   NOP = 0,
@@ -54,12 +57,27 @@ enum {
   RENDEZVOUS_LAUNCH,
   RELOAD_REQUEST,
   RELOAD_REPLY,
+  COUNTDOWN,
+  COUNTDOWN_SOURCE,
   COMMAND_COUNT
 };
 
 /// Handle a command.
 void command_run(int src, command_t cmd);
 
+/// Allocate a countdown that sets an LCO.
+///
+/// The returned COUNTDOWN command sets the @p lco once it has been run @p n
+/// times, which lets a set of operations share a single completion LCO. It can
+/// be used as a remote command by changing its op to COUNTDOWN_SOURCE, which
+/// runs the countdown at the rank that allocated it.
+///
+/// @param            n The number of times the command will be run.
+/// @param          lco The LCO to set, may be HPX_NULL.
+///
+/// @returns            The COUNTDOWN command, or a NOP if @p lco is HPX_NULL.
+command_t command_countdown_new(int n, hpx_addr_t lco);
+
 #ifdef __cplusplus
 }
 #endif
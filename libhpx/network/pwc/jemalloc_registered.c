@@ -50,6 +50,9 @@ static void *_registered_chunk_alloc(void *addr, size_t n, size_t align, bool *z
     return NULL;
   }
 
+  // Place the chunk before pinning touches it.
+  as_chunk_place(chunk, n, arena);
+
   // Pin the memory.
   _xport->pin(chunk, n, NULL);
 
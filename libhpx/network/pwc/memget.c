@@ -139,3 +139,30 @@ int pwc_memget_lsync(void *obj, void *to, hpx_addr_t from, size_t size) {
   return HPX_SUCCESS;
 }
 /// @}
+
+/// The vectored memget operation.
+///
+/// We issue one get for each region, and count their local completions with a
+/// single countdown that sets the @p lsync LCO.
+int pwc_memget_vec(void *obj, const hpx_gas_iovec_t *iov, int n,
+                   hpx_addr_t lsync) {
+  int k = 0;
+  for (int i = 0; i < n; ++i) {
+    k += (iov[i].size != 0);
+  }
+
+  if (!k) {
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
+  command_t lcmd = command_countdown_new(k, lsync);
+  command_t rcmd = { 0 };
+  for (int i = 0; i < n; ++i) {
+    if (iov[i].size) {
+      dbg_check( pwc_get(pwc_network, iov[i].local, iov[i].global, iov[i].size,
+                         lcmd, rcmd) );
+    }
+  }
+  return HPX_SUCCESS;
+}
@@ -163,3 +163,37 @@ int pwc_memput_rsync(void *obj, hpx_addr_t to, const void *from, size_t n) {
   return HPX_SUCCESS;
 }
 /// @}
+
+/// The vectored memput operation.
+///
+/// We issue one put for each region. The local completions are counted with a
+/// countdown that sets the @p lsync LCO, and the remote completions are
+/// returned to this rank and counted with a second countdown that sets the
+/// @p rsync LCO.
+int pwc_memput_vec(void *obj, const hpx_gas_iovec_t *iov, int n,
+                   hpx_addr_t lsync, hpx_addr_t rsync) {
+  int k = 0;
+  for (int i = 0; i < n; ++i) {
+    k += (iov[i].size != 0);
+  }
+
+  if (!k) {
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
+  command_t lcmd = command_countdown_new(k, lsync);
+  command_t rcmd = command_countdown_new(k, rsync);
+  if (rcmd.op == COUNTDOWN) {
+    rcmd.op = COUNTDOWN_SOURCE;
+  }
+
+  for (int i = 0; i < n; ++i) {
+    if (iov[i].size) {
+      dbg_check( pwc_put(pwc_network, iov[i].global, iov[i].local, iov[i].size,
+                         lcmd, rcmd) );
+    }
+  }
+  return HPX_SUCCESS;
+}
@@ -27,8 +27,10 @@
 #include <libhpx/libhpx.h>
 #include <libhpx/locality.h>
 #include <libhpx/parcel.h>
+#include <libhpx/parcel_block.h>
 #include "parcel_emulation.h"
 #include "pwc.h"
+#include "regcache.h"
 #include "send_buffer.h"
 #include "xport.h"
 
@@ -93,24 +95,87 @@ static void _pwc_release_dma(void *network, const void* base, size_t n) {
   pwc->xport->unpin(base, n);
 }
 
+/// Initialize a collective group.
+///
+/// The PWC collectives are run through the bootstrap network, which only
+/// supports collectives over every rank.
 static int _pwc_coll_init(void *network, coll_t **_c) {
+  coll_t *c = *_c;
+  if (c->group_sz != here->ranks) {
+    return log_error("PWC collectives require all %u ranks, not %d\n",
+                     here->ranks, c->group_sz);
+  }
   return LIBHPX_OK;
 }
 
+/// Reduce the @p n values of @p bytes bytes in @p values into @p out.
+static void _reduce(void *out, const char *values, int n, int bytes,
+                    hpx_monoid_op_t op) {
+  memcpy(out, values, bytes);
+  for (int i = 1; i < n; ++i) {
+    op(out, values + i * bytes, bytes);
+  }
+}
+
+/// Run a collective using the bootstrap network.
+///
+/// The bootstrap network provides allgather and alltoall, and the reductions
+/// and broadcast are performed locally on the gathered values.
+static int _pwc_coll(const coll_t *c, const void *sendbuf, void *out,
+                     int count) {
+  const boot_t *boot = here->boot;
+  int n = here->ranks;
+  int e = LIBHPX_OK;
+  char *tmp = NULL;
+
+  switch (c->type) {
+   case ALL_REDUCE:
+    tmp = malloc(n * count);
+    dbg_assert(tmp);
+    e = boot_allgather(boot, sendbuf, tmp, count);
+    _reduce(out, tmp, n, count, c->op);
+    break;
+   case ALL_GATHER:
+    e = boot_allgather(boot, sendbuf, out, count);
+    break;
+   case ALL_TO_ALL:
+    e = boot_alltoall(boot, out, sendbuf, count / n, count / n);
+    break;
+   case BROADCAST:
+    tmp = malloc(n * count);
+    dbg_assert(tmp);
+    e = boot_allgather(boot, sendbuf, tmp, count);
+    memcpy(out, tmp + c->root * count, count);
+    break;
+   case REDUCE_SCATTER:
+    tmp = malloc(count);
+    dbg_assert(tmp);
+    e = boot_alltoall(boot, tmp, sendbuf, count / n, count / n);
+    _reduce(out, tmp, n, count / n, c->op);
+    break;
+   default:
+    e = log_error("Collective type descriptor : %d is Invalid! \n", c->type);
+  }
+
+  free(tmp);
+  return e;
+}
+
 int _pwc_coll_sync(void *network, hpx_parcel_t *in, void *out, coll_t *c) {
   void *sendbuf = in->buffer;
   int count = in->size;
-  char *comm = c->data + c->group_bytes;
   pwc_network_t *pwc = network;
 
   // flushing network is necessary (sufficient ?) to execute any packets
   // destined for collective operation
   pwc->vtable.flush(network);
 
-  if (c->type == ALL_REDUCE) {
-    pwc->xport->allreduce(sendbuf, out, count, NULL, &c->op, comm);
-  }
-  return LIBHPX_OK;
+  // the bootstrap network is not thread safe
+  while (!sync_swap(&pwc->coll_lock, 0, SYNC_ACQUIRE))
+    ;
+  int e = _pwc_coll(c, sendbuf, out, count);
+  sync_store(&pwc->coll_lock, 1, SYNC_RELEASE);
+  return e;
 }
 
 static int _pwc_send(void *network, hpx_parcel_t *p) {
@@ -152,6 +217,7 @@ static void _pwc_delete(void *network) {
   _pwc_release_dma(pwc, heap->base, heap->n);
   free(pwc->heap_segments);
   free(pwc->send_buffers);
+  regcache_delete(pwc->regcache);
 
   parcel_emulator_delete(pwc->parcels);
   pwc->xport->dealloc(pwc->xport);
@@ -166,7 +232,9 @@ static const class_string_t _pwc_string_vtable = {
   .memput_lsync = pwc_memput_lsync,
   .memput_rsync = pwc_memput_rsync,
   .memcpy       = pwc_memcpy,
-  .memcpy_sync  = pwc_memcpy_sync
+  .memcpy_sync  = pwc_memcpy_sync,
+  .memget_vec   = pwc_memget_vec,
+  .memput_vec   = pwc_memput_vec
 };
 
 network_t *
@@ -189,6 +257,14 @@ network_pwc_funneled_new(const config_t *cfg, boot_t *boot, gas_t *gas) {
               cfg->pwc_parceleagerlimit, cfg->pwc_parcelbuffersize);
   }
 
+  size_t max = parcel_block_max_size(cfg);
+  if (1lu << ceil_log2_size_t(max) != max ||
+      max % cfg->pwc_parcelbuffersize) {
+    dbg_error(" --hpx-pwc-parcelbuffersize (%zu) and --hpx-pwc-parcelbuffermax "
+              "(%zu) must be powers of two\n", cfg->pwc_parcelbuffersize,
+              cfg->pwc_parcelbuffermax);
+  }
+
   // Allocate the network object and initialize its virtual function table.
   pwc_network_t *pwc;
   int e = posix_memalign((void*)&pwc, HPX_CACHELINE_SIZE, sizeof(*pwc));
@@ -212,6 +288,7 @@ network_pwc_funneled_new(const config_t *cfg, boot_t *boot, gas_t *gas) {
   // Initialize locks.
   sync_store(&pwc->probe_lock, 1, SYNC_RELEASE);
   sync_store(&pwc->progress_lock, 1, SYNC_RELEASE);
+  sync_store(&pwc->coll_lock, 1, SYNC_RELEASE);
 
   // Initialize transports.
   pwc->cfg = cfg;
@@ -219,6 +296,7 @@ network_pwc_funneled_new(const config_t *cfg, boot_t *boot, gas_t *gas) {
   pwc->parcels = parcel_emulator_new_reload(cfg, boot, pwc->xport);
   pwc->send_buffers = calloc(here->ranks, sizeof(send_buffer_t));
   pwc->heap_segments = calloc(here->ranks, sizeof(heap_segment_t));
+  pwc->regcache = regcache_new(pwc->xport, cfg->pwc_regcache);
 
   // Register the gas heap segment.
   heap_segment_t heap = {
@@ -238,7 +316,7 @@ network_pwc_funneled_new(const config_t *cfg, boot_t *boot, gas_t *gas) {
   // Initialize the send buffers.
   for (int i = 0, e = here->ranks; i < e; ++i) {
     send_buffer_t *send = &pwc->send_buffers[i];
-    int rc = send_buffer_init(send, i, pwc->parcels, pwc->xport, 8);
+    int rc = send_buffer_init(send, i, pwc->parcels, pwc->xport);
     dbg_check(rc, "failed to initialize send buffer %d of %u\n", i, e);
   }
 
@@ -248,16 +326,36 @@ network_pwc_funneled_new(const config_t *cfg, boot_t *boot, gas_t *gas) {
   (void)segment;
 }
 
+/// Find the transport key for a local buffer.
+///
+/// When the registration cache is enabled, buffers that aren't already
+/// registered are registered through it, and @p lcmd is chained to release
+/// the cache entry. Otherwise the transport registers them temporarily.
+static const void *_key_find_ref(pwc_network_t *pwc, const void *lva, size_t n,
+                                 command_t *lcmd) {
+  if (!pwc->regcache) {
+    return pwc->xport->key_find_ref(pwc->xport, lva, n);
+  }
+
+  const void *key = NULL;
+  void *entry = regcache_acquire(pwc->regcache, lva, n, &key);
+  if (entry) {
+    *lcmd = regcache_chain_release(entry, *lcmd);
+  }
+  return key;
+}
+
 int pwc_get(void *obj, void *lva, hpx_addr_t from, size_t n,
             command_t lcmd, command_t rcmd) {
   pwc_network_t *pwc = obj;
   int rank = gpa_to_rank(from);
+  const void *key = _key_find_ref(pwc, lva, n, &lcmd);
 
   xport_op_t op = {
     .rank = rank,
     .n = n,
     .dest = lva,
-    .dest_key = pwc->xport->key_find_ref(pwc->xport, lva, n),
+    .dest_key = key,
     .src = pwc->heap_segments[rank].base + gpa_to_offset(from),
     .src_key = &pwc->heap_segments[rank].key,
     .lop = lcmd,
@@ -271,6 +369,7 @@ int pwc_put(void *obj, hpx_addr_t to, const void *lva, size_t n,
             command_t lcmd, command_t rcmd) {
   pwc_network_t *pwc = obj;
   int rank = gpa_to_rank(to);
+  const void *key = _key_find_ref(pwc, lva, n, &lcmd);
 
   xport_op_t op = {
     .rank = rank,
@@ -278,7 +377,7 @@ int pwc_put(void *obj, hpx_addr_t to, const void *lva, size_t n,
     .dest = pwc->heap_segments[rank].base + gpa_to_offset(to),
     .dest_key = &pwc->heap_segments[rank].key,
     .src = lva,
-    .src_key = pwc->xport->key_find_ref(pwc->xport, lva, n),
+    .src_key = key,
     .lop = lcmd,
     .rop = rcmd
   };
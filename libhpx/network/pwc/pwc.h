@@ -27,6 +27,7 @@ struct config;
 struct gas;
 struct parcel_emulator;
 struct pwc_xport;
+struct regcache;
 struct send_buffer;
 /// @}
 
@@ -37,12 +38,15 @@ typedef struct {
   struct parcel_emulator    *parcels;
   struct send_buffer   *send_buffers;
   struct heap_segment *heap_segments;
+  struct regcache          *regcache;
   PAD_TO_CACHELINE(sizeof(network_t) +
-                   5 * sizeof(void*));
+                   6 * sizeof(void*));
   volatile int probe_lock;
   PAD_TO_CACHELINE(sizeof(int));
   volatile int progress_lock;
   PAD_TO_CACHELINE(sizeof(int));
+  volatile int coll_lock;
+  PAD_TO_CACHELINE(sizeof(int));
 } pwc_network_t;
 
 extern pwc_network_t *pwc_network;
@@ -211,6 +215,37 @@ int pwc_memcpy(void *obj, hpx_addr_t to, hpx_addr_t from, size_t size,
 /// @returns            HPX_SUCCESS;
 int pwc_memcpy_sync(void *obj, hpx_addr_t to, hpx_addr_t from, size_t size);
 
+/// The asynchronous vectored memget operation.
+///
+/// This is equivalent to a memget for each region in @p iov, except that the
+/// @p lsync LCO is only set once all of the regions have been written.
+///
+/// @param          obj The pwc network object.
+/// @param          iov The regions to get.
+/// @param            n The number of regions.
+/// @param        lsync An LCO to set when all of the local buffers are written.
+///
+/// @returns            HPX_SUCCESS
+int pwc_memget_vec(void *obj, const hpx_gas_iovec_t *iov, int n,
+                   hpx_addr_t lsync);
+
+/// The asynchronous vectored memput operation.
+///
+/// This is equivalent to a memput for each region in @p iov, except that the
+/// @p lsync and @p rsync LCOs are only set once for all of the regions.
+///
+/// @param          obj The pwc network object.
+/// @param          iov The regions to put.
+/// @param            n The number of regions.
+/// @param        lsync An LCO to set when all of the local buffers can be
+///                       reused.
+/// @param        rsync An LCO to set when all of the remote regions have been
+///                       written.
+///
+/// @returns            HPX_SUCCESS
+int pwc_memput_vec(void *obj, const hpx_gas_iovec_t *iov, int n,
+                   hpx_addr_t lsync, hpx_addr_t rsync);
+
 /// Initiate an rDMA get operation.
 ///
 /// This will copy @p n bytes between the @p from buffer and the @p lva, running
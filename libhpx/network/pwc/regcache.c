@@ -0,0 +1,476 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __GLIBC__
+# include <malloc.h>
+#endif
+#ifdef __linux__
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+#include <libsync/locks.h>
+#include <libsync/sync.h>
+#include <hpx/hpx.h>
+#include <libhpx/action.h>
+#include <libhpx/debug.h>
+#include <libhpx/libhpx.h>
+#include <libhpx/locality.h>
+#include <libhpx/padding.h>
+#include <libhpx/stats.h>
+#include <libhpx/worker.h>
+#include "regcache.h"
+#include "xport.h"
+
+/// A cached registration.
+///
+/// Valid entries are kept in an index sorted by base address, and their page
+/// ranges never overlap, so the only entry that can cover a region is the one
+/// with the greatest base at or below the region's start, which we find with a
+/// binary search. Entries are also kept in a doubly linked list in
+/// most-recently-used order for eviction. Invalidated entries are removed from
+/// both immediately, but are only unpinned once their last reference is
+/// released.
+///
+/// A miss inserts a pending entry before the lock is dropped to pin the region,
+/// so that an munmap() that races with the pin invalidates the entry. Lookups
+/// don't use pending entries.
+typedef struct _entry {
+  struct _entry *prev;
+  struct _entry *next;
+  regcache_t   *cache;
+  uintptr_t      base;                          //!< page aligned
+  uintptr_t       end;                          //!< page aligned
+  int            refs;
+  int           valid;
+  int         pending;
+  xport_key_t     key;
+} _entry_t;
+
+/// The registration cache.
+///
+/// The lock protects the index and the list. The transport's key table is
+/// searched without it, which must never return the key for a registration that
+/// belongs to the cache, as that key isn't referenced. The epoch works like a
+/// sequence lock for this: it is odd while the index is being modified or a
+/// region is being unpinned, and a key table lookup is only used if the epoch
+/// didn't change while it ran. The lo and hi fields bound the pages that the
+/// indexed entries cover, so that lookups for regions outside of them (e.g., in
+/// registered memory) don't need to take the lock at all.
+struct regcache {
+  tatas_lock_t   lock;
+  int           limit;
+  int               n;
+  int        capacity;
+  volatile uint64_t epoch;
+  volatile uintptr_t lo;
+  volatile uintptr_t hi;
+  pwc_xport_t  *xport;
+  _entry_t     **index;                         //!< valid entries by base
+  _entry_t       *mru;
+  _entry_t       *lru;
+};
+
+/// The process' registration cache, used by the munmap() hook.
+static regcache_t * volatile _cache = NULL;
+
+/// Set while a thread holds the cache lock, so that the munmap() hook ignores
+/// any memory that the transport unmaps while we pin or unpin.
+static __thread int _busy = 0;
+
+static void _lock(regcache_t *cache) {
+  sync_tatas_acquire(&cache->lock);
+  _busy = 1;
+}
+
+static void _unlock(regcache_t *cache) {
+  _busy = 0;
+  sync_tatas_release(&cache->lock);
+}
+
+/// Count a registration cache statistic, if we're running on a worker.
+static void _count(int hit) {
+  worker_t *w = self;
+  if (w && hit) {
+    COUNTER_SAMPLE(++w->stats.regcache_hits);
+  }
+  else if (w) {
+    COUNTER_SAMPLE(++w->stats.regcache_misses);
+  }
+}
+
+/// Start a modification that lock-free lookups must not overlap, with the lock
+/// held.
+static void _write_begin(regcache_t *cache) {
+  sync_fadd(&cache->epoch, 1, SYNC_ACQ_REL);
+}
+
+/// Finish a modification, updating the bounds of the index.
+static void _write_end(regcache_t *cache) {
+  int n = cache->n;
+  sync_store(&cache->lo, (n) ? cache->index[0]->base : UINTPTR_MAX,
+             SYNC_RELAXED);
+  sync_store(&cache->hi, (n) ? cache->index[n - 1]->end : 0, SYNC_RELAXED);
+  sync_fadd(&cache->epoch, 1, SYNC_ACQ_REL);
+}
+
+/// Find the number of indexed entries with a base at or below @p addr, with the
+/// lock held.
+static int _search(const regcache_t *cache, uintptr_t addr) {
+  int lo = 0;
+  int hi = cache->n;
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (cache->index[mid]->base <= addr) {
+      lo = mid + 1;
+    }
+    else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/// Find the indexed entry that overlaps the page containing @p addr, with the
+/// lock held.
+static _entry_t *_lookup(const regcache_t *cache, uintptr_t addr) {
+  int i = _search(cache, addr);
+  if (!i) {
+    return NULL;
+  }
+  _entry_t *e = cache->index[i - 1];
+  return (addr < e->end) ? e : NULL;
+}
+
+/// Find the last indexed entry that overlaps [base, end), with the lock held.
+static _entry_t *_overlap(const regcache_t *cache, uintptr_t base,
+                          uintptr_t end) {
+  int i = _search(cache, end - 1);
+  if (!i) {
+    return NULL;
+  }
+  _entry_t *e = cache->index[i - 1];
+  return (base < e->end) ? e : NULL;
+}
+
+/// Unlink an entry from the list, with the lock held.
+static void _unlink(regcache_t *cache, _entry_t *e) {
+  if (e->prev) {
+    e->prev->next = e->next;
+  }
+  else {
+    cache->mru = e->next;
+  }
+  if (e->next) {
+    e->next->prev = e->prev;
+  }
+  else {
+    cache->lru = e->prev;
+  }
+  e->prev = NULL;
+  e->next = NULL;
+}
+
+/// Push an entry at the most-recently-used end of the list, with the lock
+/// held.
+static void _push(regcache_t *cache, _entry_t *e) {
+  e->prev = NULL;
+  e->next = cache->mru;
+  if (cache->mru) {
+    cache->mru->prev = e;
+  }
+  else {
+    cache->lru = e;
+  }
+  cache->mru = e;
+}
+
+/// Add an entry to the index and the list, with the lock held.
+static void _insert(regcache_t *cache, _entry_t *e) {
+  if (cache->n == cache->capacity) {
+    cache->capacity *= 2;
+    cache->index = realloc(cache->index,
+                           cache->capacity * sizeof(cache->index[0]));
+    dbg_assert(cache->index);
+  }
+
+  _write_begin(cache);
+  int i = _search(cache, e->base);
+  memmove(&cache->index[i + 1], &cache->index[i],
+          (cache->n - i) * sizeof(cache->index[0]));
+  cache->index[i] = e;
+  cache->n++;
+  _push(cache, e);
+  _write_end(cache);
+}
+
+/// Remove an entry from the cache, with the lock held.
+///
+/// @returns            true if the entry is unreferenced and can be unpinned.
+static int _remove(regcache_t *cache, _entry_t *e) {
+  _write_begin(cache);
+  int i = _search(cache, e->base) - 1;
+  dbg_assert(0 <= i && cache->index[i] == e);
+  memmove(&cache->index[i], &cache->index[i + 1],
+          (cache->n - i - 1) * sizeof(cache->index[0]));
+  cache->n--;
+  _unlink(cache, e);
+  e->valid = 0;
+  _write_end(cache);
+  return (e->refs == 0);
+}
+
+/// Unpin and free an entry, with the lock held.
+static void _unpin(_entry_t *e) {
+  regcache_t *cache = e->cache;
+  _write_begin(cache);
+  cache->xport->unpin((void*)e->base, e->end - e->base);
+  _write_end(cache);
+  free(e);
+}
+
+/// Evict unreferenced entries until the cache is within its limit, with the
+/// lock held.
+static void _evict(regcache_t *cache) {
+  _entry_t *e = cache->lru;
+  while (e && cache->n > cache->limit) {
+    _entry_t *prev = e->prev;
+    if (e->refs == 0) {
+      _remove(cache, e);
+      _unpin(e);
+    }
+    e = prev;
+  }
+}
+
+regcache_t *regcache_new(pwc_xport_t *xport, int entries) {
+  if (entries <= 0) {
+    return NULL;
+  }
+
+  dbg_assert_str(!_cache, "only one registration cache is supported\n");
+  regcache_t *cache = malloc(sizeof(*cache));
+  dbg_assert(cache);
+  sync_tatas_init(&cache->lock);
+  cache->limit = entries;
+  cache->n = 0;
+  cache->capacity = entries;
+  cache->epoch = 0;
+  cache->lo = UINTPTR_MAX;
+  cache->hi = 0;
+  cache->xport = xport;
+  cache->index = malloc(cache->capacity * sizeof(cache->index[0]));
+  dbg_assert(cache->index);
+  cache->mru = NULL;
+  cache->lru = NULL;
+
+#ifdef __GLIBC__
+  // glibc releases large allocations and trims its heap without going through
+  // munmap(), so we ask it to keep its memory mapped instead.
+  mallopt(M_MMAP_MAX, 0);
+  mallopt(M_TRIM_THRESHOLD, -1);
+#endif
+
+  sync_store(&_cache, cache, SYNC_RELEASE);
+  log_net("registration cache enabled with %d entries\n", entries);
+  return cache;
+}
+
+void regcache_delete(regcache_t *cache) {
+  if (!cache) {
+    return;
+  }
+
+  sync_store(&_cache, NULL, SYNC_RELEASE);
+  _lock(cache);
+  _entry_t *e = NULL;
+  while ((e = cache->mru)) {
+    _remove(cache, e);
+    _unpin(e);
+  }
+  _unlock(cache);
+  free(cache->index);
+  free(cache);
+}
+
+void *regcache_acquire(regcache_t *cache, const void *addr, size_t n,
+                       const void **key) {
+  uintptr_t base = (uintptr_t)addr;
+  uintptr_t end = base + n;
+
+  // Regions outside of the pages that the cache has pinned can't be covered by
+  // one of its registrations, so if the transport has a key for them (e.g.,
+  // they're in registered memory) we can use it without taking the lock.
+  uint64_t epoch = sync_load(&cache->epoch, SYNC_ACQUIRE);
+  uint64_t probed = epoch + 1;
+  if (!(epoch & 1) && (end <= sync_load(&cache->lo, SYNC_RELAXED) ||
+                       sync_load(&cache->hi, SYNC_RELAXED) <= base)) {
+    *key = cache->xport->key_find_ref(cache->xport, addr, n);
+    if (epoch == sync_load(&cache->epoch, SYNC_ACQUIRE)) {
+      if (*key) {
+        return NULL;
+      }
+      probed = epoch;
+    }
+  }
+
+  while (true) {
+    // look for a cached registration
+    _lock(cache);
+    _entry_t *e = _lookup(cache, base);
+    if (e && !e->pending && end <= e->end) {
+      e->refs++;
+      _unlink(cache, e);
+      _push(cache, e);
+      *key = e->key;
+      _unlock(cache);
+      _count(1);
+      return e;
+    }
+
+    // then look for a transport key without holding the lock, unless a pending
+    // entry covers the region, in which case the transport would find the key
+    // that is being registered for it, or we already know there isn't one
+    epoch = sync_load(&cache->epoch, SYNC_ACQUIRE);
+    if ((e && end <= e->end) || epoch == probed) {
+      break;
+    }
+    _unlock(cache);
+    *key = cache->xport->key_find_ref(cache->xport, addr, n);
+    if (*key && epoch == sync_load(&cache->epoch, SYNC_ACQUIRE)) {
+      return NULL;
+    }
+    probed = (*key) ? epoch + 1 : epoch;
+  }
+
+  // otherwise insert a pending entry for the pages that the region covers,
+  // merged with any entries that it overlaps so that the index stays disjoint,
+  // and register them without holding the lock
+  uintptr_t pbase = base & ~(uintptr_t)(HPX_PAGE_SIZE - 1);
+  uintptr_t pend = end + ALIGN(end, HPX_PAGE_SIZE);
+  _entry_t *o = NULL;
+  while ((o = _overlap(cache, pbase, pend))) {
+    pbase = (o->base < pbase) ? o->base : pbase;
+    pend = (pend < o->end) ? o->end : pend;
+    if (_remove(cache, o)) {
+      _unpin(o);
+    }
+  }
+
+  _entry_t *e = malloc(sizeof(*e));
+  dbg_assert(e);
+  e->cache = cache;
+  e->base = pbase;
+  e->end = pend;
+  e->refs = 1;
+  e->valid = 1;
+  e->pending = 1;
+  _insert(cache, e);
+  _unlock(cache);
+
+  log_net("caching registration for (%p, %zu)\n", addr, n);
+  _busy = 1;
+  cache->xport->pin((void*)e->base, e->end - e->base, &e->key);
+  _busy = 0;
+  *key = e->key;
+  _count(0);
+
+  // if the region was unmapped while we pinned it then the entry has already
+  // been removed, and is unpinned when we release it
+  _lock(cache);
+  e->pending = 0;
+  if (e->valid) {
+    _evict(cache);
+  }
+  _unlock(cache);
+  return e;
+}
+
+/// Release a reference to an entry.
+static void _release(_entry_t *e) {
+  regcache_t *cache = e->cache;
+  _lock(cache);
+  if (--e->refs == 0 && !e->valid) {
+    _unpin(e);
+  }
+  else {
+    _evict(cache);
+  }
+  _unlock(cache);
+}
+
+// async entry point for release
+static int _release_async(_entry_t *e, int src, uint64_t op) {
+  _release(e);
+  command_run(src, (command_t){op});
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, 0, _regcache_release, _release_async,
+                     HPX_POINTER, HPX_INT, HPX_UINT64);
+
+command_t regcache_chain_release(void *entry, command_t op) {
+  // like the transport's temporary registrations, this parcel doesn't need
+  // credit to run
+  hpx_parcel_t *p = action_new_parcel(_regcache_release, // action
+                                      HPX_HERE,          // target
+                                      0,                 // continuation target
+                                      0,                 // continuation action
+                                      3,                 // nargs
+                                      &entry,            // entry to release
+                                      &here->rank,       // src for command
+                                      &op.packed);       // command
+
+  return (command_t){ .op = RESUME_PARCEL, .arg = (uintptr_t)p };
+}
+
+void regcache_invalidate(const void *addr, size_t n) {
+  regcache_t *cache = sync_load(&_cache, SYNC_ACQUIRE);
+  if (likely(!cache) || _busy || !n) {
+    return;
+  }
+
+  uintptr_t base = (uintptr_t)addr;
+  uintptr_t end = base + n;
+
+  _lock(cache);
+  _entry_t *e = NULL;
+  while ((e = _overlap(cache, base, end))) {
+    log_net("invalidating cached registration (%p, %zu)\n",
+            (void*)e->base, e->end - e->base);
+    if (_remove(cache, e)) {
+      _unpin(e);
+    }
+  }
+  _unlock(cache);
+}
+
+#ifdef __linux__
+/// Interpose on munmap() so that cached registrations are invalidated when the
+/// memory they cover is unmapped.
+///
+/// We forward to the system call directly rather than looking up the next
+/// definition, which might need to allocate. The hook is linked into every
+/// build with the PWC network, but when the cache is disabled it only costs a
+/// load of the cache pointer.
+HPX_PUBLIC int munmap(void *addr, size_t length) {
+  regcache_invalidate(addr, length);
+  return syscall(SYS_munmap, addr, length);
+}
+#endif
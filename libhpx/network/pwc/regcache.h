@@ -0,0 +1,95 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_PWC_REGCACHE_H
+#define LIBHPX_NETWORK_PWC_REGCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @file  libhpx/network/pwc/regcache.h
+///
+/// The registration cache keeps recently registered user buffers pinned, so
+/// that repeated memget and memput operations from the same (non-registered)
+/// application buffers don't need to register and release them each time.
+///
+/// Entries cover whole pages, are reference counted while operations that use
+/// them are in flight, and are evicted in least-recently-used order once the
+/// cache is full. Entries that overlap a region that is unmapped are
+/// invalidated, so that a new mapping at the same address is never accessed
+/// through a stale registration.
+
+#include <stddef.h>
+#include "commands.h"
+
+/// Forward declarations
+/// @{
+struct pwc_xport;
+typedef struct regcache regcache_t;
+/// @}
+
+/// Allocate a registration cache.
+///
+/// There is at most one registration cache per process, since the hook that
+/// invalidates entries when memory is unmapped needs to find it.
+///
+/// @param        xport The transport used to pin and unpin regions.
+/// @param      entries The number of entries to keep registered.
+///
+/// @returns            The new cache, or NULL if @p entries is 0.
+regcache_t *regcache_new(struct pwc_xport *xport, int entries);
+
+/// Delete a registration cache, releasing all of its registrations.
+void regcache_delete(regcache_t *cache);
+
+/// Find the transport key for a local region.
+///
+/// If the region is covered by a cached registration then we use that.
+/// Otherwise, if the transport already has a key for the region (e.g., it is
+/// in registered memory), we use the transport's key. Otherwise the region is
+/// registered and added to the cache.
+///
+/// @param        cache The registration cache.
+/// @param         addr The start of the region.
+/// @param            n The number of bytes in the region.
+/// @param[out]     key The transport key for the region.
+///
+/// @returns            A referenced entry that must be released with
+///                     regcache_chain_release(), or NULL if the key belongs to
+///                     the transport.
+void *regcache_acquire(regcache_t *cache, const void *addr, size_t n,
+                       const void **key);
+
+/// Interpose a command to release an entry before performing @p op.
+///
+/// @param        entry The entry from regcache_acquire().
+/// @param           op The user's local completion operation.
+///
+/// @returns            The operation that should be used as the local
+///                     completion event handler for the current operation.
+command_t regcache_chain_release(void *entry, command_t op);
+
+/// Invalidate all of the cached registrations that overlap a region.
+///
+/// This is called automatically when memory is unmapped.
+///
+/// @param         addr The start of the region.
+/// @param            n The number of bytes in the region.
+void regcache_invalidate(const void *addr, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHPX_NETWORK_PWC_REGCACHE_H
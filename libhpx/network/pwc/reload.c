@@ -27,6 +27,8 @@
 #include <libhpx/parcel.h>
 #include <libhpx/parcel_block.h>
 #include <libhpx/scheduler.h>
+#include <libhpx/stats.h>
+#include <libhpx/worker.h>
 
 #include "commands.h"
 #include "parcel_emulation.h"
@@ -46,6 +48,13 @@ typedef struct {
   xport_key_t key;
 } remote_t;
 
+/// The reload parcel emulator.
+///
+/// Recv buffers are allocated lazily, when a sender first asks for one, and
+/// are resized at each reload based on how quickly the sender filled the
+/// previous buffer. Busy senders grow their buffer up to @p max, so they need
+/// fewer reload round trips, and buffers that take a long time to fill shrink
+/// back toward @p min.
 typedef struct {
   parcel_emulator_t vtable;
   int                 rank;
@@ -55,25 +64,48 @@ typedef struct {
   buffer_t           *send;
   xport_key_t     send_key;
   remote_t        *remotes;
+  size_t               min;                     //!< the initial buffer size
+  size_t               max;                     //!< the largest buffer size
+  uint64_t        interval;                     //!< the reload interval (ns)
+  hpx_time_t     *reloaded;                     //!< the last reload per rank
 } reload_t;
 
 static void _buffer_fini(buffer_t *b) {
-  if (b) {
+  if (b && b->block) {
     parcel_block_delete(b->block);
   }
 }
 
 static void
-_buffer_reload(buffer_t *b, pwc_xport_t *xport) {
+_buffer_reload(buffer_t *b, size_t align, pwc_xport_t *xport) {
   dbg_assert(1ul << ceil_log2_size_t(b->n) == b->n);
-  b->block = parcel_block_new(b->n, b->n, &b->i);
+  b->block = parcel_block_new(align, b->n, &b->i);
   xport->key_find(xport, b->block, b->n, &b->key);
 }
 
-static void
-_buffer_init(buffer_t *b, size_t n, pwc_xport_t *xport) {
-  b->n = n;
-  _buffer_reload(b, xport);
+/// Select the size of the next recv buffer for a sender.
+///
+/// @param       reload The parcel emulator.
+/// @param          src The sender.
+///
+/// @returns            The new buffer size.
+static size_t _buffer_size(reload_t *reload, int src) {
+  hpx_time_t now = hpx_time_now();
+  size_t n = reload->recv[src].n;
+  if (!n) {
+    n = reload->min;
+  }
+  else {
+    uint64_t ns = hpx_time_diff_ns(reload->reloaded[src], now);
+    if (ns < reload->interval && n < reload->max) {
+      n <<= 1;
+    }
+    else if (ns / 64 > reload->interval && n > reload->min) {
+      n >>= 1;
+    }
+  }
+  reload->reloaded[src] = now;
+  return n;
 }
 
 void handle_recv_parcel(int src, command_t command) {
@@ -116,6 +148,10 @@ _buffer_send(buffer_t *send, pwc_xport_t *xport, xport_op_t *op) {
   op->rop.arg = r;
   int e = xport->cmd(op->rank, op->lop, op->rop);
   if (LIBHPX_OK == e) {
+    worker_t *w = self;
+    if (w) {
+      COUNTER_SAMPLE(++w->stats.reloads);
+    }
     return LIBHPX_RETRY;
   }
 
@@ -172,6 +208,7 @@ _reload_delete(void *obj) {
     registered_free(reload->recv);
     registered_free(reload->send);
     free(reload->remotes);
+    free(reload->reloaded);
     free(reload);
   }
 }
@@ -189,6 +226,12 @@ parcel_emulator_new_reload(const config_t *cfg, boot_t *boot,
   reload->vtable.recv = _reload_recv;
   reload->rank = rank;
   reload->ranks = ranks;
+  reload->min = cfg->pwc_parcelbuffersize;
+  reload->max = parcel_block_max_size(cfg);
+  reload->interval = (cfg->pwc_reloadinterval > 0) ?
+                     cfg->pwc_reloadinterval * UINT64_C(1000) : 0;
+  reload->reloaded = calloc(ranks, sizeof(hpx_time_t));
+  dbg_assert(reload->reloaded);
 
   // Allocate my buffers.
   size_t buffer_row_size = ranks * sizeof(buffer_t);
@@ -201,11 +244,9 @@ parcel_emulator_new_reload(const config_t *cfg, boot_t *boot,
   xport->key_find(xport, reload->send, buffer_row_size, &reload->send_key);
   xport->key_find(xport, reload->recv, buffer_row_size, &reload->recv_key);
 
-  // Initialize the recv buffers for this rank.
-  for (int i = 0, e = ranks; i < e; ++i) {
-    buffer_t *recv = &reload->recv[i];
-    _buffer_init(recv, cfg->pwc_parcelbuffersize, xport);
-  }
+  // The recv buffers for this rank start out empty, and are allocated by the
+  // first reload request from each sender.
+  memset(reload->recv, 0, buffer_row_size);
 
   // Initialize a temporary array of remote pointers for this rank's sends.
   remote_t *remotes = malloc(remote_table_size);
@@ -237,8 +278,8 @@ parcel_emulator_new_reload(const config_t *cfg, boot_t *boot,
 
   // Now reload contains:
   //
-  // 1) A row of initialized recv buffers, one for each sender.
-  // 2) A row of initialized send buffers, one for each target (corresponding to
+  // 1) A row of empty recv buffers, one for each sender.
+  // 2) A row of empty send buffers, one for each target (corresponding to
   //    their recv buffer for me).
   // 3) A table of remote pointers, one for each send buffer targeting me.
   return reload;
@@ -257,7 +298,9 @@ void handle_reload_request(int src, command_t cmd) {
   if (n) {
     parcel_block_deduct(recv->block, n);
   }
-  _buffer_reload(recv, xport);
+  recv->n = _buffer_size(reload, src);
+  _buffer_reload(recv, reload->max, xport);
+  log_parcel("reloaded %zu byte buffer for %d\n", recv->n, src);
 
   xport_op_t op = {
     .rank = src,
@@ -15,115 +15,180 @@
 # include "config.h"
 #endif
 
+#include <stdbool.h>
+#include <libsync/sync.h>
 #include <libhpx/debug.h>
 #include <libhpx/libhpx.h>
 #include <libhpx/locality.h>
+#include <libhpx/parcel.h>
 #include "parcel_emulation.h"
 #include "send_buffer.h"
 
-/// The record type for the pending send circular buffer.
-typedef struct {
-  hpx_addr_t      lsync;
-  const hpx_parcel_t *p;
-} record_t;
+static int _start(send_buffer_t *sends, const hpx_parcel_t *p) {
+  return parcel_emulator_send(sends->emul, sends->xport, sends->rank, p);
+}
 
-/// Append a record to the parcel's pending send buffer.
+/// Push a parcel onto the stack of new sends.
 ///
 /// @param        sends The send buffer.
-/// @param        lsync The local command.
-/// @param            p The parcel to buffer.
+/// @param            p The parcel to push.
+static void _push(send_buffer_t *sends, hpx_parcel_t *p) {
+  hpx_parcel_t *top = sync_load(&sends->sends, SYNC_RELAXED);
+  do {
+    p->next = top;
+  } while (!sync_cas(&sends->sends, &top, p, SYNC_SEQ_CST, SYNC_RELAXED));
+}
+
+/// Move the stack of new sends to the end of the pending FIFO.
 ///
-/// @returns  LIBHXP_OK The parcel was buffered successfully.
-///        LIBHPX_ERROR A pending record could not be allocated.
-static int _append(send_buffer_t *sends, hpx_addr_t lsync,
-                   const hpx_parcel_t *p) {
-  record_t *r = circular_buffer_append(&sends->pending);
-  dbg_assert_str(r, "could not append a send operation to the buffer\n");
-  r->lsync = lsync;
-  r->p = p;
-  return LIBHPX_OK;
+/// This must only be called by the consumer.
+///
+/// @param        sends The send buffer.
+static void _collect(send_buffer_t *sends) {
+  hpx_parcel_t *stack = sync_swap(&sends->sends, NULL, SYNC_ACQUIRE);
+  hpx_parcel_t *last = stack;
+  hpx_parcel_t *fifo = NULL;
+  hpx_parcel_t *p = NULL;
+  while ((p = parcel_stack_pop(&stack))) {
+    parcel_stack_push(&fifo, p);
+  }
+
+  if (!fifo) {
+    return;
+  }
+
+  if (sends->tail) {
+    sends->tail->next = fifo;
+  }
+  else {
+    sends->pending = fifo;
+  }
+  sends->tail = last;
 }
 
-static int _start(send_buffer_t *sends, const hpx_parcel_t *p) {
-  return parcel_emulator_send(sends->emul, sends->xport, sends->rank, p);
+/// Start as many pending sends as possible.
+///
+/// This must only be called by the consumer. Parcels are started in FIFO
+/// order. If the parcel emulator needs to reload we stop, and mark the buffer
+/// as reloading so that no one tries to start sends until
+/// send_buffer_progress() is called.
+///
+/// The emulator requests the reload before it reports the retry, so the reload
+/// may complete before we set the reloading flag. Its send_buffer_progress()
+/// call can't get the token that we hold, so we detect that case through the
+/// reload count and keep going ourselves.
+///
+/// @param        sends The send buffer.
+/// @param[out]  status LIBHPX_OK, or the error from the parcel emulator.
+///
+/// @returns            true if there are sends left in the buffer.
+static bool _drain(send_buffer_t *sends, int *status) {
+  _collect(sends);
+
+  hpx_parcel_t *p = NULL;
+  while ((p = sends->pending)) {
+    // Once the send starts the network owns the parcel, so unlink it first.
+    hpx_parcel_t *next = p->next;
+    p->next = NULL;
+    unsigned reloads = sync_load(&sends->reloads, SYNC_SEQ_CST);
+    int e = _start(sends, p);
+    if (e != LIBHPX_OK) {
+      p->next = next;
+      if (e == LIBHPX_RETRY) {
+        sync_store(&sends->reloading, 1, SYNC_SEQ_CST);
+        if (sync_load(&sends->reloads, SYNC_SEQ_CST) != reloads) {
+          sync_store(&sends->reloading, 0, SYNC_SEQ_CST);
+          continue;
+        }
+      }
+      else {
+        log_error("failed to progress the send buffer\n");
+        *status = e;
+      }
+      return true;
+    }
+
+    sends->pending = next;
+    if (!next) {
+      sends->tail = NULL;
+      _collect(sends);
+    }
+  }
+  return false;
 }
 
-/// Wrap the eager_buffer_tx() operation in an interface that matches the
-/// circular_buffer_progress callback type.
-static int _start_record(void *buffer, void *record) {
-  send_buffer_t *sends = buffer;
-  record_t *r = record;
-  return _start(sends, r->p);
+/// Drain the send buffer if we can get the consumer token.
+///
+/// After giving up the token we check for sends that were pushed while we
+/// held it, since their senders could not get the token to start them.
+///
+/// @param        sends The send buffer.
+/// @param         more true if the pending FIFO may be non-empty.
+///
+/// @returns            LIBHPX_OK, or an error from the parcel emulator.
+static int _progress(send_buffer_t *sends, bool more) {
+  int status = LIBHPX_OK;
+  while (more || sync_load(&sends->sends, SYNC_SEQ_CST)) {
+    if (sync_load(&sends->reloading, SYNC_SEQ_CST)) {
+      break;
+    }
+    if (!sync_swap(&sends->consumer, 0, SYNC_SEQ_CST)) {
+      break;
+    }
+    more = _drain(sends, &status);
+    sync_store(&sends->consumer, 1, SYNC_SEQ_CST);
+    if (status != LIBHPX_OK) {
+      break;
+    }
+  }
+  return status;
 }
 
 /// Progress a send buffer.
 ///
-/// Progressing a send buffer means transferring as many buffered sends to the
-/// network as is currently possible. This will return the number of remaining
-/// buffered sends.
-///
-/// Progressing a send buffer must be properly synchronized with the send
-/// operation, as well as with concurrent attempts to progress the buffer, since
-/// they may be called concurrently from more than one thread.
+/// This is called when the parcel emulator has reloaded, and transfers as many
+/// buffered sends to the network as is currently possible.
 ///
 /// @param        sends The send buffer.
 ///
 /// @returns            HPX_SUCCESS or an error code.
 int send_buffer_progress(send_buffer_t *sends) {
-  int status = HPX_SUCCESS;
-  sync_tatas_acquire(&sends->lock);
-  int i = circular_buffer_progress(&sends->pending, _start_record, sends);
-  if (i < 0) {
-    log_error("failed to progress the send buffer\n");
-    status = HPX_ERROR;
-  }
-  sync_tatas_release(&sends->lock);
-  return status;
+  sync_fadd(&sends->reloads, 1, SYNC_SEQ_CST);
+  sync_store(&sends->reloading, 0, SYNC_SEQ_CST);
+  int e = _progress(sends, true);
+  return (e == LIBHPX_OK) ? HPX_SUCCESS : HPX_ERROR;
 }
 
 int send_buffer_init(send_buffer_t *sends, int rank,
-                     struct parcel_emulator *emul, struct pwc_xport *xport,
-                     uint32_t size) {
-  sync_tatas_init(&sends->lock);
+                     struct parcel_emulator *emul, struct pwc_xport *xport) {
+  sync_store(&sends->sends, NULL, SYNC_RELAXED);
+  sync_store(&sends->consumer, 1, SYNC_RELAXED);
+  sync_store(&sends->reloading, 0, SYNC_RELAXED);
+  sync_store(&sends->reloads, 0, SYNC_RELAXED);
+  sends->pending = NULL;
+  sends->tail = NULL;
   sends->rank = rank;
   sends->emul = emul;
   sends->xport = xport;
-  return circular_buffer_init(&sends->pending, sizeof(record_t), size);
+  return LIBHPX_OK;
 }
 
 void send_buffer_fini(send_buffer_t *sends) {
-  circular_buffer_fini(&sends->pending);
+  _collect(sends);
+  if (sends->pending) {
+    log_net("dropping buffered sends to %d\n", sends->rank);
+  }
 }
 
-int send_buffer_send(send_buffer_t *sends, hpx_addr_t lsync,
-                     const hpx_parcel_t *p) {
+int send_buffer_send(send_buffer_t *sends, hpx_addr_t lsync, hpx_parcel_t *p) {
   if (lsync != HPX_NULL) {
     log_error("local send complete event unimplemented\n");
     return LIBHPX_EUNIMPLEMENTED;
   }
 
-  int status = LIBHPX_OK;
-  sync_tatas_acquire(&sends->lock);
-
-  // If we have no pending sends, try and start a request.
-  if (circular_buffer_size(&sends->pending) == 0) {
-    status = _start(sends, p);
-    if (status == LIBHPX_OK) {
-      goto unlock;
-    }
-
-    // If we have an error at this point then report it and buffer the parcel.
-    if (status != LIBHPX_RETRY) {
-      log_error("error in parcel send, buffer the operation\n");
-    }
-  }
-
-  // We need to buffer this parcel, because either we're already buffering
-  // parcels, or we need to buffer while the parcel transport refreshes.
-  status = _append(sends, lsync, p);
-  dbg_check(status, "could not append send operation\n");
-
- unlock:
-  sync_tatas_release(&sends->lock);
-  return status;
+  // If we can't start the send right away then it stays buffered, and errors
+  // have already been reported.
+  _push(sends, p);
+  _progress(sends, false);
+  return LIBHPX_OK;
 }
@@ -15,25 +15,36 @@
 #define LIBHPX_NETWORK_PWC_SEND_BUFFER_H
 
 #include <hpx/hpx.h>
-#include <libsync/locks.h>
-#include "circular_buffer.h"
+#include <libhpx/padding.h>
 
 struct parcel_emulator;
 struct pwc_xport;
 
+/// The send buffer for a rank.
+///
+/// Senders never block on the send buffer. They push their parcel onto a
+/// lock-free stack and then try to take the consumer token. Whoever holds the
+/// token (a sender that found the buffer idle, or the progress engine when the
+/// parcel emulator has reloaded) moves the stack to the private pending FIFO
+/// and starts as many sends as the emulator allows. A sender that fails to get
+/// the token just returns, the current consumer will see its parcel before it
+/// gives the token up.
 typedef struct send_buffer {
-  struct tatas_lock       lock;
-  int                     rank;
-  int           UNUSED_PADDING;
-  struct parcel_emulator *emul;
-  struct pwc_xport      *xport;
-  circular_buffer_t    pending;
+  hpx_parcel_t * volatile sends;        //!< new sends, pushed by senders
+  PAD_TO_CACHELINE(sizeof(hpx_parcel_t*));
+  volatile int         consumer;        //!< 1 when the token is available
+  volatile int        reloading;        //!< waiting for the emulator to reload
+  volatile unsigned     reloads;        //!< number of completed reloads
+  int                      rank;
+  hpx_parcel_t         *pending;        //!< buffered sends (consumer only)
+  hpx_parcel_t            *tail;        //!< end of pending (consumer only)
+  struct parcel_emulator  *emul;
+  struct pwc_xport       *xport;
 } send_buffer_t;
 
 /// Initialize a send buffer.
 int send_buffer_init(send_buffer_t *sends, int rank,
-                     struct parcel_emulator *emul, struct pwc_xport *xport,
-                     uint32_t size);
+                     struct parcel_emulator *emul, struct pwc_xport *xport);
 
 /// Finalize a send buffer.
 void send_buffer_fini(send_buffer_t *sends);
@@ -44,9 +55,9 @@ void send_buffer_fini(send_buffer_t *sends);
 /// not HPX_NULL then it will be signaled when the local send operation
 /// completes at the network level.
 ///
-/// This send operation must be properly synchronized with other sends, and with
-/// send_buffer_progress() since they may be called concurrently from more than
-/// one thread.
+/// This send operation is lock free, and may be called concurrently with other
+/// sends and with send_buffer_progress(). The parcel's next pointer is used to
+/// buffer it.
 ///
 /// NB: We don't currently support the @p lsync operation. When a send
 ///     completes, it generates a local completion event that is returned
@@ -59,12 +70,10 @@ void send_buffer_fini(send_buffer_t *sends);
 ///
 /// @returns  LIBHPX_OK The send operation was successful (i.e., it was passed
 ///                       to the network or it was buffered).
-///       LIBHPX_ENOMEM The send operation could not complete because it needed
-///                       to be buffered but the system was out of memory.
-///        LIBHPX_ERROR An unexpected error occurred.
-int send_buffer_send(send_buffer_t *sends, hpx_addr_t lsync,
-                     const hpx_parcel_t *p);
+/// LIBHPX_EUNIMPLEMENTED @p lsync was not HPX_NULL.
+int send_buffer_send(send_buffer_t *sends, hpx_addr_t lsync, hpx_parcel_t *p);
 
+/// Progress a send buffer after the parcel emulator has reloaded.
 int send_buffer_progress(send_buffer_t *sends);
 
 #endif // LIBHPX_NETWORK_PWC_EAGER_BUFFER_H
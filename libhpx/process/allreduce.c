@@ -17,20 +17,36 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <libsync/sync.h>
+#include <libhpx/config.h>
 #include <libhpx/debug.h>
 #include <libhpx/parcel.h>
 #include <libhpx/gas.h>
+#include <libhpx/libhpx.h>
+#include <libhpx/locality.h>
 #include <libhpx/network.h>
 #include "allreduce.h"
 
 
 void allreduce_init(allreduce_t *r, size_t bytes, hpx_addr_t parent,
-                    hpx_monoid_id_t id, hpx_monoid_op_t op) {
+                    hpx_monoid_id_t id, hpx_monoid_op_t op, coll_type_t type,
+                    int32_t root) {
+  // the inputs and results of the other collectives are either one block, or
+  // one block for each locality, and the root gathers the inputs from every
+  // locality (see network.h)
+  int n = here->ranks;
+  size_t in = (type == ALL_TO_ALL || type == REDUCE_SCATTER) ? n * bytes : bytes;
+  size_t out = (type == ALL_GATHER || type == ALL_TO_ALL) ? n * bytes : bytes;
+  if (!parent && type != ALL_REDUCE) {
+    out = n * in;
+  }
+
   r->lock = hpx_lco_sema_new(1);
-  r->bytes = bytes;
+  r->bytes = in;
+  r->block = bytes;
   r->parent = parent;
-  r->continuation = continuation_new(bytes);
-  r->reduce = reduce_new(bytes, id, op);
+  r->continuation = continuation_new(out);
+  r->reduce = reduce_new(in, id, op);
   r->id = -1;
   // allocate memory for data structure plus for rank data
   // optimistic allocation for ranks - for all lcoalities
@@ -39,15 +55,50 @@ void allreduce_init(allreduce_t *r, size_t bytes, hpx_addr_t parent,
   r->ctx->group_bytes = sizeof(int32_t) * HPX_LOCALITIES;
   r->ctx->comm_bytes = 0;
   r->ctx->group_sz = 0;
-  r->ctx->recv_count = bytes;
-  r->ctx->type = ALL_REDUCE;
+  r->ctx->recv_count = in;
+  r->ctx->type = type;
   r->ctx->op = op;
+  r->ctx->root = root;
+  r->rid = id;
+  r->rop = op;
+
+  // the value buffer is reused for every reduction that passes through this
+  // node, rather than being allocated each time
+  r->value = malloc(out);
+  dbg_assert(r->value);
+  r->segments = NULL;
+  r->received = 0;
+  sync_tatas_init(&r->gather.lock);
+  r->gather.count = 0;
+
+  // values larger than the segment size are pipelined through the tree one
+  // segment at a time, the root reduces and broadcasts each segment as soon
+  // as all of its children have contributed to it
+  size_t segment = here->config->coll_segment;
+  if (!segment || bytes <= segment || here->config->coll_network ||
+      type != ALL_REDUCE) {
+    r->segment = 0;
+    return;
+  }
+
+  r->segment = segment;
+  if (!parent) {
+    int n = ceil_div_64(bytes, segment);
+    r->segments = calloc(n, sizeof(*r->segments));
+    dbg_assert(r->segments);
+    for (int i = 0; i < n; ++i) {
+      sync_tatas_init(&r->segments[i].lock);
+    }
+    id(r->value, bytes);
+  }
 }
 
 void allreduce_fini(allreduce_t *r) {
   hpx_lco_delete_sync(r->lock);
   continuation_delete(r->continuation);
   reduce_delete(r->reduce);
+  free(r->segments);
+  free(r->value);
 }
 
 int32_t allreduce_add(allreduce_t *r, hpx_action_t op, hpx_addr_t addr) {
@@ -115,17 +166,52 @@ void allreduce_reduce(allreduce_t *r, const void *val) {
     // for sw based direct collective join
     // create parcel and prepare for coll call
     hpx_parcel_t *p = hpx_parcel_acquire(NULL, r->bytes);
-    void *output = malloc(r->bytes);
     reduce_reset(r->reduce, hpx_parcel_get_data(p));
 
     // perform synchronized collective comm
-    here->net->coll_sync(here->net, p, output, r->ctx);
+    int e = here->net->coll_sync(here->net, p, r->value, r->ctx);
+    dbg_check(e, "collective allreduce failed\n");
+    parcel_delete(p);
 
     // call all local continuations to communicate the result
-    continuation_trigger(r->continuation, output);
-    free(output);
+    continuation_trigger(r->continuation, r->value);
+    return;
+  }
+
+  // the other collectives gather the input from every locality at the root,
+  // where each input is stored at the offset for its locality
+  if (r->ctx->type != ALL_REDUCE) {
+    dbg_assert(r->parent);
+    size_t offset = here->rank * r->bytes;
+    hpx_parcel_t *p = hpx_parcel_acquire(NULL, sizeof(offset) + r->bytes);
+    p->target = r->parent;
+    p->action = allreduce_gather_async;
+    char *data = hpx_parcel_get_data(p);
+    memcpy(data, &offset, sizeof(offset));
+    reduce_reset(r->reduce, data + sizeof(offset));
+    parcel_launch(p);
     return;
   }
+
+  // the local continuation is done, join the parent node asynchronously one
+  // segment at a time
+  if (r->parent && r->segment) {
+    reduce_reset(r->reduce, r->value);
+    const char *value = r->value;
+    for (size_t offset = 0; offset < r->bytes; offset += r->segment) {
+      size_t bytes = r->bytes - offset;
+      bytes = (bytes < r->segment) ? bytes : r->segment;
+      hpx_parcel_t *p = hpx_parcel_acquire(NULL, sizeof(offset) + bytes);
+      p->target = r->parent;
+      p->action = allreduce_join_segment_async;
+      char *data = hpx_parcel_get_data(p);
+      memcpy(data, &offset, sizeof(offset));
+      memcpy(data + sizeof(offset), value + offset, bytes);
+      parcel_launch(p);
+    }
+    return;
+  }
+
   // the local continuation is done, join the parent node asynchronously
   if (r->parent) {
     hpx_parcel_t *p = hpx_parcel_acquire(NULL, r->bytes);
@@ -137,24 +223,117 @@ void allreduce_reduce(allreduce_t *r, const void *val) {
   }
 
   // this is a root node, so turn around and run all of our continuations
-  void *result = malloc(r->bytes);
-  reduce_reset(r->reduce, result);
-  allreduce_bcast(r, result);
-  free(result);
+  reduce_reset(r->reduce, r->value);
+  allreduce_bcast(r, r->value);
+}
+
+void allreduce_reduce_segment(allreduce_t *r, size_t offset, const void *in,
+                              size_t bytes) {
+  log_coll("reducing segment %zu at %p\n", offset, r);
+  dbg_assert(!r->parent && r->segment);
+  allreduce_segment_t *s = &r->segments[offset / r->segment];
+  char *value = (char*)r->value + offset;
+
+  // the segment lock serializes the children's contributions, the next
+  // contribution to this segment can't arrive until the current result has
+  // been broadcast
+  sync_tatas_acquire(&s->lock);
+  r->rop(value, in, bytes);
+  if (++s->count == reduce_inputs(r->reduce)) {
+    s->count = 0;
+    continuation_trigger_segment(r->continuation, allreduce_bcast_segment_async,
+                                 offset, value, bytes);
+    r->rid(value, bytes);
+  }
+  sync_tatas_release(&s->lock);
+}
+
+void allreduce_bcast_segment(allreduce_t *r, size_t offset, const void *value,
+                             size_t bytes) {
+  log_coll("broadcasting segment %zu at %p\n", offset, r);
+  memcpy((char*)r->value + offset, value, bytes);
+  if (sync_addf(&r->received, bytes, SYNC_ACQ_REL) == r->bytes) {
+    sync_store(&r->received, 0, SYNC_RELEASE);
+    allreduce_bcast(r, r->value);
+  }
+}
+
+void allreduce_gather(allreduce_t *r, size_t offset, const void *in) {
+  log_coll("gathering input at offset %zu at %p\n", offset, r);
+  dbg_assert(!r->parent && offset + r->bytes <= here->ranks * r->bytes);
+  allreduce_segment_t *g = &r->gather;
+
+  // the lock serializes the inputs, the next input from a locality can't be
+  // written until the current inputs have been broadcast
+  sync_tatas_acquire(&g->lock);
+  memcpy((char*)r->value + offset, in, r->bytes);
+  if (++g->count == here->ranks) {
+    g->count = 0;
+    allreduce_bcast(r, r->value);
+  }
+  sync_tatas_release(&g->lock);
+}
+
+/// Compute a leaf's result for one of the other collectives from the inputs
+/// gathered from every locality.
+static void _scatter(allreduce_t *r, const char *in) {
+  int n = here->ranks;
+  size_t block = r->block;
+  size_t offset = here->rank * block;
+  char *out = r->value;
+
+  switch (r->ctx->type) {
+   case ALL_GATHER:
+    memcpy(out, in, n * block);
+    return;
+   case ALL_TO_ALL:
+    for (int i = 0; i < n; ++i) {
+      memcpy(out + i * block, in + i * r->bytes + offset, block);
+    }
+    return;
+   case BROADCAST:
+    memcpy(out, in + r->ctx->root * block, block);
+    return;
+   case REDUCE_SCATTER:
+    memcpy(out, in + offset, block);
+    for (int i = 1; i < n; ++i) {
+      r->rop(out, in + i * r->bytes + offset, block);
+    }
+    return;
+   default:
+    dbg_error("unexpected collective type %d\n", r->ctx->type);
+  }
 }
 
 void allreduce_bcast(allreduce_t *r, const void *value) {
   log_coll("broadcasting at %p\n", r);
+  // the leaves of the other collectives get the gathered inputs
+  if (r->parent && r->ctx->type != ALL_REDUCE) {
+    _scatter(r, value);
+    value = r->value;
+  }
+
   // just trigger the continuation stored in this node
   continuation_trigger(r->continuation, value);
 }
 
-void allreduce_bcast_comm(allreduce_t *r, hpx_addr_t base, const void *coll) {
+int allreduce_bcast_comm(allreduce_t *r, hpx_addr_t base, const void *coll) {
   log_coll("broadcasting comm ranks from root %p\n", r);
 
   // boradcast my comm group to all leaves
   // this is executed only on network root
   if (coll == NULL) {
+    // the other collectives are defined over every locality
+    if (r->ctx->type != ALL_REDUCE && r->ctx->group_sz != here->ranks) {
+      return log_error("collective type %d requires all %u localities, not "
+                       "%d\n", r->ctx->type, here->ranks, r->ctx->group_sz);
+    }
+
+    // the leaves only need the group for the network collective
+    if (!here->config->coll_network) {
+      return LIBHPX_OK;
+    }
+
     int n = here->ranks;
     hpx_addr_t target = HPX_NULL;
     hpx_addr_t and = hpx_lco_and_new(n);
@@ -175,18 +354,20 @@ void allreduce_bcast_comm(allreduce_t *r, hpx_addr_t base, const void *coll) {
     hpx_call(target, allreduce_bcast_comm_async, and, r->ctx,
              sizeof(coll_t) + r->ctx->group_bytes);
 
-    hpx_lco_wait(and);
+    int e = hpx_lco_wait(and);
     hpx_lco_delete_sync(and);
-
-    return;
+    return e;
   }
 
   // set the collective context in current leaf node
   // this is executed only in leaves
+  // the root's operation pointer is not valid at this locality, so keep ours
   const coll_t *c = coll;
+  hpx_monoid_op_t op = r->ctx->op;
   *r->ctx = *c;
-  dbg_assert(r->ctx->group_sz = c->group_sz);
-  dbg_assert(r->ctx->recv_count = c->recv_count);
+  r->ctx->op = op;
+  dbg_assert(r->ctx->group_sz == c->group_sz);
+  dbg_assert(r->ctx->recv_count == c->recv_count);
 
   int32_t *ranks = (int32_t *)r->ctx->data;
   int32_t *copy_ranks = (int32_t *)c->data;
@@ -194,5 +375,5 @@ void allreduce_bcast_comm(allreduce_t *r, hpx_addr_t base, const void *coll) {
     ranks[i] = copy_ranks[i];
   }
   // perform collective initialization for all leaf nodes here
-  dbg_check(here->net->coll_init(here->net, &r->ctx));
+  return here->net->coll_init(here->net, &r->ctx);
 }
@@ -26,6 +26,9 @@ void continuation_delete(continuation_t *obj);
 int32_t continuation_add(continuation_t **obj, hpx_action_t op, hpx_addr_t addr);
 void continuation_remove(continuation_t **obj, int32_t id);
 void continuation_trigger(continuation_t *obj, const void *value);
+void continuation_trigger_segment(continuation_t *obj, hpx_action_t op,
+                                  size_t offset, const void *value,
+                                  size_t bytes);
 
 typedef struct reduce reduce_t;
 
@@ -35,28 +38,52 @@ int reduce_add(reduce_t *obj);
 int reduce_remove(reduce_t *obj);
 int reduce_join(reduce_t *obj, const void *in);
 void reduce_reset(reduce_t *obj, void *out);
+int reduce_inputs(const reduce_t *obj);
+
+/// The reduction state used at the root for each segment of a pipelined
+/// allreduce, and for the inputs that the root gathers for the other
+/// collective types.
+typedef struct {
+  tatas_lock_t lock;
+  int         count;
+} allreduce_segment_t;
 
 typedef struct {
   hpx_addr_t              lock;           // semaphore synchronizes add/remove
   size_t                 bytes;           // the size of the value being reduced
+  size_t                 block;           // the block size of the collective
   hpx_addr_t            parent;           // our parent node
   continuation_t *continuation;           // our continuation data
   reduce_t             *reduce;           // the local reduction
   int32_t                   id;           // our identifier for our parent
   coll_t                  *ctx;           // collective context info for this reduce
+  hpx_monoid_id_t          rid;           // the reduction identity
+  hpx_monoid_op_t          rop;           // the reduction operation
+  size_t               segment;           // the pipeline segment size, or 0
+  void                  *value;           // reusable buffer for the value
+  allreduce_segment_t *segments;          // segment state (pipelined root)
+  allreduce_segment_t   gather;           // gathered input state (root)
+  volatile size_t     received;           // result bytes received (pipelined)
 } allreduce_t;
 
 void allreduce_init(allreduce_t *obj, size_t bytes, hpx_addr_t parent,
-                    hpx_monoid_id_t id, hpx_monoid_op_t op);
+                    hpx_monoid_id_t id, hpx_monoid_op_t op, coll_type_t type,
+                    int32_t root);
 void allreduce_fini(allreduce_t *obj);
 int32_t allreduce_add(allreduce_t *obj, hpx_action_t op, hpx_addr_t addr);
 void allreduce_remove(allreduce_t *obj, int32_t id);
 void allreduce_reduce(allreduce_t *obj, const void *in);
 void allreduce_bcast(allreduce_t *obj, const void *val);
-void allreduce_bcast_comm(allreduce_t *obj, hpx_addr_t base, const void *coll);
+int allreduce_bcast_comm(allreduce_t *obj, hpx_addr_t base, const void *coll);
+void allreduce_reduce_segment(allreduce_t *obj, size_t offset, const void *in,
+                              size_t bytes);
+void allreduce_bcast_segment(allreduce_t *obj, size_t offset, const void *val,
+                             size_t bytes);
+void allreduce_gather(allreduce_t *obj, size_t offset, const void *in);
 
 /// void allreduce_init_async(allreduce_t *, size_t bytes, hpx_addr_t parent,
-///                           hpx_action_t id, hpx_action_t op);
+///                           hpx_action_t id, hpx_action_t op, int type,
+///                           int32_t root);
 extern HPX_ACTION_DECL(allreduce_init_async);
 
 /// void allreduce_fini_async(allreduce_t *);
@@ -77,4 +104,10 @@ extern HPX_ACTION_DECL(allreduce_bcast_async);
 
 extern HPX_ACTION_DECL(allreduce_bcast_comm_async);
 
+extern HPX_ACTION_DECL(allreduce_join_segment_async);
+
+extern HPX_ACTION_DECL(allreduce_bcast_segment_async);
+
+extern HPX_ACTION_DECL(allreduce_gather_async);
+
 #endif // LIBHPX_PROCESS_ALLREDUCE_H
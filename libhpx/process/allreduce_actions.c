@@ -15,23 +15,25 @@
 # include "config.h"
 #endif
 
+#include <string.h>
 #include <libhpx/action.h>
 #include <libhpx/debug.h>
+#include <libhpx/locality.h>
 #include "allreduce.h"
 
 static int _allreduce_init_handler(allreduce_t *r, size_t bytes,
                                    hpx_addr_t parent, hpx_action_t id,
-                                   hpx_action_t op) {
+                                   hpx_action_t op, int type, int32_t root) {
   CHECK_ACTION(id);
   CHECK_ACTION(op);
   hpx_monoid_id_t rid = (hpx_monoid_id_t)actions[id].handler;
   hpx_monoid_op_t rop = (hpx_monoid_op_t)actions[op].handler;
-  allreduce_init(r, bytes, parent, rid, rop);
+  allreduce_init(r, bytes, parent, rid, rop, type, root);
   return HPX_SUCCESS;
 }
 HPX_ACTION(HPX_INTERRUPT, HPX_PINNED, allreduce_init_async,
            _allreduce_init_handler, HPX_POINTER, HPX_SIZE_T, HPX_ADDR,
-           HPX_ACTION_T, HPX_ACTION_T);
+           HPX_ACTION_T, HPX_ACTION_T, HPX_INT, HPX_SINT32);
 
 static int _allreduce_fini_handler(allreduce_t *r) {
   allreduce_fini(r);
@@ -63,6 +65,18 @@ static int _allreduce_join_handler(allreduce_t *r, void *value, size_t bytes) {
 HPX_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED, allreduce_join_async,
            _allreduce_join_handler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
 
+static int _allreduce_join_segment_handler(allreduce_t *r, void *args,
+                                           size_t bytes) {
+  size_t offset;
+  dbg_assert(bytes > sizeof(offset));
+  memcpy(&offset, args, sizeof(offset));
+  const char *value = (const char*)args + sizeof(offset);
+  allreduce_reduce_segment(r, offset, value, bytes - sizeof(offset));
+  return HPX_SUCCESS;
+}
+HPX_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED,
+           allreduce_join_segment_async, _allreduce_join_segment_handler,
+           HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
 
 static int _allreduce_bcast_comm_handler(allreduce_t *r, void *value,
                                          size_t bytes) {
@@ -70,15 +84,12 @@ static int _allreduce_bcast_comm_handler(allreduce_t *r, void *value,
     // if root netwrk node we pass only the base address for bcast
     dbg_assert(bytes == sizeof(hpx_addr_t));
     hpx_addr_t base = *((hpx_addr_t *)value);
-
-    allreduce_bcast_comm(r, base, NULL);
-    return HPX_SUCCESS;
+    return allreduce_bcast_comm(r, base, NULL);
   }
 
   coll_t *ctx = value;
   dbg_assert(bytes == (sizeof(coll_t) + ctx->group_bytes));
-  allreduce_bcast_comm(r, HPX_NULL, ctx);
-  return HPX_SUCCESS;
+  return allreduce_bcast_comm(r, HPX_NULL, ctx);
 }
 HPX_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED,
            allreduce_bcast_comm_async, _allreduce_bcast_comm_handler,
@@ -86,9 +97,34 @@ HPX_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED,
 
 static int _allreduce_bcast_handler(allreduce_t *r, const void *value,
                                     size_t bytes) {
-  dbg_assert(bytes == r->bytes);
+  // the other collectives broadcast the inputs from every locality
+  dbg_assert(bytes == ((r->ctx->type == ALL_REDUCE) ? r->bytes :
+                       here->ranks * r->bytes));
   allreduce_bcast(r, value);
   return HPX_SUCCESS;
 }
 HPX_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED, allreduce_bcast_async,
            _allreduce_bcast_handler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+
+static int _allreduce_bcast_segment_handler(allreduce_t *r, void *args,
+                                            size_t bytes) {
+  size_t offset;
+  dbg_assert(bytes > sizeof(offset));
+  memcpy(&offset, args, sizeof(offset));
+  const char *value = (const char*)args + sizeof(offset);
+  allreduce_bcast_segment(r, offset, value, bytes - sizeof(offset));
+  return HPX_SUCCESS;
+}
+HPX_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED,
+           allreduce_bcast_segment_async, _allreduce_bcast_segment_handler,
+           HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+
+static int _allreduce_gather_handler(allreduce_t *r, void *args, size_t bytes) {
+  size_t offset;
+  dbg_assert(bytes == sizeof(offset) + r->bytes);
+  memcpy(&offset, args, sizeof(offset));
+  allreduce_gather(r, offset, (const char*)args + sizeof(offset));
+  return HPX_SUCCESS;
+}
+HPX_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED, allreduce_gather_async,
+           _allreduce_gather_handler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
@@ -21,15 +21,19 @@
 
 static const size_t BSIZE = sizeof(allreduce_t);
 
-hpx_addr_t hpx_process_collective_allreduce_new(size_t bytes,
-                                                hpx_action_t reset,
-                                                hpx_action_t op) {
+/// Allocate a process collective of any type.
+///
+/// @param         type The type of the collective.
+/// @param        bcast The root locality of a broadcast.
+static hpx_addr_t _collective_new(coll_type_t type, int32_t bcast,
+                                  size_t bytes, hpx_action_t reset,
+                                  hpx_action_t op) {
   // allocate and initialize a root node
   hpx_addr_t root = hpx_gas_alloc_local(1, BSIZE, 0);
   dbg_assert(root);
   hpx_addr_t null = HPX_NULL;
   dbg_check( hpx_call_sync(root, allreduce_init_async, NULL, 0, &bytes, &null,
-                           &reset, &op) );
+                           &reset, &op, &type, &bcast) );
 
   // allocate an array of local elements for the process
   int n = here->ranks;
@@ -40,7 +44,8 @@ hpx_addr_t hpx_process_collective_allreduce_new(size_t bytes,
   hpx_addr_t and = hpx_lco_and_new(n);
   dbg_check( hpx_gas_bcast_with_continuation(allreduce_init_async, base, n,
                                              0, BSIZE, hpx_lco_set_action, and,
-                                             &bytes, &root, &reset, &op) );
+                                             &bytes, &root, &reset, &op, &type,
+                                             &bcast) );
   hpx_lco_wait(and);
   hpx_lco_delete_sync(and);
 
@@ -48,6 +53,40 @@ hpx_addr_t hpx_process_collective_allreduce_new(size_t bytes,
   return base;
 }
 
+hpx_addr_t hpx_process_collective_allreduce_new(size_t bytes,
+                                                hpx_action_t reset,
+                                                hpx_action_t op) {
+  return _collective_new(ALL_REDUCE, 0, bytes, reset, op);
+}
+
+hpx_addr_t hpx_process_collective_allgather_new(size_t bytes,
+                                                hpx_action_t reset,
+                                                hpx_action_t op) {
+  return _collective_new(ALL_GATHER, 0, bytes, reset, op);
+}
+
+hpx_addr_t hpx_process_collective_alltoall_new(size_t bytes,
+                                               hpx_action_t reset,
+                                               hpx_action_t op) {
+  return _collective_new(ALL_TO_ALL, 0, bytes, reset, op);
+}
+
+hpx_addr_t hpx_process_collective_bcast_new(size_t bytes, int root,
+                                            hpx_action_t reset,
+                                            hpx_action_t op) {
+  if (root < 0 || here->ranks <= root) {
+    log_error("broadcast root %d is not a locality\n", root);
+    return HPX_NULL;
+  }
+  return _collective_new(BROADCAST, root, bytes, reset, op);
+}
+
+hpx_addr_t hpx_process_collective_reduce_scatter_new(size_t bytes,
+                                                     hpx_action_t reset,
+                                                     hpx_action_t op) {
+  return _collective_new(REDUCE_SCATTER, 0, bytes, reset, op);
+}
+
 void hpx_process_collective_allreduce_delete(hpx_addr_t allreduce) {
   hpx_addr_t root = HPX_NULL;
   hpx_addr_t proxy = hpx_addr_add(allreduce, here->rank * BSIZE, BSIZE);
@@ -82,19 +121,23 @@ int32_t hpx_process_collective_allreduce_subscribe(hpx_addr_t allreduce,
 }
 
 int hpx_process_collective_allreduce_subscribe_finalize(hpx_addr_t allreduce) {
-  if (here->config->coll_network) {
-    allreduce_t *r = NULL;
-    hpx_addr_t root = HPX_NULL;
-    hpx_addr_t leaf = hpx_addr_add(allreduce, here->rank * BSIZE, BSIZE);
-    if (!hpx_gas_try_pin(leaf, (void *)&r)) {
-      dbg_error("could not pin local element for an allreduce\n");
-    }
-    root = r->parent;
-
-    dbg_check(hpx_call_sync(root, allreduce_bcast_comm_async, NULL, 0, &allreduce,
-                          sizeof(hpx_addr_t)));
+  allreduce_t *r = NULL;
+  hpx_addr_t leaf = hpx_addr_add(allreduce, here->rank * BSIZE, BSIZE);
+  if (!hpx_gas_try_pin(leaf, (void *)&r)) {
+    dbg_error("could not pin local element for an allreduce\n");
   }
-  return HPX_SUCCESS;
+  hpx_addr_t root = r->parent;
+  coll_type_t type = r->ctx->type;
+  hpx_gas_unpin(leaf);
+
+  // the root checks the group of the other collectives even when they don't
+  // use the network
+  if (!here->config->coll_network && type == ALL_REDUCE) {
+    return HPX_SUCCESS;
+  }
+
+  return hpx_call_sync(root, allreduce_bcast_comm_async, NULL, 0, &allreduce,
+                       sizeof(hpx_addr_t));
 }
 
 void hpx_process_collective_allreduce_unsubscribe(hpx_addr_t allreduce,
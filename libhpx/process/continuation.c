@@ -111,3 +111,22 @@ void continuation_trigger(continuation_t *c, const void *value) {
   }
 }
 
+void continuation_trigger_segment(continuation_t *c, hpx_action_t op,
+                                  size_t offset, const void *value,
+                                  size_t bytes) {
+  log_coll("continuing segment %zu from %p\n", offset, c);
+
+  // segments are sent as an offset header followed by the data, to the
+  // registered targets but with the segment action
+  for (int i = 0, e = c->n; i < e; ++i) {
+    if (c->parcels[i]) {
+      hpx_parcel_t *p = hpx_parcel_acquire(NULL, sizeof(offset) + bytes);
+      p->action = op;
+      p->target = c->parcels[i]->target;
+      char *data = hpx_parcel_get_data(p);
+      memcpy(data, &offset, sizeof(offset));
+      memcpy(data + sizeof(offset), value, bytes);
+      parcel_launch(p);
+    }
+  }
+}
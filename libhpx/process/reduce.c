@@ -96,3 +96,7 @@ void reduce_reset(reduce_t *r, void *out) {
 
   sync_store(&r->i, r->n, SYNC_RELEASE);
 }
+
+int reduce_inputs(const reduce_t *r) {
+  return r->n;
+}
@@ -159,6 +159,15 @@ static hpx_status_t _allgather_attach(lco_t *lco, hpx_parcel_t *p) {
   return status;
 }
 
+static hpx_parcel_t *_allgather_detach(lco_t *lco, cvar_match_t match,
+                                       const void *env) {
+  lco_lock(lco);
+  _allgather_t *g = (_allgather_t *)lco;
+  hpx_parcel_t *p = cvar_detach(&g->wait, match, env);
+  lco_unlock(lco);
+  return p;
+}
+
 /// Get the value of the gathering, will wait if the phase is gathering.
 static hpx_status_t _allgather_get(lco_t *lco, int size, void *out, int reset) {
   _allgather_t *g = (_allgather_t *)lco;
@@ -320,6 +329,7 @@ static const lco_class_t _allgather_vtable = {
   .on_error    = _allgather_error,
   .on_set      = _allgather_set,
   .on_attach   = _allgather_attach,
+  .on_detach   = _allgather_detach,
   .on_get      = _allgather_get,
   .on_getref   = _allgather_getref,
   .on_release  = _allgather_release,
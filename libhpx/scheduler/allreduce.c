@@ -194,6 +194,15 @@ static hpx_status_t _allreduce_attach(lco_t *lco, hpx_parcel_t *p) {
   return status;
 }
 
+static hpx_parcel_t *_allreduce_detach(lco_t *lco, cvar_match_t match,
+                                       const void *env) {
+  lco_lock(lco);
+  _allreduce_t *r = (_allreduce_t *)lco;
+  hpx_parcel_t *p = cvar_detach(&r->wait, match, env);
+  lco_unlock(lco);
+  return p;
+}
+
 /// Get the value of the reduction, will wait if the phase is reducing.
 static hpx_status_t _allreduce_get(lco_t *lco, int size, void *out, int reset) {
   hpx_status_t rc = HPX_SUCCESS;
@@ -231,6 +240,7 @@ static const lco_class_t _allreduce_vtable = {
   .on_error    = _allreduce_error,
   .on_set      = _allreduce_set,
   .on_attach   = _allreduce_attach,
+  .on_detach   = _allreduce_detach,
   .on_get      = _allreduce_get,
   .on_getref   = _allreduce_getref,
   .on_release  = _allreduce_release,
@@ -79,22 +79,38 @@
 #include "cvar.h"
 #include "lco.h"
 
+/// A contribution that arrived while the alltoall was being read, and that has
+/// to wait for the next gathering epoch.
+typedef struct _alltoall_pending {
+  struct _alltoall_pending *next;
+  hpx_addr_t               rsync;
+  unsigned                offset;
+  int                          n;
+  int                       size;
+  char                  buffer[];
+} _alltoall_pending_t;
+
 /// Local alltoall interface.
 /// @{
 typedef struct {
-  lco_t           lco;
-  cvar_t         wait;
-  size_t participants;
-  size_t        count;
-  volatile int  phase;
-  void         *value;
+  lco_t                  lco;
+  cvar_t                wait;
+  size_t        participants;
+  size_t               count;
+  volatile int         phase;
+  volatile unsigned    epoch;
+  void                *value;
+  _alltoall_pending_t  *head;
+  _alltoall_pending_t  *tail;
 } _alltoall_t;
 
 static const int GATHERING = 0;
 static const int READING = 1;
 
 typedef struct {
+  hpx_addr_t rsync;
   int offset;
+  int n;
   char buffer[];
 } _alltoall_set_offset_t;
 
@@ -122,6 +138,11 @@ static void _alltoall_fini(lco_t *lco) {
   if (g->value) {
     free(g->value);
   }
+  while (g->head) {
+    _alltoall_pending_t *next = g->head->next;
+    free(g->head);
+    g->head = next;
+  }
   lco_fini(lco);
 }
 
@@ -168,6 +189,64 @@ static hpx_status_t _alltoall_attach(lco_t *lco, hpx_parcel_t *p) {
     return status;
 }
 
+static hpx_parcel_t *_alltoall_detach(lco_t *lco, cvar_match_t match,
+                                      const void *env) {
+  lco_lock(lco);
+  _alltoall_t *g = (_alltoall_t *)lco;
+  hpx_parcel_t *p = cvar_detach(&g->wait, match, env);
+  lco_unlock(lco);
+  return p;
+}
+
+/// Scatter @p n consecutive rows of @p size bytes into the alltoall, starting
+/// at row @p offset. This must be called with the lock held, while we're
+/// gathering.
+static void _alltoall_write(_alltoall_t *g, unsigned offset, int n, int size,
+                            const void *buffer) {
+  dbg_assert(n <= g->count);
+  assert(size && buffer);
+  int nDoms = g->participants;
+  int elementSize = size / nDoms;
+
+  for (int j = 0; j < n; j++) {
+    int columnOffset = (offset + j) * elementSize;
+    const char *row = (const char *)buffer + j * size;
+    for (int i = 0; i < nDoms; i++) {
+      int rowOffset = i * size;
+      int tempOffset = rowOffset + columnOffset;
+      int sourceOffset = i * elementSize;
+      memcpy((char*)g->value + tempOffset, row + sourceOffset, elementSize);
+    }
+  }
+
+  // if we're the last one to arrive, switch the phase and signal readers
+  g->count -= n;
+  if (g->count == 0) {
+    g->phase = READING;
+    scheduler_signal_all(&g->wait);
+  }
+}
+
+/// Apply the contributions that were queued for the new gathering epoch, in
+/// the order in which they arrived.
+static void _alltoall_drain(_alltoall_t *g) {
+  while (g->head && g->phase == GATHERING) {
+    _alltoall_pending_t *pending = g->head;
+    g->head = pending->next;
+    if (!g->head) {
+      g->tail = NULL;
+    }
+    _alltoall_write(g, pending->offset, pending->n, pending->size,
+                    pending->buffer);
+    // we hold the lock, so the remote completion is signaled asynchronously
+    if (pending->rsync) {
+      int e = hpx_call(pending->rsync, hpx_lco_set_action, HPX_NULL, NULL, 0);
+      dbg_check(e, "could not signal remote completion\n");
+    }
+    free(pending);
+  }
+}
+
 /// Get the value of the gathering, will wait if the phase is gathering.
 static hpx_status_t _alltoall_getid(_alltoall_t *g, unsigned offset, int size,
                                     void *out) {
@@ -193,12 +272,19 @@ static hpx_status_t _alltoall_getid(_alltoall_t *g, unsigned offset, int size,
   // release all of the other readers, otherwise wait for the phase to change
   // back to gathering---this blocking behavior prevents gets from one "epoch"
   // to satisfy earlier READING epochs
+  //
+  // The queued writers for the next epoch may complete it before the readers
+  // we release here get to run, so they wait for the epoch rather than the
+  // phase to change.
   if (++g->count == g->participants) {
     g->phase = GATHERING;
+    g->epoch++;
+    _alltoall_drain(g);
     scheduler_signal_all(&g->wait);
   }
   else {
-    while ((g->phase == READING) && (status == HPX_SUCCESS)) {
+    unsigned epoch = g->epoch;
+    while ((g->epoch == epoch) && (status == HPX_SUCCESS)) {
       status = scheduler_wait(&g->lco.lock, &g->wait);
     }
   }
@@ -264,97 +350,125 @@ static hpx_status_t _alltoall_wait(lco_t *lco, int reset) {
   return _alltoall_getid(g, 0, 0, NULL);
 }
 
-// Local set id function.
-static hpx_status_t _alltoall_setid(_alltoall_t *g, unsigned offset, int size,
-                                    const void* buffer) {
-  int nDoms;
-  int elementSize;
-  int columnOffset;
-  hpx_status_t status = HPX_SUCCESS;
+// Local set id function, sets @p n consecutive ids starting at @p offset.
+//
+// Writers never wait for the readers of the current epoch. If we're not
+// gathering, the contribution is queued and applied when the last reader
+// finishes.
+static hpx_status_t _alltoall_setid(_alltoall_t *g, unsigned offset, int n,
+                                    int size, const void* buffer,
+                                    hpx_addr_t rsync) {
   lco_lock(&g->lco);
-
-  // wait until we're gathering
-  while ((g->phase != GATHERING) && (status == HPX_SUCCESS)) {
-    status = scheduler_wait(&g->lco.lock, &g->wait);
-  }
-
+  hpx_status_t status = cvar_get_error(&g->wait);
   if (status != HPX_SUCCESS) {
     goto unlock;
   }
 
-  nDoms = g->participants;
-  // copy in our chunk of the data
-  assert(size && buffer);
-  elementSize = size / nDoms;
-  columnOffset = offset * elementSize;
-
-  for (int i = 0; i < nDoms; i++) {
-    int rowOffset = i * size;
-    int tempOffset = rowOffset + columnOffset;
-    int sourceOffset = i * elementSize;
-    memcpy((char*)g->value + tempOffset, (char *)buffer + sourceOffset, elementSize);
+  if (g->phase == GATHERING) {
+    _alltoall_write(g, offset, n, size, buffer);
+    goto unlock;
   }
 
-  // if we're the last one to arrive, switch the phase and signal readers
-  if (--g->count == 0) {
-    g->phase = READING;
-    scheduler_signal_all(&g->wait);
+  _alltoall_pending_t *pending = malloc(sizeof(*pending) + n * size);
+  dbg_assert(pending);
+  pending->next = NULL;
+  pending->rsync = rsync;
+  pending->offset = offset;
+  pending->n = n;
+  pending->size = size;
+  memcpy(pending->buffer, buffer, n * size);
+  if (g->tail) {
+    g->tail->next = pending;
+  }
+  else {
+    g->head = pending;
   }
+  g->tail = pending;
+  rsync = HPX_NULL;
 
  unlock:
   lco_unlock(&g->lco);
+  hpx_lco_error(rsync, status, HPX_NULL);
   return status;
 }
 
-/// Set the ID for alltoall. This is global setid for the user to use.
+/// Set a range of IDs for alltoall. This is global setid for the user to use.
 ///
 /// @param   alltoall   Global address of the alltoall LCO
-/// @param   id         ID to be set
-/// @param   size       The size of the data being gathered
-/// @param   value      Address of the value to be set
+/// @param   id         The first ID to be set
+/// @param   n          The number of consecutive IDs to set
+/// @param   size       The size of the data being gathered for each ID
+/// @param   values     Address of the @p n values to be set
 /// @param   lsync      An LCO to signal on local completion HPX_NULL if we
 ///                     don't care. Local completion indicates that the
-///                     @p value may be freed or reused.
-/// @param   rsync      An LCO to signal remote completion HPX_NULL if we
-///                     don't care.
+///                     @p values may be freed or reused.
+/// @param   rsync      An LCO to signal once the values have been applied,
+///                     HPX_NULL if we don't care.
 /// @returns HPX_SUCCESS or the code passed to hpx_lco_error()
-hpx_status_t hpx_lco_alltoall_setid(hpx_addr_t alltoall, unsigned id, int size,
-                                    const void *value, hpx_addr_t lsync,
-                                    hpx_addr_t rsync) {
+hpx_status_t hpx_lco_alltoall_setid_range(hpx_addr_t alltoall, unsigned id,
+                                          unsigned n, int size,
+                                          const void *values, hpx_addr_t lsync,
+                                          hpx_addr_t rsync) {
   hpx_status_t status = HPX_SUCCESS;
   _alltoall_t *local;
 
+  if (!n) {
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return status;
+  }
+
   if (!hpx_gas_try_pin(alltoall, (void**)&local)) {
-    size_t args_size = sizeof(_alltoall_set_offset_t) + size;
+    size_t args_size = sizeof(_alltoall_set_offset_t) + n * size;
     hpx_parcel_t *p = hpx_parcel_acquire(NULL, args_size);
     assert(p);
     hpx_parcel_set_target(p, alltoall);
     hpx_parcel_set_action(p, _alltoall_setid_proxy);
-    hpx_parcel_set_cont_target(p, rsync);
-    hpx_parcel_set_cont_action(p, hpx_lco_set_action);
 
+    // the proxy signals rsync once the values have been applied, which may
+    // be after the current reading phase
     _alltoall_set_offset_t *args = hpx_parcel_get_data(p);
+    args->rsync = rsync;
     args->offset = id;
-    memcpy(&args->buffer, value, size);
+    args->n = n;
+    memcpy(&args->buffer, values, n * size);
     hpx_parcel_send(p, lsync);
   }
   else {
-    status = _alltoall_setid(local, id, size, value);
+    status = _alltoall_setid(local, id, n, size, values, rsync);
     hpx_gas_unpin(alltoall);
     hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
-    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
   }
 
   return status;
 }
 
+/// Set the ID for alltoall. This is global setid for the user to use.
+///
+/// @param   alltoall   Global address of the alltoall LCO
+/// @param   id         ID to be set
+/// @param   size       The size of the data being gathered
+/// @param   value      Address of the value to be set
+/// @param   lsync      An LCO to signal on local completion HPX_NULL if we
+///                     don't care. Local completion indicates that the
+///                     @p value may be freed or reused.
+/// @param   rsync      An LCO to signal once the values have been applied,
+///                     HPX_NULL if we don't care.
+/// @returns HPX_SUCCESS or the code passed to hpx_lco_error()
+hpx_status_t hpx_lco_alltoall_setid(hpx_addr_t alltoall, unsigned id, int size,
+                                    const void *value, hpx_addr_t lsync,
+                                    hpx_addr_t rsync) {
+  return hpx_lco_alltoall_setid_range(alltoall, id, 1, size, value, lsync,
+                                      rsync);
+}
+
 
 static int _alltoall_setid_proxy_handler(_alltoall_t *g, void *args, size_t n) {
   // otherwise we pinned the LCO, extract the arguments from @p args and use the
   // local setid routine
   _alltoall_set_offset_t *a = args;
-  size_t size = n - sizeof(_alltoall_set_offset_t);
-  return _alltoall_setid(g, a->offset, size, &a->buffer);
+  size_t size = (n - sizeof(_alltoall_set_offset_t)) / a->n;
+  return _alltoall_setid(g, a->offset, a->n, size, &a->buffer, a->rsync);
 }
 static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, _alltoall_setid_proxy,
                      _alltoall_setid_proxy_handler,
@@ -396,6 +510,7 @@ static const lco_class_t _alltoall_vtable = {
   .on_release  = _alltoall_release,
   .on_wait     = _alltoall_wait,
   .on_attach   = _alltoall_attach,
+  .on_detach   = _alltoall_detach,
   .on_reset    = _alltoall_reset,
   .on_size     = _alltoall_size
 };
@@ -410,7 +525,10 @@ static int _alltoall_init_handler(_alltoall_t *g, size_t participants, size_t si
   g->participants = participants;
   g->count = participants;
   g->phase = GATHERING;
+  g->epoch = 0;
   g->value = NULL;
+  g->head = NULL;
+  g->tail = NULL;
 
   if (size) {
     // Ultimately, g->value points to start of the array containing the
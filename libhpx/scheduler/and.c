@@ -152,6 +152,15 @@ static hpx_status_t _and_attach(lco_t *lco, hpx_parcel_t *p) {
   return status;
 }
 
+static hpx_parcel_t *_and_detach(lco_t *lco, cvar_match_t match,
+                                 const void *env) {
+  lco_lock(lco);
+  _and_t *and = (_and_t *)lco;
+  hpx_parcel_t *p = cvar_detach(&and->barrier, match, env);
+  lco_unlock(lco);
+  return p;
+}
+
 static hpx_status_t _and_get(lco_t *lco, int size, void *out, int reset) {
   lco_lock(lco);
   hpx_status_t status = _wait((void*)lco, reset);
@@ -193,6 +202,7 @@ static const lco_class_t _and_vtable = {
   .on_release  = _and_release,
   .on_wait     = _and_wait,
   .on_attach   = _and_attach,
+  .on_detach   = _and_detach,
   .on_reset    = _and_reset,
   .on_size     = _and_size
 };
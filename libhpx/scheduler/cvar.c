@@ -71,6 +71,22 @@ hpx_status_t cvar_attach(cvar_t *cvar, struct hpx_parcel *parcel) {
   return HPX_SUCCESS;
 }
 
+hpx_parcel_t *cvar_detach(cvar_t *cvar, cvar_match_t match, const void *env) {
+  if (_has_error(cvar)) {
+    return NULL;
+  }
+
+  for (hpx_parcel_t **p = &cvar->top; *p; p = &(*p)->next) {
+    if (match(*p, env)) {
+      hpx_parcel_t *parcel = *p;
+      *p = parcel->next;
+      parcel->next = NULL;
+      return parcel;
+    }
+  }
+  return NULL;
+}
+
 hpx_status_t cvar_push_thread(cvar_t *cvar, struct ustack *thread) {
   return cvar_attach(cvar, thread->parcel);
 }
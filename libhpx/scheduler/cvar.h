@@ -25,6 +25,9 @@ typedef struct cvar {
   hpx_parcel_t *top;
 } cvar_t;
 
+/// A predicate used to select an attached parcel.
+typedef bool (*cvar_match_t)(const hpx_parcel_t *p, const void *env);
+
 /// Reset a condition variable.
 void cvar_reset(cvar_t *cvar)
   HPX_NON_NULL(1);
@@ -93,6 +96,21 @@ hpx_status_t cvar_push_thread(cvar_t *cvar, struct ustack *thread)
 hpx_status_t cvar_attach(cvar_t *cvar, struct hpx_parcel *parcel)
   HPX_NON_NULL(1, 2);
 
+/// Remove an attached parcel from a condition variable.
+///
+/// This removes the first parcel waiting on the condition for which @p match
+/// returns true. Parcels that have already been signaled are no longer attached
+/// and can't be removed.
+///
+/// @param         cvar The condition variable to modify.
+/// @param        match The predicate that selects the parcel.
+/// @param          env The environment passed to @p match.
+///
+/// @returns            The removed parcel, or NULL if no attached parcel
+///                       matched or the condition has an error.
+hpx_parcel_t *cvar_detach(cvar_t *cvar, cvar_match_t match, const void *env)
+  HPX_NON_NULL(1, 2);
+
 /// Pop the top parcel from a condition variable.
 ///
 /// @param         cvar The condition to pop.
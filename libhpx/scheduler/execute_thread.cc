@@ -43,11 +43,13 @@ void HPX_NORETURN worker_execute_thread(hpx_parcel_t *p) {
   EVENT_THREAD_RUN(p, self);
 #endif
   int status = HPX_SUCCESS;
+  uint64_t start = libhpx_action_stats_start();
   try {
     status = action_exec_parcel(p->action, p);
   } catch (const ThreadExitStatus &e) {
     status = e.status;
   }
+  libhpx_action_stats_exec(p->action, start);
   worker_finish_thread(p, status);
 }
 
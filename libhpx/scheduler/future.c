@@ -151,6 +151,15 @@ static hpx_status_t _future_attach(lco_t *lco, hpx_parcel_t *p) {
   return status;
 }
 
+static hpx_parcel_t *_future_detach(lco_t *lco, cvar_match_t match,
+                                    const void *env) {
+  lco_lock(lco);
+  _future_t *f = (_future_t *)lco;
+  hpx_parcel_t *p = cvar_detach(&f->full, match, env);
+  lco_unlock(lco);
+  return p;
+}
+
 /// Copies the appropriate value into @p out, waiting if the lco isn't set yet.
 static hpx_status_t _future_get(lco_t *lco, int size, void *out, int reset) {
   DEBUG_IF (size && !lco_get_user(lco)) {
@@ -226,6 +235,7 @@ static const lco_class_t _future_vtable = {
   .on_release  = _future_release,
   .on_wait     = _future_wait,
   .on_attach   = _future_attach,
+  .on_detach   = _future_detach,
   .on_reset    = _future_reset,
   .on_size     = _future_size
 };
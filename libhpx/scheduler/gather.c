@@ -32,16 +32,29 @@
 #include "cvar.h"
 #include "lco.h"
 
+/// A contribution that arrived while the gather was being read, and that has
+/// to wait for the next gathering epoch.
+typedef struct _gather_pending {
+  struct _gather_pending *next;
+  hpx_addr_t             rsync;
+  unsigned              offset;
+  int                        n;
+  int                     size;
+  char                buffer[];
+} _gather_pending_t;
+
 /// Local gather interface.
 /// @{
 typedef struct {
-  lco_t           lco;
-  cvar_t         cvar;
-  int         writers;
-  int         readers;
-  volatile int wcount;
-  volatile int rcount;
-  void         *value;
+  lco_t                    lco;
+  cvar_t                  cvar;
+  int                  writers;
+  int                  readers;
+  volatile int          wcount;
+  volatile int          rcount;
+  void                  *value;
+  _gather_pending_t      *head;
+  _gather_pending_t      *tail;
 } _gather_t;
 
 static size_t _gather_size(lco_t *lco) {
@@ -59,6 +72,11 @@ static void _gather_fini(lco_t *lco) {
   if (g->value) {
     free(g->value);
   }
+  while (g->head) {
+    _gather_pending_t *next = g->head->next;
+    free(g->head);
+    g->head = next;
+  }
   lco_fini(lco);
 }
 
@@ -106,6 +124,51 @@ static hpx_status_t _gather_attach(lco_t *lco, hpx_parcel_t *p) {
   return status;
 }
 
+static hpx_parcel_t *_gather_detach(lco_t *lco, cvar_match_t match,
+                                    const void *env) {
+  lco_lock(lco);
+  _gather_t *g = (_gather_t *)lco;
+  hpx_parcel_t *p = cvar_detach(&g->cvar, match, env);
+  lco_unlock(lco);
+  return p;
+}
+
+/// Copy @p n contributions of @p size bytes into the gather, starting at @p
+/// offset. This must be called with the lock held, while we're gathering.
+static void _gather_write(_gather_t *g, unsigned offset, int n, int size,
+                          const void *buffer) {
+  dbg_assert(g->wcount + n <= g->writers);
+  assert(size && buffer);
+  memcpy((char*)g->value + (offset * size), buffer, n * size);
+
+  // if we're the last one to arrive, switch the phase and signal readers
+  g->wcount += n;
+  if (g->wcount == g->writers) {
+    g->rcount = g->readers;
+    scheduler_signal_all(&g->cvar);
+  }
+}
+
+/// Apply the contributions that were queued for the new gathering epoch, in
+/// the order in which they arrived.
+static void _gather_drain(_gather_t *g) {
+  while (g->head && g->wcount < g->writers) {
+    _gather_pending_t *pending = g->head;
+    g->head = pending->next;
+    if (!g->head) {
+      g->tail = NULL;
+    }
+    _gather_write(g, pending->offset, pending->n, pending->size,
+                  pending->buffer);
+    // we hold the lock, so the remote completion is signaled asynchronously
+    if (pending->rsync) {
+      int e = hpx_call(pending->rsync, hpx_lco_set_action, HPX_NULL, NULL, 0);
+      dbg_check(e, "could not signal remote completion\n");
+    }
+    free(pending);
+  }
+}
+
 /// Get the value of the gather LCO. This operation will wait if the
 /// writers have not finished gathering.
 static hpx_status_t _gather_get(lco_t *lco, int size, void *out, int reset) {
@@ -134,6 +197,7 @@ static hpx_status_t _gather_get(lco_t *lco, int size, void *out, int reset) {
   // to satisfy earlier READING epochs
   if (--g->rcount == 0) {
     g->wcount = 0;
+    _gather_drain(g);
     scheduler_signal_all(&g->cvar);
     goto unlock;
   }
@@ -164,38 +228,52 @@ _gather_release(lco_t *lco, void *out) {
   return 0;
 }
 
-// Local set id function.
-static hpx_status_t _gather_setid(_gather_t *g, unsigned offset, int size,
-                                  const void* buffer) {
-  hpx_status_t status = HPX_SUCCESS;
+// Local set id function, sets @p n consecutive ids starting at @p offset.
+//
+// Writers never wait for the readers of the current epoch. If we're not
+// gathering, the contribution is queued and applied when the last reader
+// finishes.
+static hpx_status_t _gather_setid(_gather_t *g, unsigned offset, int n,
+                                  int size, const void* buffer,
+                                  hpx_addr_t rsync) {
   lco_lock(&g->lco);
-
-  // wait until we're gathering
-  while ((g->wcount == g->writers) && (status == HPX_SUCCESS)) {
-    status = scheduler_wait(&g->lco.lock, &g->cvar);
-  }
-
+  hpx_status_t status = cvar_get_error(&g->cvar);
   if (status != HPX_SUCCESS) {
     goto unlock;
   }
 
-  // copy in our chunk of the data
-  assert(size && buffer);
-  memcpy((char*)g->value + (offset * size), buffer, size);
+  if (g->wcount < g->writers) {
+    _gather_write(g, offset, n, size, buffer);
+    goto unlock;
+  }
 
-  // if we're the last one to arrive, switch the phase and signal readers
-  if (++g->wcount == g->writers) {
-    g->rcount = g->readers;
-    scheduler_signal_all(&g->cvar);
+  _gather_pending_t *pending = malloc(sizeof(*pending) + n * size);
+  dbg_assert(pending);
+  pending->next = NULL;
+  pending->rsync = rsync;
+  pending->offset = offset;
+  pending->n = n;
+  pending->size = size;
+  memcpy(pending->buffer, buffer, n * size);
+  if (g->tail) {
+    g->tail->next = pending;
   }
+  else {
+    g->head = pending;
+  }
+  g->tail = pending;
+  rsync = HPX_NULL;
 
  unlock:
   lco_unlock(&g->lco);
+  hpx_lco_error(rsync, status, HPX_NULL);
   return status;
 }
 
 typedef struct {
+  hpx_addr_t rsync;
   int offset;
+  int n;
   char buffer[];
 } _gather_set_offset_t;
 
@@ -204,55 +282,82 @@ static int _gather_setid_proxy_handler(_gather_t *g, void *args, size_t n) {
   // otherwise we pinned the LCO, extract the arguments from @p args and use the
   // local setid routine
   _gather_set_offset_t *a = args;
-  size_t size = n - sizeof(_gather_set_offset_t);
-  return _gather_setid(g, a->offset, size, &a->buffer);
+  size_t size = (n - sizeof(_gather_set_offset_t)) / a->n;
+  return _gather_setid(g, a->offset, a->n, size, &a->buffer, a->rsync);
 }
 static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, _gather_setid_proxy,
                      _gather_setid_proxy_handler, HPX_POINTER,
                      HPX_POINTER, HPX_SIZE_T);
 
-/// Set the ID for gather. This is global setid for the user to use.
+/// Set a range of IDs for gather. This is global setid for the user to use.
 ///
-/// @param   gather  Global address of the altogether LCO
-/// @param   id         ID to be set
-/// @param   size       The size of the data being gathered
-/// @param   value      Address of the value to be set
+/// @param   gather     Global address of the gather LCO
+/// @param   id         The first ID to be set
+/// @param   n          The number of consecutive IDs to set
+/// @param   size       The size of the data being gathered for each ID
+/// @param   values     Address of the @p n values to be set
 /// @param   lsync      An LCO to signal on local completion HPX_NULL if we
 ///                     don't care. Local completion indicates that the
-///                     @p value may be freed or reused.
-/// @param   rsync      An LCO to signal remote completion HPX_NULL if we
-///                     don't care.
+///                     @p values may be freed or reused.
+/// @param   rsync      An LCO to signal once the values have been applied,
+///                     HPX_NULL if we don't care.
 /// @returns HPX_SUCCESS or the code passed to hpx_lco_error()
-hpx_status_t hpx_lco_gather_setid(hpx_addr_t gather, unsigned id,
-                                     int size, const void *value,
-                                     hpx_addr_t lsync, hpx_addr_t rsync) {
+hpx_status_t hpx_lco_gather_setid_range(hpx_addr_t gather, unsigned id,
+                                        unsigned n, int size,
+                                        const void *values, hpx_addr_t lsync,
+                                        hpx_addr_t rsync) {
   hpx_status_t status = HPX_SUCCESS;
   _gather_t *local;
 
+  if (!n) {
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return status;
+  }
+
   if (!hpx_gas_try_pin(gather, (void**)&local)) {
-    size_t args_size = sizeof(_gather_set_offset_t) + size;
+    size_t args_size = sizeof(_gather_set_offset_t) + n * size;
     hpx_parcel_t *p = hpx_parcel_acquire(NULL, args_size);
     assert(p);
     hpx_parcel_set_target(p, gather);
     hpx_parcel_set_action(p, _gather_setid_proxy);
-    hpx_parcel_set_cont_target(p, rsync);
-    hpx_parcel_set_cont_action(p, hpx_lco_set_action);
 
+    // the proxy signals rsync once the values have been applied, which may
+    // be after the current reading phase
     _gather_set_offset_t *args = hpx_parcel_get_data(p);
+    args->rsync = rsync;
     args->offset = id;
-    memcpy(&args->buffer, value, size);
+    args->n = n;
+    memcpy(&args->buffer, values, n * size);
     hpx_parcel_send(p, lsync);
   }
   else {
-    status = _gather_setid(local, id, size, value);
+    status = _gather_setid(local, id, n, size, values, rsync);
     hpx_gas_unpin(gather);
     hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
-    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
   }
 
   return status;
 }
 
+/// Set the ID for gather. This is global setid for the user to use.
+///
+/// @param   gather  Global address of the altogether LCO
+/// @param   id         ID to be set
+/// @param   size       The size of the data being gathered
+/// @param   value      Address of the value to be set
+/// @param   lsync      An LCO to signal on local completion HPX_NULL if we
+///                     don't care. Local completion indicates that the
+///                     @p value may be freed or reused.
+/// @param   rsync      An LCO to signal once the values have been applied,
+///                     HPX_NULL if we don't care.
+/// @returns HPX_SUCCESS or the code passed to hpx_lco_error()
+hpx_status_t hpx_lco_gather_setid(hpx_addr_t gather, unsigned id,
+                                     int size, const void *value,
+                                     hpx_addr_t lsync, hpx_addr_t rsync) {
+  return hpx_lco_gather_setid_range(gather, id, 1, size, value, lsync, rsync);
+}
+
 /// Update the gathering, will wait if the phase is reading.
 static int _gather_set(lco_t *lco, int size, const void *from) {
   // can't call set on an gather
@@ -266,6 +371,7 @@ static const lco_class_t _gather_vtable = {
   .on_error    = _gather_error,
   .on_set      = _gather_set,
   .on_attach   = _gather_attach,
+  .on_detach   = _gather_detach,
   .on_get      = _gather_get,
   .on_getref   = _gather_getref,
   .on_release  = _gather_release,
@@ -287,6 +393,8 @@ static int _gather_init_handler(_gather_t *g, int writers, int readers,
   g->wcount = 0;
   g->rcount = readers;
   g->value = NULL;
+  g->head = NULL;
+  g->tail = NULL;
 
   if (size) {
     // Ultimately, g->value points to start of the array containing the
@@ -127,6 +127,12 @@ static hpx_status_t _attach(lco_t *lco, hpx_parcel_t *p) {
   return class->on_attach(lco, p);
 }
 
+static hpx_parcel_t *_detach(lco_t *lco, cvar_match_t match, const void *env) {
+  const lco_class_t *class = _class(lco);
+  dbg_assert_str(class->on_detach, "LCO has no on_detach handler\n");
+  return class->on_detach(lco, match, env);
+}
+
 /// Action LCO event handler wrappers.
 ///
 /// These try and pin the LCO, and then forward to the local event handler
@@ -674,6 +680,320 @@ int hpx_lco_get_all(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
   return errors;
 }
 
+/// The state for draining a set of LCOs in completion order.
+///
+/// Rather than blocking one thread per LCO, we attach a small trigger parcel to
+/// each LCO in the set. When an LCO is set (or fails) its trigger reads the
+/// status at the LCO and pushes its index onto the shared completion queue,
+/// signaling the single condition variable that the draining thread waits on.
+///
+/// Deleting the set detaches the triggers that haven't fired yet, and then
+/// waits for the ones that are already running to report, so that nothing
+/// refers to the LCOs or to the set once it is gone. The lcos array holds the
+/// LCOs whose triggers haven't reported, and pending counts them.
+struct hpx_lco_any {
+  tatas_lock_t    lock;
+  cvar_t         ready;
+  int              n;
+  int          pending;
+  int          watched;
+  int         consumed;
+  int             head;
+  int             tail;
+  hpx_addr_t     *lcos;
+  struct {
+    int              i;
+    hpx_status_t status;
+  } completed[];
+};
+
+/// The arguments to a trigger, which identify it when it is detached.
+typedef struct {
+  hpx_lco_any_t *any;
+  int              i;
+  hpx_addr_t     src;
+} _any_trigger_args_t;
+
+/// The completion queue lock must be acquired like an LCO lock, as we wait on
+/// its condition with scheduler_wait().
+static void _any_lock(hpx_lco_any_t *any) {
+  dbg_assert(self->current->ustack->lco_depth == 0);
+  self->current->ustack->lco_depth = 1;
+  sync_tatas_acquire(&any->lock);
+}
+
+static void _any_unlock(hpx_lco_any_t *any) {
+  sync_tatas_release(&any->lock);
+  dbg_assert(self->current->ustack->lco_depth == 1);
+  self->current->ustack->lco_depth = 0;
+}
+
+/// Record that the @p i'th trigger won't report, and wake the owner.
+static void _any_cancel(hpx_lco_any_t *any, int i) {
+  _any_lock(any);
+  dbg_assert(any->lcos[i] != HPX_NULL);
+  any->lcos[i] = HPX_NULL;
+  any->pending--;
+  scheduler_signal(&any->ready);
+  _any_unlock(any);
+}
+
+/// Record the completion of the @p i'th LCO.
+static void _any_push(hpx_lco_any_t *any, int i, hpx_status_t status) {
+  _any_lock(any);
+  dbg_assert(any->tail < any->watched);
+  dbg_assert(any->lcos[i] != HPX_NULL);
+  any->completed[any->tail].i = i;
+  any->completed[any->tail].status = status;
+  any->tail++;
+  any->lcos[i] = HPX_NULL;
+  any->pending--;
+  scheduler_signal(&any->ready);
+  _any_unlock(any);
+}
+
+static int _lco_any_notify_handler(hpx_lco_any_t *any, int i,
+                                   hpx_status_t status) {
+  _any_push(any, i, status);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_DEFAULT, 0, _lco_any_notify, _lco_any_notify_handler,
+                     HPX_POINTER, HPX_INT, HPX_INT);
+
+static int _lco_any_cancel_handler(hpx_lco_any_t *any, int i) {
+  _any_cancel(any, i);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_DEFAULT, 0, _lco_any_cancel, _lco_any_cancel_handler,
+                     HPX_POINTER, HPX_INT);
+
+/// The trigger runs at the LCO once it has been set, so waiting here doesn't
+/// block and just reads the LCO's status.
+static int _lco_any_trigger_handler(lco_t *lco, void *data, size_t n) {
+  _any_trigger_args_t *args = data;
+  hpx_status_t status = _wait(lco, 0);
+  if (args->src == HPX_HERE) {
+    _any_push(args->any, args->i, status);
+    return HPX_SUCCESS;
+  }
+  return hpx_call(args->src, _lco_any_notify, HPX_NULL, &args->any, &args->i,
+                  &status);
+}
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, _lco_any_trigger,
+                     _lco_any_trigger_handler, HPX_POINTER, HPX_POINTER,
+                     HPX_SIZE_T);
+
+/// Attach the trigger for the @p i'th LCO in @p any to the local @p lco.
+static void _any_watch(lco_t *lco, hpx_addr_t target, hpx_lco_any_t *any,
+                       int i, hpx_addr_t src) {
+  // The parcel would only refer to an argument buffer until it is sent, so we
+  // write the arguments into the parcel directly.
+  hpx_parcel_t *p = action_new_parcel(_lco_any_trigger, target, 0, 0, 2, NULL,
+                                      sizeof(_any_trigger_args_t));
+  _any_trigger_args_t *args = hpx_parcel_get_data(p);
+  args->any = any;
+  args->i = i;
+  args->src = src;
+  // LCOs that are already in an error state refuse attachments, in which case
+  // we just run the trigger to report the error.
+  if (_attach(lco, p) != HPX_SUCCESS) {
+    hpx_parcel_send(p, HPX_NULL);
+  }
+}
+
+static int _lco_any_watch_handler(lco_t *lco, hpx_lco_any_t *any, int i,
+                                  hpx_addr_t src) {
+  _any_watch(lco, hpx_thread_current_target(), any, i, src);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, _lco_any_watch,
+                     _lco_any_watch_handler, HPX_POINTER, HPX_POINTER,
+                     HPX_INT, HPX_ADDR);
+
+static bool _any_match(const hpx_parcel_t *p, const void *env) {
+  if (p->action != _lco_any_trigger) {
+    return false;
+  }
+  const _any_trigger_args_t *key = env;
+  const _any_trigger_args_t *args = hpx_parcel_get_data((hpx_parcel_t*)p);
+  return (args->any == key->any && args->i == key->i);
+}
+
+/// Detach the trigger for the @p i'th LCO in @p any from the local @p lco.
+///
+/// If the trigger isn't attached any more then it has fired, and will report
+/// to @p any itself.
+static void _any_unwatch(lco_t *lco, hpx_lco_any_t *any, int i,
+                         hpx_addr_t src) {
+  _any_trigger_args_t key = {
+    .any = any,
+    .i = i,
+    .src = src
+  };
+  hpx_parcel_t *p = _detach(lco, _any_match, &key);
+  if (!p) {
+    return;
+  }
+
+  parcel_delete(p);
+  if (src == HPX_HERE) {
+    _any_cancel(any, i);
+  }
+  else {
+    int e = hpx_call(src, _lco_any_cancel, HPX_NULL, &any, &i);
+    dbg_check(e, "could not report detached trigger\n");
+  }
+}
+
+static int _lco_any_unwatch_handler(lco_t *lco, hpx_lco_any_t *any, int i,
+                                    hpx_addr_t src) {
+  _any_unwatch(lco, any, i, src);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, _lco_any_unwatch,
+                     _lco_any_unwatch_handler, HPX_POINTER, HPX_POINTER,
+                     HPX_INT, HPX_ADDR);
+
+hpx_lco_any_t *hpx_lco_any_new(int n, hpx_addr_t lcos[]) {
+  dbg_assert(n > 0);
+
+  hpx_lco_any_t *any = malloc(sizeof(*any) + n * sizeof(any->completed[0]));
+  dbg_assert_str(any, "failed to allocate completion set for %d elements", n);
+  any->lcos = malloc(n * sizeof(any->lcos[0]));
+  dbg_assert_str(any->lcos, "failed to allocate completion set for %d elements",
+                 n);
+  sync_tatas_init(&any->lock);
+  cvar_reset(&any->ready);
+  any->n = n;
+  any->watched = 0;
+  any->consumed = 0;
+  any->head = 0;
+  any->tail = 0;
+  for (int i = 0; i < n; ++i) {
+    any->lcos[i] = lcos[i];
+    any->watched += (lcos[i] != HPX_NULL);
+  }
+
+  // The pending count has to be in place before we start attaching triggers,
+  // as local LCOs that are already set will trigger immediately.
+  any->pending = any->watched;
+
+  // Remote triggers must be attached before we return, so that a delete can't
+  // overtake them and miss the trigger that it needs to detach. The sync LCO
+  // is created for the remaining LCOs at the first remote one, and the local
+  // LCOs after that are accounted for at the end.
+  hpx_addr_t sync = HPX_NULL;
+  int remaining = any->watched;
+  int skipped = 0;
+  hpx_addr_t src = HPX_HERE;
+  lco_t *lco = NULL;
+  for (int i = 0; i < n; ++i) {
+    if (lcos[i] == HPX_NULL) {
+      continue;
+    }
+
+    if (hpx_gas_try_pin(lcos[i], (void**)&lco)) {
+      _any_watch(lco, lcos[i], any, i, src);
+      hpx_gas_unpin(lcos[i]);
+      skipped += (sync != HPX_NULL);
+    }
+    else {
+      if (!sync) {
+        sync = hpx_lco_and_new(remaining);
+      }
+      int e = hpx_call(lcos[i], _lco_any_watch, sync, &any, &i, &src);
+      dbg_check(e, "could not forward lco watch\n");
+    }
+    --remaining;
+  }
+
+  if (sync) {
+    if (skipped) {
+      hpx_lco_and_set_num(sync, skipped, HPX_NULL);
+    }
+    hpx_lco_wait(sync);
+    hpx_lco_delete(sync, HPX_NULL);
+  }
+  return any;
+}
+
+int hpx_lco_any_next(hpx_lco_any_t *any, hpx_status_t *status) {
+  dbg_assert(any);
+
+  _any_lock(any);
+  if (any->consumed == any->watched) {
+    _any_unlock(any);
+    return -1;
+  }
+  any->consumed++;
+
+  while (any->head == any->tail) {
+    scheduler_wait(&any->lock, &any->ready);
+  }
+
+  int i = any->completed[any->head].i;
+  if (status) {
+    *status = any->completed[any->head].status;
+  }
+  any->head++;
+  _any_unlock(any);
+  return i;
+}
+
+void hpx_lco_any_delete(hpx_lco_any_t *any) {
+  if (!any) {
+    return;
+  }
+
+  hpx_addr_t src = HPX_HERE;
+  lco_t *lco = NULL;
+  for (int i = 0, e = any->n; i < e; ++i) {
+    hpx_addr_t addr = sync_load(&any->lcos[i], SYNC_ACQUIRE);
+    if (addr == HPX_NULL) {
+      continue;
+    }
+
+    if (hpx_gas_try_pin(addr, (void**)&lco)) {
+      _any_unwatch(lco, any, i, src);
+      hpx_gas_unpin(addr);
+    }
+    else {
+      int e = hpx_call(addr, _lco_any_unwatch, HPX_NULL, &any, &i, &src);
+      dbg_check(e, "could not forward lco unwatch\n");
+    }
+  }
+
+  // Wait for every trigger to report that it has fired or been detached.
+  _any_lock(any);
+  while (any->pending) {
+    scheduler_wait(&any->lock, &any->ready);
+  }
+  _any_unlock(any);
+  free(any->lcos);
+  free(any);
+}
+
+int hpx_lco_wait_any(int n, hpx_addr_t lcos[], hpx_status_t *status) {
+  hpx_lco_any_t *any = hpx_lco_any_new(n, lcos);
+  int i = hpx_lco_any_next(any, status);
+  hpx_lco_any_delete(any);
+  return i;
+}
+
+int hpx_lco_get_any(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
+                    hpx_status_t *status) {
+  hpx_status_t e = HPX_SUCCESS;
+  int i = hpx_lco_wait_any(n, lcos, &e);
+  if (i >= 0 && e == HPX_SUCCESS && sizes[i]) {
+    e = hpx_lco_get(lcos[i], sizes[i], values[i]);
+  }
+
+  if (status) {
+    *status = e;
+  }
+  return i;
+}
+
 int hpx_lco_delete_all(int n, hpx_addr_t *lcos, hpx_addr_t rsync) {
   hpx_addr_t and = HPX_NULL;
   if (rsync) {
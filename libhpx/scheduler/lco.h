@@ -60,6 +60,8 @@ typedef hpx_status_t (*lco_getref_t)(lco_t *lco, int size, void **out, int *unpi
 typedef int (*lco_release_t)(lco_t *lco, void *out);
 typedef hpx_status_t (*lco_wait_t)(lco_t *lco, int reset);
 typedef hpx_status_t (*lco_attach_t)(lco_t *lco, hpx_parcel_t *p);
+typedef hpx_parcel_t *(*lco_detach_t)(lco_t *lco, cvar_match_t match,
+                                      const void *env);
 typedef void (*lco_reset_t)(lco_t *lco);
 typedef size_t (*lco_size_t)(lco_t *lco);
 
@@ -70,6 +72,7 @@ struct lco_class {
   lco_error_t       on_error;
   lco_set_t           on_set;
   lco_attach_t     on_attach;
+  lco_detach_t     on_detach;
   lco_get_t           on_get;
   lco_getref_t     on_getref;
   lco_release_t   on_release;
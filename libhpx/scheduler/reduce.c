@@ -103,6 +103,15 @@ static hpx_status_t _reduce_attach(lco_t *lco, hpx_parcel_t *p) {
   return status;
 }
 
+static hpx_parcel_t *_reduce_detach(lco_t *lco, cvar_match_t match,
+                                    const void *env) {
+  lco_lock(lco);
+  _reduce_t *r = (_reduce_t *)lco;
+  hpx_parcel_t *p = cvar_detach(&r->barrier, match, env);
+  lco_unlock(lco);
+  return p;
+}
+
 /// Handle an error condition.
 static void _reduce_error(lco_t *lco, hpx_status_t code) {
   lco_lock(lco);
@@ -215,6 +224,7 @@ static const lco_class_t _reduce_vtable = {
   .on_error    = _reduce_error,
   .on_set      = _reduce_set,
   .on_attach   = _reduce_attach,
+  .on_detach   = _reduce_detach,
   .on_get      = _reduce_get,
   .on_getref   = _reduce_getref,
   .on_release  = _reduce_release,
@@ -18,61 +18,193 @@
 #include "apex.h"
 #endif
 
+#include <pthread.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
+#include <hpx/builtins.h>
 #include <hpx/hpx.h>
 #include <libsync/sync.h>
 #include <libsync/locks.h>
+#include <libhpx/action.h>
 #include <libhpx/config.h>
+#include <libhpx/debug.h>
+#include <libhpx/libhpx.h>
 #include <libhpx/scheduler.h>
 #include <libhpx/locality.h>
 #include <libhpx/stats.h>
+#include <libhpx/system.h>
 
 static libhpx_stats_t _global_stats = LIBHPX_STATS_INIT;
 
+/// The statistics export thread's state.
+static struct {
+  pthread_t     thread;
+  char         *path;
+  char          *tmp;
+  unsigned  interval;
+  volatile int running;
+} _export = {
+  .path = NULL,
+  .tmp = NULL,
+  .interval = 0,
+  .running = 0
+};
+
 void libhpx_stats_init(struct libhpx_stats *stats) {
-  stats->spawns        = 0;
-  stats->failed_steals = 0;
-  stats->steals        = 0;
-  stats->mail          = 0;
-  stats->stacks        = 0;
-  stats->yields        = 0;
+#define LIBHPX_STAT(id) stats->id = 0;
+# include "libhpx/stats.def"
+#undef LIBHPX_STAT
 }
 
 struct libhpx_stats *libhpx_stats_accum(struct libhpx_stats *lhs,
                                         const struct libhpx_stats *rhs)
 {
-  lhs->spawns        += rhs->spawns;
-  lhs->failed_steals += rhs->failed_steals;
-  lhs->steals        += rhs->steals;
-  lhs->stacks        += rhs->stacks;
-  lhs->mail          += rhs->mail;
-  lhs->yields        += rhs->yields;
-
+#define LIBHPX_STAT(id) lhs->id += rhs->id;
+# include "libhpx/stats.def"
+#undef LIBHPX_STAT
   return lhs;
 }
 
+void libhpx_stats_collect(struct libhpx_stats *total) {
+  libhpx_stats_init(total);
+  for (int i = 0, e = here->sched->n_workers; i < e; ++i) {
+    worker_t *w = scheduler_get_worker(here->sched, i);
+    libhpx_stats_accum(total, &w->stats);
+  }
+}
+
+/// Get the calling worker's per-action statistics, allocating them on first
+/// use. Threads that are not HPX workers don't record per-action statistics.
+static libhpx_action_stats_t *_action_stats(hpx_action_t id) {
+  worker_t *w = self;
+  if (!w || id >= action_table_size()) {
+    return NULL;
+  }
+
+  libhpx_action_stats_t *stats = w->action_stats;
+  if (unlikely(!stats)) {
+    stats = calloc(action_table_size(), sizeof(*stats));
+    dbg_assert(stats);
+    w->action_stats = stats;
+  }
+  return &stats[id];
+}
+
+uint64_t libhpx_action_stats_start(void) {
+  if (likely(!here->config->stats_actions)) {
+    return 0;
+  }
+  return hpx_time_from_start_ns(hpx_time_now());
+}
+
+void libhpx_action_stats_exec(hpx_action_t id, uint64_t start) {
+  if (likely(!start)) {
+    return;
+  }
+
+  libhpx_action_stats_t *stats = _action_stats(id);
+  if (!stats) {
+    return;
+  }
+
+  uint64_t ns = hpx_time_from_start_ns(hpx_time_now()) - start;
+  int bucket = (ns) ? 63 - clzl(ns) : 0;
+  if (bucket >= LIBHPX_ACTION_STATS_BUCKETS) {
+    bucket = LIBHPX_ACTION_STATS_BUCKETS - 1;
+  }
+  stats->count++;
+  stats->time += ns;
+  stats->hist[bucket]++;
+}
+
+void libhpx_action_stats_blocked(hpx_action_t id, uint64_t start) {
+  if (likely(!start)) {
+    return;
+  }
+
+  libhpx_action_stats_t *stats = _action_stats(id);
+  if (stats) {
+    stats->blocked += hpx_time_from_start_ns(hpx_time_now()) - start;
+  }
+}
+
+void libhpx_action_stats_collect(libhpx_action_stats_t *total) {
+  int n = action_table_size();
+  memset(total, 0, n * sizeof(*total));
+  for (int i = 0, e = here->sched->n_workers; i < e; ++i) {
+    worker_t *w = scheduler_get_worker(here->sched, i);
+    const libhpx_action_stats_t *stats = w->action_stats;
+    if (!stats) {
+      continue;
+    }
+    for (int j = 0; j < n; ++j) {
+      total[j].count += stats[j].count;
+      total[j].time += stats[j].time;
+      total[j].blocked += stats[j].blocked;
+      for (int k = 0; k < LIBHPX_ACTION_STATS_BUCKETS; ++k) {
+        total[j].hist[k] += stats[j].hist[k];
+      }
+    }
+  }
+}
+
+/// Write the merged per-action statistics, one action per line.
+///
+/// Each line contains the action's name, count, total and mean execution time,
+/// blocked time, and the non-empty histogram buckets as log2(ns):count pairs.
+static void _print_action_stats(FILE *f, const char *prefix) {
+  int n = action_table_size();
+  libhpx_action_stats_t *total = malloc(n * sizeof(*total));
+  dbg_assert(total);
+  libhpx_action_stats_collect(total);
+
+  for (int i = 0; i < n; ++i) {
+    const libhpx_action_stats_t *stats = &total[i];
+    if (!stats->count && !stats->blocked) {
+      continue;
+    }
+    unsigned long mean = (stats->count) ? stats->time / stats->count : 0;
+    fprintf(f, "%saction %s, count: %lu, time: %lu, mean: %lu, blocked: %lu,"
+            " hist:", prefix, actions[i].key, stats->count, stats->time, mean,
+            stats->blocked);
+    for (int k = 0; k < LIBHPX_ACTION_STATS_BUCKETS; ++k) {
+      if (stats->hist[k]) {
+        fprintf(f, " %d:%lu", k, stats->hist[k]);
+      }
+    }
+    fprintf(f, "\n");
+  }
+  free(total);
+}
+
 void _print_stats(const char *id, const struct libhpx_stats *counts)
 {
-#ifdef ENABLE_PROFILING
   if (!here || !counts)
     return;
 
   printf("node %d, ", here->rank);
-  printf("worker %s, ", id);
-  printf("yields: %lu, ", counts->yields);
-  printf("spawns: %lu, ", counts->spawns);
-  printf("failed steals: %lu, ", counts->failed_steals);
-  printf("steals: %lu, ", counts->steals);
-  printf("stacks: %lu, ", counts->stacks);
-  printf("mail: %lu, ", counts->mail);
+  printf("worker %s", id);
+#define LIBHPX_STAT(id) printf(", %s: %lu", #id, counts->id);
+# include "libhpx/stats.def"
+#undef LIBHPX_STAT
   printf("\n");
   fflush(stdout);
-#endif
 }
 
 void libhpx_stats_print(void) {
+  if (!here->sched) {
+    return;
+  }
+
+  if (here->config->stats_actions) {
+    char prefix[32];
+    snprintf(prefix, sizeof(prefix), "node %d, ", here->rank);
+    _print_action_stats(stdout, prefix);
+    fflush(stdout);
+  }
+
   if (!here->config->statistics) {
     return;
   }
@@ -82,14 +214,118 @@ void libhpx_stats_print(void) {
     worker_t *w = scheduler_get_worker(here->sched, i);
     snprintf(id, 16, "%d", w->id);
     _print_stats(id, &w->stats);
-    libhpx_stats_accum(&_global_stats, &w->stats);
   }
 
+  libhpx_stats_collect(&_global_stats);
   _print_stats("<totals>", &_global_stats);
 }
 
+/// Write one line of counters to the export file.
+static void _export_line(FILE *f, const char *id,
+                         const struct libhpx_stats *counts) {
+  fprintf(f, "%-10s", id);
+#define LIBHPX_STAT(id) fprintf(f, " %lu", counts->id);
+# include "libhpx/stats.def"
+#undef LIBHPX_STAT
+  fprintf(f, "\n");
+}
+
+/// Write the current statistics to a temporary file and move it into place,
+/// so that readers always see a complete snapshot.
+static void _export_write(void) {
+  FILE *f = fopen(_export.tmp, "w");
+  if (!f) {
+    log_error("failed to open statistics file %s\n", _export.tmp);
+    return;
+  }
+
+  double now = hpx_time_from_start_ns(hpx_time_now()) / 1e9;
+  fprintf(f, "# rank %d workers %d time %.3f\n", here->rank,
+          here->sched->n_workers, now);
+  fprintf(f, "%-10s", "# worker");
+#define LIBHPX_STAT(id) fprintf(f, " %s", #id);
+# include "libhpx/stats.def"
+#undef LIBHPX_STAT
+  fprintf(f, "\n");
+
+  libhpx_stats_t total;
+  libhpx_stats_init(&total);
+  char id[16] = {0};
+  for (int i = 0, e = here->sched->n_workers; i < e; ++i) {
+    worker_t *w = scheduler_get_worker(here->sched, i);
+    snprintf(id, 16, "%d", w->id);
+    _export_line(f, id, &w->stats);
+    libhpx_stats_accum(&total, &w->stats);
+  }
+  _export_line(f, "total", &total);
+
+  if (here->config->stats_actions) {
+    fprintf(f, "# actions (times in ns, histogram buckets are log2(ns))\n");
+    _print_action_stats(f, "");
+  }
+
+  if (fclose(f)) {
+    log_error("failed to write statistics file %s\n", _export.tmp);
+    return;
+  }
+  if (rename(_export.tmp, _export.path)) {
+    log_error("failed to move statistics file into %s\n", _export.path);
+  }
+}
+
+static void *_export_thread(void *UNUSED) {
+  while (sync_load(&_export.running, SYNC_ACQUIRE)) {
+    _export_write();
+    for (unsigned ms = 0; ms < _export.interval; ms += 10) {
+      if (!sync_load(&_export.running, SYNC_ACQUIRE)) {
+        break;
+      }
+      system_usleep(10000);
+    }
+  }
+  return NULL;
+}
+
+int libhpx_stats_export_start(const struct config *cfg) {
+  if (!cfg->stats_file || _export.running) {
+    return LIBHPX_OK;
+  }
+
+  size_t n = strlen(cfg->stats_file) + 32;
+  _export.path = malloc(n);
+  _export.tmp = malloc(n);
+  dbg_assert(_export.path && _export.tmp);
+  snprintf(_export.path, n, "%s.%d", cfg->stats_file, here->rank);
+  snprintf(_export.tmp, n, "%s.%d.tmp", cfg->stats_file, here->rank);
+  _export.interval = (cfg->stats_interval > 0) ? cfg->stats_interval : 1000;
+
+  sync_store(&_export.running, 1, SYNC_RELEASE);
+  if (pthread_create(&_export.thread, NULL, _export_thread, NULL)) {
+    _export.running = 0;
+    return log_error("failed to start the statistics export thread\n");
+  }
+  return LIBHPX_OK;
+}
+
+void libhpx_stats_export_stop(void) {
+  if (!sync_load(&_export.running, SYNC_ACQUIRE)) {
+    return;
+  }
+
+  sync_store(&_export.running, 0, SYNC_RELEASE);
+  if (pthread_join(_export.thread, NULL)) {
+    log_error("failed to join the statistics export thread\n");
+  }
+  _export_write();
+  free(_export.path);
+  free(_export.tmp);
+  _export.path = NULL;
+  _export.tmp = NULL;
+}
+
 void libhpx_save_apex_stats(void) {
 #ifdef HAVE_APEX
+  libhpx_stats_collect(&_global_stats);
   apex_sample_value("yields", (double)_global_stats.yields);
   apex_sample_value("spawns", (double)_global_stats.spawns);
   apex_sample_value("failed steals", (double)_global_stats.failed_steals);
@@ -155,6 +155,15 @@ static hpx_status_t _user_lco_attach(lco_t *lco, hpx_parcel_t *p) {
   return status;
 }
 
+static hpx_parcel_t *_user_lco_detach(lco_t *lco, cvar_match_t match,
+                                      const void *env) {
+  lco_lock(lco);
+  _user_lco_t *u = (_user_lco_t *)lco;
+  hpx_parcel_t *p = cvar_detach(&u->cvar, match, env);
+  lco_unlock(lco);
+  return p;
+}
+
 static hpx_status_t _wait(_user_lco_t *u) {
   if (!lco_get_triggered(&u->lco))
     return scheduler_wait(&u->lco.lock, &u->cvar);
@@ -233,6 +242,7 @@ static const lco_class_t _user_lco_vtable = {
   .on_error    = _user_lco_error,
   .on_set      = _user_lco_set,
   .on_attach   = _user_lco_attach,
+  .on_detach   = _user_lco_detach,
   .on_get      = _user_lco_get,
   .on_getref   = _user_lco_getref,
   .on_release  = _user_lco_release,
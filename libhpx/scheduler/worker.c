@@ -170,7 +170,9 @@ static void _execute_interrupt(hpx_parcel_t *p) {
   EVENT_THREAD_SUSPEND(q, w);
   EVENT_THREAD_RUN(p, w);
 
+  uint64_t start = libhpx_action_stats_start();
   int e = action_exec_parcel(p->action, p);
+  libhpx_action_stats_exec(p->action, start);
 
   switch (e) {
    case HPX_SUCCESS:
@@ -232,6 +234,7 @@ static hpx_parcel_t *_try_bind(worker_t *w, hpx_parcel_t *p) {
   }
 
   // try and get a stack from the freelist, otherwise allocate a new one
+  COUNTER_SAMPLE(++w->stats.stacks);
   ustack_t *stack = w->stacks;
   if (stack) {
     w->stacks = stack->next;
@@ -239,6 +242,7 @@ static hpx_parcel_t *_try_bind(worker_t *w, hpx_parcel_t *p) {
     thread_init(stack, p, worker_execute_thread, stack->size);
   }
   else {
+    COUNTER_SAMPLE(++w->stats.stack_misses);
     stack = thread_new(p, worker_execute_thread);
   }
 
@@ -557,6 +561,8 @@ static void _schedule_network(worker_t *w) {
   hpx_parcel_t *p = NULL;
   while ((p = parcel_stack_pop(&stack))) {
     EVENT_PARCEL_RECV(p->id, p->action, p->size, p->src, p->target);
+    COUNTER_SAMPLE(++w->stats.parcels_recv);
+    COUNTER_SAMPLE(w->stats.bytes_recv += parcel_size(p));
     _push_lifo(p, w);
   }
 }
@@ -654,6 +660,8 @@ int worker_init(worker_t *w, int id, unsigned seed, unsigned work_size) {
   w->nstacks     = 0;
   w->yielded     = 0;
   w->last_victim = -1;
+  w->numa_node   = here->topology->cpu_to_numa[id % here->topology->ncpus];
+  w->interrupts  = 0;
   w->system      = NULL;
   w->current     = NULL;
   w->stacks      = NULL;
@@ -661,6 +669,9 @@ int worker_init(worker_t *w, int id, unsigned seed, unsigned work_size) {
   w->active      = true;
   w->profiler    = NULL;
   w->bst         = NULL;
+  w->tcache      = NULL;
+  w->action_stats = NULL;
+  w->compress    = NULL;
   w->network     = here->net;
 
   sync_chase_lev_ws_deque_init(&w->queues[0].work, work_size);
@@ -691,6 +702,18 @@ void worker_fini(worker_t *w) {
     w->stacks = stack->next;
     thread_delete(stack);
   }
+
+  // and delete the translation cache
+  free(w->tcache);
+  w->tcache = NULL;
+
+  // and delete the per-action statistics
+  free(w->action_stats);
+  w->action_stats = NULL;
+
+  // and delete the compression scratch buffer
+  free(w->compress);
+  w->compress = NULL;
 }
 
 static void _null(hpx_parcel_t *p, void *env) {
@@ -716,9 +739,6 @@ int worker_start(void) {
              "This MAY result in diminished performance.\n");
   }
 
-  int cpu = w->id % here->topology->ncpus;
-  w->numa_node = here->topology->cpu_to_numa[cpu];
-
   // allocate a parcel and a stack header for the system stack
   hpx_parcel_t p;
   parcel_init(0, 0, 0, 0, 0, NULL, 0, &p);
@@ -782,6 +802,39 @@ void scheduler_spawn_at(hpx_parcel_t *p, int thread) {
   _send_mail(p, w);
 }
 
+/// The maximum depth of interrupts that we run inline, so that chains of calls
+/// from interrupts to interrupts can't grow the stack without bound.
+#define _INTERRUPT_DEPTH_MAX 8
+
+// Check if the calling thread can run an interrupt inline.
+int scheduler_can_run_interrupt(void) {
+  worker_t *w = self;
+  if (!w || w->id < 0 || !w->current) {
+    return 0;
+  }
+
+  // Interrupts have function call semantics, so unlike scheduler_spawn() we
+  // don't need to be in work-first mode to run one. We can't be inside the
+  // network (work_first < 0), holding an LCO lock, shutting down, or too deep
+  // in nested interrupts though.
+  if (w->work_first < 0 || w->interrupts >= _INTERRUPT_DEPTH_MAX) {
+    return 0;
+  }
+  return (!worker_is_stopped() && !w->current->ustack->lco_depth);
+}
+
+// Run a local interrupt parcel inline.
+void scheduler_run_interrupt(hpx_parcel_t *p) {
+  dbg_assert(p);
+  dbg_assert(action_is_interrupt(p->action));
+  dbg_assert(scheduler_can_run_interrupt());
+  worker_t *w = self;
+  COUNTER_SAMPLE(w->stats.spawns++);
+  w->interrupts++;
+  _execute_interrupt(p);
+  w->interrupts--;
+}
+
 // Spawn a parcel.
 // This complicated function does a bunch of logic to figure out the proper
 // method of computation for the parcel.
@@ -898,8 +951,11 @@ hpx_status_t scheduler_wait(tatas_lock_t *lock, cvar_t *condition) {
     return status;
   }
 
+  COUNTER_SAMPLE(++w->stats.lco_waits);
   EVENT_THREAD_SUSPEND(p, w);
+  uint64_t start = libhpx_action_stats_start();
   _schedule(_unlock, (void*)lock, 0);
+  libhpx_action_stats_blocked(p->action, start);
   EVENT_THREAD_RESUME(p, self);
 
   // reacquire the lco lock before returning
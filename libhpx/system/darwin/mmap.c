@@ -20,6 +20,7 @@
 #include <string.h>
 #include <sys/mman.h>
 #include <libhpx/debug.h>
+#include <libhpx/libhpx.h>
 #include <libhpx/system.h>
 
 /// A simple mmap wrapper that guarantees alignment.
@@ -104,6 +105,34 @@ void *system_mmap_huge_pages(void *UNUSED, void *addr, size_t n, size_t align) {
   return system_mmap(UNUSED, addr, n, align);
 }
 
+size_t system_mmap_page_size(const void *addr) {
+  return HPX_PAGE_SIZE;
+}
+
+void *system_mmap_reserve(void *addr, size_t n, size_t align) {
+  static const int flags = MAP_ANON | MAP_PRIVATE | MAP_NORESERVE;
+  return _mmap_lucky(addr, n, PROT_NONE, flags, -1, 0, align);
+}
+
+int system_mmap_commit(void *addr, size_t n) {
+  static const  int prot = PROT_READ | PROT_WRITE;
+  static const int flags = MAP_ANON | MAP_PRIVATE | MAP_FIXED;
+  if (mmap(addr, n, prot, flags, -1, 0) == MAP_FAILED) {
+    log_error("could not commit %zu bytes at %"PRIuPTR": %s\n", n,
+              (uintptr_t)addr, strerror(errno));
+    return LIBHPX_ENOMEM;
+  }
+  return LIBHPX_OK;
+}
+
+void system_mmap_decommit(void *addr, size_t n) {
+  static const int flags = MAP_ANON | MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE;
+  if (mmap(addr, n, PROT_NONE, flags, -1, 0) == MAP_FAILED) {
+    dbg_error("could not decommit %zu bytes at %"PRIuPTR": %s\n", n,
+              (uintptr_t)addr, strerror(errno));
+  }
+}
+
 void system_munmap(void *UNUSED, void *addr, size_t size) {
   int e = munmap(addr, size);
   if (e < 0) {
@@ -21,11 +21,16 @@
 # include <hugetlbfs.h>
 #endif
 #include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 #include <sys/mman.h>
 #include <libsync/sync.h>
+#include <libhpx/config.h>
 #include <libhpx/debug.h>
+#include <libhpx/libhpx.h>
+#include <libhpx/locality.h>
 #include <libhpx/system.h>
 
 /// We use the hugetlbfs interface. In order to avoid locking around the huge
@@ -135,6 +140,224 @@ static void *_mmap_lucky(void *addr, size_t n, int prot, int flags, int fd,
   return _mmap_aligned(addr, n, prot, flags, fd, off, align);
 }
 
+/// Read a single "key value" line from a /proc or /sys file.
+///
+/// @param         path The file to read.
+/// @param          key The key to look for, including any trailing ':'.
+/// @param[out]     val The value, if found.
+///
+/// @returns            true if the key was found, false otherwise.
+static bool _read_proc_value(const char *path, const char *key, size_t *val) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    return false;
+  }
+
+  bool found = false;
+  size_t n = strlen(key);
+  char line[256];
+  while (!found && fgets(line, sizeof(line), f)) {
+    if (!strncmp(line, key, n)) {
+      found = (sscanf(line + n, "%zu", val) == 1);
+    }
+  }
+  fclose(f);
+  return found;
+}
+
+/// The size of the explicit huge pages used for MAP_HUGETLB mappings.
+static size_t _hugetlb_page_size(void) {
+  static size_t size = 0;
+  if (!size) {
+    size_t kb = 0;
+    if (_read_proc_value("/proc/meminfo", "Hugepagesize:", &kb) && kb) {
+      size = kb << 10;
+    }
+    else {
+      size = 1lu << 21;
+    }
+  }
+  return size;
+}
+
+/// The size of the transparent huge pages that the kernel will use.
+static size_t _thp_page_size(void) {
+  static size_t size = 0;
+  if (!size) {
+    const char *path = "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size";
+    FILE *f = fopen(path, "r");
+    if (!f || fscanf(f, "%zu", &size) != 1 || !size) {
+      size = 1lu << 21;
+    }
+    if (f) {
+      fclose(f);
+    }
+  }
+  return size;
+}
+
+/// Check if the kernel will honor MADV_HUGEPAGE.
+static bool _thp_enabled(void) {
+  const char *path = "/sys/kernel/mm/transparent_hugepage/enabled";
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    return false;
+  }
+  char mode[128] = {0};
+  char *line = fgets(mode, sizeof(mode), f);
+  fclose(f);
+  return (line && !strstr(mode, "[never]"));
+}
+
+/// Get the huge page policy for this locality.
+static libhpx_hugepages_t _policy(void) {
+  if (here && here->config) {
+    return here->config->hugepages;
+  }
+  return HPX_HUGEPAGES_DEFAULT;
+}
+
+/// Get the page size that a huge page @p policy uses, for padding.
+static size_t _policy_page_size(libhpx_hugepages_t policy) {
+  switch (policy) {
+   case HPX_HUGEPAGES_THP:
+    return _thp_page_size();
+   case HPX_HUGEPAGES_HUGETLB:
+    return _hugetlb_page_size();
+   case HPX_HUGEPAGES_DEFAULT:
+#ifdef HAVE_HUGETLBFS
+    return _hugepage_size;
+#endif
+   default:
+    return HPX_PAGE_SIZE;
+  }
+}
+
+/// Round @p n up to a multiple of the 2^k @p page size.
+static size_t _pad(size_t n, size_t page) {
+  return (n + page - 1) & ~(page - 1);
+}
+
+/// Check if memory logging is enabled, in which case we report every mapping.
+static bool _log_mem(void) {
+#ifdef ENABLE_LOGGING
+  return (here && here->config &&
+          config_log_level_isset(here->config, HPX_LOG_MEMORY));
+#else
+  return false;
+#endif
+}
+
+/// Report the page size that we actually got for a huge page mapping.
+///
+/// Finding the page size means reading /proc/self/smaps, so we only check the
+/// first mapping for each policy, or every mapping if memory logging is
+/// enabled. The first mapping is reported at the default log level, and a
+/// mapping that doesn't get the page size that was requested is reported as
+/// an error, because it usually means that the system has not reserved enough
+/// huge pages, or that transparent huge pages are disabled.
+static void _report(libhpx_hugepages_t policy, void *p, size_t n,
+                    size_t requested) {
+  static volatile int reported[HPX_HUGEPAGES_MAX] = {0};
+  bool first = !sync_swap(&reported[policy], 1, SYNC_RELAXED);
+  if (!first && !_log_mem()) {
+    return;
+  }
+
+  size_t page = system_mmap_page_size(p);
+  log_mem("mapped %zu bytes at %p with %zu byte pages\n", n, p, page);
+  if (page < requested) {
+    log_error("requested %s pages of %zu bytes for %zu bytes at %p, "
+              "got %zu byte pages\n", HPX_HUGEPAGES_TO_STRING[policy],
+              requested, n, p, page);
+  }
+  else if (first) {
+    log_dflt("using %s pages of %zu bytes for huge page allocations\n",
+             HPX_HUGEPAGES_TO_STRING[policy], page);
+  }
+}
+
+/// Map memory and request that it be backed by transparent huge pages.
+static void *_mmap_thp(void *addr, size_t n, size_t align) {
+  size_t page = _thp_page_size();
+  align = (align < page) ? page : align;
+  n = _pad(n, page);
+  void *p = system_mmap(NULL, addr, n, align);
+  if (madvise(p, n, MADV_HUGEPAGE)) {
+    log_error("madvise(MADV_HUGEPAGE) failed: %s\n", strerror(errno));
+  }
+  _report(HPX_HUGEPAGES_THP, p, n, page);
+  return p;
+}
+
+/// Map memory backed by explicit huge pages.
+///
+/// We reserve an aligned range of address space first and then replace it
+/// with the huge page mapping, so that we don't have to over-allocate huge
+/// pages (which are a scarce resource) in order to get the alignment. If the
+/// system doesn't have enough huge pages reserved we fall back to normal pages.
+static void *_mmap_hugetlb(void *addr, size_t n, size_t align) {
+  static const int prot = PROT_READ | PROT_WRITE;
+  static const int flags = MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED;
+  size_t page = _hugetlb_page_size();
+  align = (align < page) ? page : align;
+  n = _pad(n, page);
+  static const int reserve = MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE;
+  void *base = _mmap_lucky(addr, n, PROT_NONE, reserve, -1, 0, align);
+#ifdef MAP_HUGETLB
+  void *p = mmap(base, n, prot, flags | MAP_HUGETLB, -1, 0);
+#else
+  void *p = MAP_FAILED;
+  errno = ENOTSUP;
+#endif
+  if (p == MAP_FAILED) {
+    log_mem("MAP_HUGETLB mapping of %zu bytes failed: %s\n", n,
+            strerror(errno));
+    p = mmap(base, n, prot, flags, -1, 0);
+    if (p == MAP_FAILED) {
+      dbg_error("could not map %zu bytes at %p\n", n, base);
+    }
+  }
+  _report(HPX_HUGEPAGES_HUGETLB, p, n, page);
+  return p;
+}
+
+size_t system_mmap_page_size(const void *addr) {
+  FILE *f = fopen("/proc/self/smaps", "r");
+  if (!f) {
+    return HPX_PAGE_SIZE;
+  }
+
+  uintptr_t a = (uintptr_t)addr;
+  size_t page = HPX_PAGE_SIZE;
+  bool found = false;
+  char line[512];
+  while (fgets(line, sizeof(line), f)) {
+    uintptr_t start, end;
+    char perms[8];
+    if (sscanf(line, "%"SCNxPTR"-%"SCNxPTR" %7s", &start, &end, perms) == 3) {
+      if (found) {
+        break;
+      }
+      found = (start <= a && a < end);
+      continue;
+    }
+    if (!found) {
+      continue;
+    }
+    size_t kb;
+    if (sscanf(line, "KernelPageSize: %zu kB", &kb) == 1) {
+      page = kb << 10;
+    }
+    else if (!strncmp(line, "VmFlags:", 8) && strstr(line, " hg") &&
+             page < _thp_page_size() && _thp_enabled()) {
+      page = _thp_page_size();
+    }
+  }
+  fclose(f);
+  return page;
+}
+
 void *system_mmap(void *UNUSED, void *addr, size_t n, size_t align) {
   static const  int prot = PROT_READ | PROT_WRITE;
   static const int flags = MAP_ANONYMOUS | MAP_PRIVATE;
@@ -144,6 +367,17 @@ void *system_mmap(void *UNUSED, void *addr, size_t n, size_t align) {
 }
 
 void *system_mmap_huge_pages(void *UNUSED, void *addr, size_t n, size_t align) {
+  switch (_policy()) {
+   case HPX_HUGEPAGES_NONE:
+    return system_mmap(UNUSED, addr, n, align);
+   case HPX_HUGEPAGES_THP:
+    return _mmap_thp(addr, n, align);
+   case HPX_HUGEPAGES_HUGETLB:
+    return _mmap_hugetlb(addr, n, align);
+   default:
+    break;
+  }
+
 #ifndef HAVE_HUGETLBFS
   return system_mmap(UNUSED, addr, n, align);
 #else
@@ -173,6 +407,52 @@ void *system_mmap_huge_pages(void *UNUSED, void *addr, size_t n, size_t align) {
 #endif
 }
 
+void *system_mmap_reserve(void *addr, size_t n, size_t align) {
+  static const int flags = MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE;
+  void *p = _mmap_lucky(addr, n, PROT_NONE, flags, -1, 0, align);
+  log_mem("reserved %zu bytes at %p for a total of %zu\n", n, p,
+          _update_total(n));
+  return p;
+}
+
+int system_mmap_commit(void *addr, size_t n) {
+  static const  int prot = PROT_READ | PROT_WRITE;
+  static const int flags = MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED;
+  libhpx_hugepages_t policy = _policy();
+  void *p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  size_t page = _hugetlb_page_size();
+  if (policy == HPX_HUGEPAGES_HUGETLB && !((uintptr_t)addr & (page - 1)) &&
+      !(n & (page - 1))) {
+    p = mmap(addr, n, prot, flags | MAP_HUGETLB, -1, 0);
+  }
+#endif
+  if (p == MAP_FAILED) {
+    p = mmap(addr, n, prot, flags, -1, 0);
+  }
+  if (p == MAP_FAILED) {
+    log_error("could not commit %zu bytes at %p: %s\n", n, addr,
+              strerror(errno));
+    return LIBHPX_ENOMEM;
+  }
+  if (policy == HPX_HUGEPAGES_THP && madvise(p, n, MADV_HUGEPAGE)) {
+    log_error("madvise(MADV_HUGEPAGE) failed: %s\n", strerror(errno));
+  }
+  log_mem("committed %zu bytes at %p\n", n, p);
+  return LIBHPX_OK;
+}
+
+void system_mmap_decommit(void *addr, size_t n) {
+  static const int flags = MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED |
+                           MAP_NORESERVE;
+  void *p = mmap(addr, n, PROT_NONE, flags, -1, 0);
+  if (p == MAP_FAILED) {
+    dbg_error("could not decommit %zu bytes at %p: %s\n", n, addr,
+              strerror(errno));
+  }
+  log_mem("decommitted %zu bytes at %p\n", n, p);
+}
+
 void system_munmap(void *UNUSED, void *addr, size_t size) {
   int e = munmap(addr, size);
   if (e < 0) {
@@ -184,12 +464,6 @@ void system_munmap(void *UNUSED, void *addr, size_t size) {
 }
 
 void system_munmap_huge_pages(void *UNUSED, void *addr, size_t size) {
-#ifdef HAVE_HUGETLBFS
-  if (size & _hugepage_mask) {
-    long r = size & _hugepage_mask;
-    long padding = _hugepage_size - r;
-    size += padding;
-  }
-#endif
+  size = _pad(size, _policy_page_size(_policy()));
   system_munmap(UNUSED, addr, size);
 }
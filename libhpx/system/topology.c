@@ -244,6 +244,56 @@ topology_t *topology_new(const struct config *config) {
   return topo;
 }
 
+/// Set the memory binding policy for a range of memory to a nodeset.
+static int _set_area_membind(hwloc_topology_t hwloc, void *addr, size_t n,
+                             hwloc_const_nodeset_t nodes,
+                             hwloc_membind_policy_t policy, int flags) {
+#if HWLOC_API_VERSION >= 0x00020000
+  flags |= HWLOC_MEMBIND_BYNODESET;
+  return hwloc_set_area_membind(hwloc, addr, n, nodes, policy, flags);
+#else
+  return hwloc_set_area_membind_nodeset(hwloc, addr, n, nodes, policy, flags);
+#endif
+}
+
+int topology_set_membind(const topology_t *topology, void *addr, size_t n,
+                         libhpx_heap_numa_t policy, int node) {
+  if (policy == HPX_HEAP_NUMA_DEFAULT || topology->nnodes < 2) {
+    return LIBHPX_OK;
+  }
+
+  hwloc_topology_t hwloc = topology->hwloc_topology;
+  hwloc_nodeset_t nodes = hwloc_bitmap_dup(
+      hwloc_topology_get_topology_nodeset(hwloc));
+  hwloc_membind_policy_t membind = HWLOC_MEMBIND_DEFAULT;
+  int flags = 0;
+  switch (policy) {
+   case HPX_HEAP_NUMA_INTERLEAVE:
+    membind = HWLOC_MEMBIND_INTERLEAVE;
+    break;
+   case HPX_HEAP_NUMA_FIRSTTOUCH:
+    membind = HWLOC_MEMBIND_FIRSTTOUCH;
+    break;
+   case HPX_HEAP_NUMA_PARTITION:
+    // nodesets are indexed by os index, which is what we use for nodes
+    hwloc_bitmap_only(nodes, node);
+    membind = HWLOC_MEMBIND_BIND;
+    flags = HWLOC_MEMBIND_MIGRATE;
+    break;
+   default:
+    hwloc_bitmap_free(nodes);
+    return log_error("unknown NUMA placement policy %d\n", policy);
+  }
+
+  int e = _set_area_membind(hwloc, addr, n, nodes, membind, flags);
+  hwloc_bitmap_free(nodes);
+  if (e) {
+    return log_error("failed to set the %s NUMA policy for %zu bytes at %p\n",
+                     HPX_HEAP_NUMA_TO_STRING[policy], n, addr);
+  }
+  return LIBHPX_OK;
+}
+
 void topology_delete(topology_t *topology) {
   if (!topology) {
     return;
@@ -364,8 +364,12 @@ int bitmap_reserve(bitmap_t *map, uint32_t nbits, uint32_t align, uint32_t *i) {
   return LIBHPX_OK;
 }
 
-int bitmap_rreserve(bitmap_t *map, uint32_t nbits, uint32_t align, uint32_t *i)
-{
+/// Perform a reverse search for space.
+///
+/// @returns LIBHPX_OK, LIBHPX_EINVAL, or LIBHPX_ENOMEM if there is no space
+///          (without reporting it).
+static int _rreserve(bitmap_t *map, uint32_t nbits, uint32_t align,
+                     uint32_t *i) {
   log_gas("reverse search for %u blocks with alignment %u.\n", nbits,
               align);
   if (nbits == 0)
@@ -384,7 +388,8 @@ int bitmap_rreserve(bitmap_t *map, uint32_t nbits, uint32_t align, uint32_t *i)
       // shift down by the number of bits we matched in the last round
       uint32_t shift = nbits - matched;
       if (bit < shift) {
-        return _bitmap_oom(map, nbits, align);
+        sync_tatas_release(&map->lock);
+        return LIBHPX_ENOMEM;
       }
 
       bit = bit - shift;
@@ -394,7 +399,8 @@ int bitmap_rreserve(bitmap_t *map, uint32_t nbits, uint32_t align, uint32_t *i)
       uint32_t max = ctzl(val);
       while (align > max) {
         if (bit == 0) {
-          return _bitmap_oom(map, nbits, align);
+          sync_tatas_release(&map->lock);
+          return LIBHPX_ENOMEM;
         }
         bit -= 1;
         val = bit * (1ul << map->min_align) + (1ul << map->base_align);
@@ -402,7 +408,8 @@ int bitmap_rreserve(bitmap_t *map, uint32_t nbits, uint32_t align, uint32_t *i)
       }
 
       if (bit < map->min) {
-        return _bitmap_oom(map, nbits, align);
+        sync_tatas_release(&map->lock);
+        return LIBHPX_ENOMEM;
       }
 
       // see how far we can match
@@ -428,6 +435,20 @@ int bitmap_rreserve(bitmap_t *map, uint32_t nbits, uint32_t align, uint32_t *i)
   return LIBHPX_OK;
 }
 
+int bitmap_rreserve(bitmap_t *map, uint32_t nbits, uint32_t align, uint32_t *i)
+{
+  int e = _rreserve(map, nbits, align, i);
+  if (e == LIBHPX_ENOMEM) {
+    return _bitmap_oom(map, nbits, align);
+  }
+  return e;
+}
+
+int bitmap_try_rreserve(bitmap_t *map, uint32_t nbits, uint32_t align,
+                        uint32_t *i) {
+  return _rreserve(map, nbits, align, i);
+}
+
 void bitmap_release(bitmap_t *map, uint32_t bit, uint32_t nbits) {
   log_gas("release %u blocks at %u.\n", nbits, bit);
 
@@ -357,7 +357,15 @@ void config_print(const config_t *cfg, FILE *f) {
              "------------------------\n");
   fprintf(f, "General\n");
   fprintf(f, "  statistics\t\t%d\n", cfg->statistics);
+  fprintf(f, "  stats file\t\t\"%s\"\n",
+          (cfg->stats_file) ? cfg->stats_file : "(none)");
+  fprintf(f, "  stats interval\t%d\n", cfg->stats_interval);
+  fprintf(f, "  stats actions\t\t%d\n", cfg->stats_actions);
   fprintf(f, "  heapsize\t\t%zu\n", cfg->heapsize);
+  fprintf(f, "  heap segmentsize\t%zu\n", cfg->heap_segmentsize);
+  fprintf(f, "  hugepages\t\t\"%s\"\n", HPX_HUGEPAGES_TO_STRING[cfg->hugepages]);
+  fprintf(f, "  heap numa\t\t\"%s\"\n", HPX_HEAP_NUMA_TO_STRING[cfg->heap_numa]);
+  fprintf(f, "  heap chunkcache\t%d\n", cfg->heap_chunkcache);
   fprintf(f, "  gas\t\t\t\"%s\"\n", HPX_GAS_TO_STRING[cfg->gas]);
   fprintf(f, "  boot\t\t\t\"%s\"\n", HPX_BOOT_TO_STRING[cfg->boot]);
   fprintf(f, "  transport\t\t\"%s\"\n", HPX_TRANSPORT_TO_STRING[cfg->transport]);
@@ -426,6 +434,8 @@ void config_print(const config_t *cfg, FILE *f) {
   fprintf(f, "\nInstrumentation\n");
   fprintf(f, "  dir\t\t\t\"%s\"\n", cfg->inst_dir);
   fprintf(f, "  trace filesize\t%zu\n", cfg->trace_filesize);
+  fprintf(f, "  trace buffersize\t%d\n", cfg->trace_buffersize);
+  fprintf(f, "  trace backpressure\t%d\n", cfg->trace_backpressure);
   fprintf(f, "  trace classes\t\t");
   for (int i = 0, e = _HPX_NELEM(HPX_TRACE_CLASS_TO_STRING); i < e; ++i) {
     uint64_t class = (1lu << i);
@@ -454,7 +464,10 @@ void config_print(const config_t *cfg, FILE *f) {
 #ifdef HAVE_PHOTON
   fprintf(f, "\nPWC\n");
   fprintf(f, "  parcelbuffersize\t%lu\n", cfg->pwc_parcelbuffersize);
+  fprintf(f, "  parcelbuffermax\t%lu\n", cfg->pwc_parcelbuffermax);
+  fprintf(f, "  reloadinterval\t%d us\n", cfg->pwc_reloadinterval);
   fprintf(f, "  parceleagerlimit\t%lu\n", cfg->pwc_parceleagerlimit);
+  fprintf(f, "  regcache\t\t%d\n", cfg->pwc_regcache);
 #endif
 
 #ifdef HAVE_MPI
@@ -464,6 +477,16 @@ void config_print(const config_t *cfg, FILE *f) {
   fprintf(f, "  recvlimit\t\t%u\n", cfg->isir_recvlimit);
 #endif
 
+  fprintf(f, "\nCollectives\n");
+  fprintf(f, "  network\t\t%d\n", cfg->coll_network);
+  fprintf(f, "  segment\t\t%zu\n", cfg->coll_segment);
+
+#ifdef HAVE_AGAS
+  fprintf(f, "\nAGAS\n");
+  fprintf(f, "  tcache\t\t%d\n", cfg->agas_tcache);
+  fprintf(f, "  rebalance sample\t%d\n", cfg->agas_rebalance_sample);
+#endif
+
 #ifdef HAVE_PHOTON
   fprintf(f, "\nPhoton\n");
   fprintf(f, "  backend\t\t%s\n",
@@ -482,6 +505,14 @@ void config_print(const config_t *cfg, FILE *f) {
   fprintf(f, "\nOptimization\n");
   fprintf(f, "  smp\t\t\t%d\n", cfg->opt_smp);
 
+  fprintf(f, "\nCompression parameters\n");
+  fprintf(f, "  compression\t\t%d\n", cfg->parcel_compression);
+  fprintf(f, "  threshold\t\t%d%%\n", cfg->parcel_compression_threshold);
+  fprintf(f, "  probe\t\t\t%d\n", cfg->parcel_compression_probe);
+  fprintf(f, "  bandwidth\t\t%d MB/s\n", cfg->parcel_compression_bandwidth);
+  fprintf(f, "  largesize\t\t%zu\n", cfg->parcel_compression_largesize);
+  fprintf(f, "  accel\t\t\t%d\n", cfg->parcel_compression_accel);
+
   fprintf(f, "\nCoalescing parameters\n");
   fprintf(f, " Coalescing buffer size\t\t%d\n", cfg->coalescing_buffersize);
 
@@ -38,11 +38,18 @@ const char *hpx_options_t_help[] = {
   "      --hpx-help                print HPX help  (default=off)",
   "      --hpx-version             print HPX version  (default=off)",
   "      --hpx-heapsize=bytes      set HPX per-PE global heap size",
+  "      --hpx-heap-segmentsize=bytes\n                                grow the global heap on demand in segments of\n                                  this size (heapsize becomes the limit)",
+  "      --hpx-hugepages=policy    page size used for the global heap and\n                                  registered memory  (possible\n                                  values=\"default\", \"none\", \"thp\", \"hugetlb\")",
+  "      --hpx-heap-numa=policy    NUMA placement policy for the global heap and\n                                  registered memory  (possible\n                                  values=\"default\", \"interleave\", \"firsttouch\",\n                                  \"partition\")",
+  "      --hpx-heap-chunkcache=chunks\n                                chunks of the global heap cached by each worker\n                                  (0 disables)",
   "      --hpx-gas=type            type of Global Address Space (GAS)  (possible\n                                  values=\"default\", \"smp\", \"pgas\",\n                                  \"agas\")",
   "      --hpx-boot=type           HPX bootstrap method to use  (possible\n                                  values=\"default\", \"smp\", \"mpi\",\n                                  \"pmi\")",
   "      --hpx-transport=type      type of transport to use  (possible\n                                  values=\"default\", \"mpi\", \"photon\")",
   "      --hpx-network=type        type of network to use  (possible\n                                  values=\"default\", \"smp\", \"pwc\",\n                                  \"isir\")",
   "      --hpx-statistics          print HPX runtime statistics  (default=off)",
+  "      --hpx-stats-file=path     periodically export runtime statistics to this\n                                  file",
+  "      --hpx-stats-interval=ms   milliseconds between statistics exports",
+  "      --hpx-stats-actions       collect per-action count and latency histograms\n                                  (default=off)",
   "      --hpx-configfile=file     HPX runtime configuration file",
   "\nScheduler Options:",
   "      --hpx-threads=threads     number of scheduler threads",
@@ -65,7 +72,9 @@ const char *hpx_options_t_help[] = {
   "      --hpx-inst-at=[localities]\n                                set the localities to activate instrumentation\n                                  at",
   "\nTracing:",
   "      --hpx-trace-classes=class set the event classes to trace  (possible\n                                  values=\"parcel\", \"pwc\", \"sched\",\n                                  \"lco\", \"process\", \"memory\",\n                                  \"schedtimes\", \"bookend\", \"gas\",\n                                  \"all\")",
-  "      --hpx-trace-filesize=bytes\n                                set the size of each trace file",
+  "      --hpx-trace-filesize=bytes\n                                set the maximum size of each trace file (0 for\n                                  unlimited)",
+  "      --hpx-trace-buffersize=events\n                                set the number of events buffered per worker",
+  "      --hpx-trace-backpressure  block workers when their trace buffer is full\n                                  instead of dropping events  (default=off)",
   "\nProfiling:",
   "      --hpx-prof-counters=counters\n                                set which HW counters to use for profiling\n                                  (possible values=\"L1_TCM\", \"L1_TCA\",\n                                  \"L2_TCM\", \"L2_TCA\", \"L3_TCM\",\n                                  \"L3_TCA\", \"TLB_TL\", \"TOT_INS\",\n                                  \"INT_INS\", \"FP_INS\", \"LD_INS\",\n                                  \"SR_INS\", \"BR_INS\", \"TOT_CYC\", \"all\")",
   "      --hpx-prof-detailed       dump all individual measurements to file in\n                                  addition to summaries  (default=off)",
@@ -75,9 +84,16 @@ const char *hpx_options_t_help[] = {
   "      --hpx-isir-recvlimit=requests\n                                ISIR network recv limit",
   "\nPWC Network Options:",
   "      --hpx-pwc-parcelbuffersize=bytes\n                                set the size of p2p recv buffers for parcel\n                                  sends",
+  "      --hpx-pwc-parcelbuffermax=bytes\n                                set the largest p2p recv buffer that a busy\n                                  sender can grow to",
+  "      --hpx-pwc-reloadinterval=us\n                                grow a recv buffer that is reloaded sooner than\n                                  this, shrink one that lasts 64 times longer",
   "      --hpx-pwc-parceleagerlimit=bytes\n                                set the largest eager parcel size (header\n                                  inclusive)",
+  "      --hpx-pwc-regcache=entries\n                                keep this many user buffers registered for\n                                  memget/memput (0 disables)",
   "\nCollectives Options:",
   "      --hpx-coll-network        set collective implementation to network based\n                                  version (override parcel collectives)\n                                  (default=off)",
+  "      --hpx-coll-segment=bytes  pipeline process allreduces larger than this\n                                  many bytes in segments of this size (requires\n                                  elementwise operations, 0 disables)",
+  "\nAGAS Options:",
+  "      --hpx-agas-tcache=entries entries in each worker's AGAS translation cache\n                                  (0 disables)",
+  "      --hpx-agas-rebalance-sample=N\n                                sample one in every N block accesses for the\n                                  AGAS rebalancer",
   "\nPhoton Transport Options:",
   "      --hpx-photon-backend=type set the underlying network API to use\n                                  (possible values=\"default\", \"verbs\",\n                                  \"ugni\", \"fi\")",
   "      --hpx-photon-ibdev=device [verbs] set a particular IB device (also a\n                                  filter for device and port discovery, e.g.\n                                  qib0:1+mlx4_0:2)",
@@ -99,6 +115,11 @@ const char *hpx_options_t_help[] = {
   "\nOptimization:",
   "      --hpx-opt-smp[=0 off]     optimize for SMP execution",
   "      --hpx-parcel-compression  enable parcel compression  (default=off)",
+  "      --hpx-parcel-compression-threshold=percent\n                                compress only if the result is at most this\n                                  percent of the original size",
+  "      --hpx-parcel-compression-probe=parcels\n                                parcels sent uncompressed to a destination\n                                  after compression stops paying off, before\n                                  retrying",
+  "      --hpx-parcel-compression-bandwidth=MB/s\n                                link bandwidth used to weigh compression time\n                                  against transfer time (0 ignores time)",
+  "      --hpx-parcel-compression-largesize=bytes\n                                parcels of at least this size use the faster\n                                  compression level",
+  "      --hpx-parcel-compression-accel=level\n                                LZ4 acceleration for large parcels (1 is the\n                                  default level, higher is faster)",
   "      --hpx-coalescing-buffersize=Integer\n                                set coalescing buffer size",
     0
 };
@@ -147,6 +168,8 @@ free_cmd_list(void)
 }
 
 
+const char *hpx_option_parser_hpx_hugepages_values[] = {"default", "none", "thp", "hugetlb", 0}; /*< Possible values for hpx-hugepages. */
+const char *hpx_option_parser_hpx_heap_numa_values[] = {"default", "interleave", "firsttouch", "partition", 0}; /*< Possible values for hpx-heap-numa. */
 const char *hpx_option_parser_hpx_gas_values[] = {"default", "smp", "pgas", "agas", 0}; /*< Possible values for hpx-gas. */
 const char *hpx_option_parser_hpx_boot_values[] = {"default", "smp", "mpi", "pmi", 0}; /*< Possible values for hpx-boot. */
 const char *hpx_option_parser_hpx_transport_values[] = {"default", "mpi", "photon", 0}; /*< Possible values for hpx-transport. */
@@ -168,11 +191,18 @@ void clear_given (struct hpx_options_t *args_info)
   args_info->hpx_help_given = 0 ;
   args_info->hpx_version_given = 0 ;
   args_info->hpx_heapsize_given = 0 ;
+  args_info->hpx_heap_segmentsize_given = 0 ;
+  args_info->hpx_hugepages_given = 0 ;
+  args_info->hpx_heap_numa_given = 0 ;
+  args_info->hpx_heap_chunkcache_given = 0 ;
   args_info->hpx_gas_given = 0 ;
   args_info->hpx_boot_given = 0 ;
   args_info->hpx_transport_given = 0 ;
   args_info->hpx_network_given = 0 ;
   args_info->hpx_statistics_given = 0 ;
+  args_info->hpx_stats_file_given = 0 ;
+  args_info->hpx_stats_interval_given = 0 ;
+  args_info->hpx_stats_actions_given = 0 ;
   args_info->hpx_configfile_given = 0 ;
   args_info->hpx_threads_given = 0 ;
   args_info->hpx_thread_affinity_given = 0 ;
@@ -191,14 +221,22 @@ void clear_given (struct hpx_options_t *args_info)
   args_info->hpx_inst_at_given = 0 ;
   args_info->hpx_trace_classes_given = 0 ;
   args_info->hpx_trace_filesize_given = 0 ;
+  args_info->hpx_trace_buffersize_given = 0 ;
+  args_info->hpx_trace_backpressure_given = 0 ;
   args_info->hpx_prof_counters_given = 0 ;
   args_info->hpx_prof_detailed_given = 0 ;
   args_info->hpx_isir_testwindow_given = 0 ;
   args_info->hpx_isir_sendlimit_given = 0 ;
   args_info->hpx_isir_recvlimit_given = 0 ;
   args_info->hpx_pwc_parcelbuffersize_given = 0 ;
+  args_info->hpx_pwc_parcelbuffermax_given = 0 ;
+  args_info->hpx_pwc_reloadinterval_given = 0 ;
   args_info->hpx_pwc_parceleagerlimit_given = 0 ;
+  args_info->hpx_pwc_regcache_given = 0 ;
   args_info->hpx_coll_network_given = 0 ;
+  args_info->hpx_coll_segment_given = 0 ;
+  args_info->hpx_agas_tcache_given = 0 ;
+  args_info->hpx_agas_rebalance_sample_given = 0 ;
   args_info->hpx_photon_backend_given = 0 ;
   args_info->hpx_photon_ibdev_given = 0 ;
   args_info->hpx_photon_ethdev_given = 0 ;
@@ -218,6 +256,11 @@ void clear_given (struct hpx_options_t *args_info)
   args_info->hpx_photon_usercq_given = 0 ;
   args_info->hpx_opt_smp_given = 0 ;
   args_info->hpx_parcel_compression_given = 0 ;
+  args_info->hpx_parcel_compression_threshold_given = 0 ;
+  args_info->hpx_parcel_compression_probe_given = 0 ;
+  args_info->hpx_parcel_compression_bandwidth_given = 0 ;
+  args_info->hpx_parcel_compression_largesize_given = 0 ;
+  args_info->hpx_parcel_compression_accel_given = 0 ;
   args_info->hpx_coalescing_buffersize_given = 0 ;
 }
 
@@ -228,6 +271,12 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_help_flag = 0;
   args_info->hpx_version_flag = 0;
   args_info->hpx_heapsize_orig = NULL;
+  args_info->hpx_heap_segmentsize_orig = NULL;
+  args_info->hpx_hugepages_arg = hpx_hugepages__NULL;
+  args_info->hpx_hugepages_orig = NULL;
+  args_info->hpx_heap_numa_arg = hpx_heap_numa__NULL;
+  args_info->hpx_heap_numa_orig = NULL;
+  args_info->hpx_heap_chunkcache_orig = NULL;
   args_info->hpx_gas_arg = hpx_gas__NULL;
   args_info->hpx_gas_orig = NULL;
   args_info->hpx_boot_arg = hpx_boot__NULL;
@@ -237,6 +286,10 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_network_arg = hpx_network__NULL;
   args_info->hpx_network_orig = NULL;
   args_info->hpx_statistics_flag = 0;
+  args_info->hpx_stats_file_arg = NULL;
+  args_info->hpx_stats_file_orig = NULL;
+  args_info->hpx_stats_interval_orig = NULL;
+  args_info->hpx_stats_actions_flag = 0;
   args_info->hpx_configfile_arg = NULL;
   args_info->hpx_configfile_orig = NULL;
   args_info->hpx_threads_orig = NULL;
@@ -265,6 +318,8 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_trace_classes_arg = NULL;
   args_info->hpx_trace_classes_orig = NULL;
   args_info->hpx_trace_filesize_orig = NULL;
+  args_info->hpx_trace_buffersize_orig = NULL;
+  args_info->hpx_trace_backpressure_flag = 0;
   args_info->hpx_prof_counters_arg = NULL;
   args_info->hpx_prof_counters_orig = NULL;
   args_info->hpx_prof_detailed_flag = 0;
@@ -272,8 +327,14 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_isir_sendlimit_orig = NULL;
   args_info->hpx_isir_recvlimit_orig = NULL;
   args_info->hpx_pwc_parcelbuffersize_orig = NULL;
+  args_info->hpx_pwc_parcelbuffermax_orig = NULL;
+  args_info->hpx_pwc_reloadinterval_orig = NULL;
   args_info->hpx_pwc_parceleagerlimit_orig = NULL;
+  args_info->hpx_pwc_regcache_orig = NULL;
   args_info->hpx_coll_network_flag = 0;
+  args_info->hpx_coll_segment_orig = NULL;
+  args_info->hpx_agas_tcache_orig = NULL;
+  args_info->hpx_agas_rebalance_sample_orig = NULL;
   args_info->hpx_photon_backend_arg = hpx_photon_backend__NULL;
   args_info->hpx_photon_backend_orig = NULL;
   args_info->hpx_photon_ibdev_arg = NULL;
@@ -298,6 +359,11 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_photon_usercq_orig = NULL;
   args_info->hpx_opt_smp_orig = NULL;
   args_info->hpx_parcel_compression_flag = 0;
+  args_info->hpx_parcel_compression_threshold_orig = NULL;
+  args_info->hpx_parcel_compression_probe_orig = NULL;
+  args_info->hpx_parcel_compression_bandwidth_orig = NULL;
+  args_info->hpx_parcel_compression_largesize_orig = NULL;
+  args_info->hpx_parcel_compression_accel_orig = NULL;
   args_info->hpx_coalescing_buffersize_orig = NULL;
   
 }
@@ -310,71 +376,91 @@ void init_args_info(struct hpx_options_t *args_info)
   args_info->hpx_help_help = hpx_options_t_help[2] ;
   args_info->hpx_version_help = hpx_options_t_help[3] ;
   args_info->hpx_heapsize_help = hpx_options_t_help[4] ;
-  args_info->hpx_gas_help = hpx_options_t_help[5] ;
-  args_info->hpx_boot_help = hpx_options_t_help[6] ;
-  args_info->hpx_transport_help = hpx_options_t_help[7] ;
-  args_info->hpx_network_help = hpx_options_t_help[8] ;
-  args_info->hpx_statistics_help = hpx_options_t_help[9] ;
-  args_info->hpx_configfile_help = hpx_options_t_help[10] ;
-  args_info->hpx_threads_help = hpx_options_t_help[12] ;
-  args_info->hpx_thread_affinity_help = hpx_options_t_help[13] ;
-  args_info->hpx_stacksize_help = hpx_options_t_help[14] ;
-  args_info->hpx_sched_policy_help = hpx_options_t_help[15] ;
-  args_info->hpx_sched_wfthreshold_help = hpx_options_t_help[16] ;
-  args_info->hpx_sched_stackcachelimit_help = hpx_options_t_help[17] ;
-  args_info->hpx_log_at_help = hpx_options_t_help[19] ;
+  args_info->hpx_heap_segmentsize_help = hpx_options_t_help[5] ;
+  args_info->hpx_hugepages_help = hpx_options_t_help[6] ;
+  args_info->hpx_heap_numa_help = hpx_options_t_help[7] ;
+  args_info->hpx_heap_chunkcache_help = hpx_options_t_help[8] ;
+  args_info->hpx_gas_help = hpx_options_t_help[9] ;
+  args_info->hpx_boot_help = hpx_options_t_help[10] ;
+  args_info->hpx_transport_help = hpx_options_t_help[11] ;
+  args_info->hpx_network_help = hpx_options_t_help[12] ;
+  args_info->hpx_statistics_help = hpx_options_t_help[13] ;
+  args_info->hpx_stats_file_help = hpx_options_t_help[14] ;
+  args_info->hpx_stats_interval_help = hpx_options_t_help[15] ;
+  args_info->hpx_stats_actions_help = hpx_options_t_help[16] ;
+  args_info->hpx_configfile_help = hpx_options_t_help[17] ;
+  args_info->hpx_threads_help = hpx_options_t_help[19] ;
+  args_info->hpx_thread_affinity_help = hpx_options_t_help[20] ;
+  args_info->hpx_stacksize_help = hpx_options_t_help[21] ;
+  args_info->hpx_sched_policy_help = hpx_options_t_help[22] ;
+  args_info->hpx_sched_wfthreshold_help = hpx_options_t_help[23] ;
+  args_info->hpx_sched_stackcachelimit_help = hpx_options_t_help[24] ;
+  args_info->hpx_log_at_help = hpx_options_t_help[26] ;
   args_info->hpx_log_at_min = 0;
   args_info->hpx_log_at_max = 0;
-  args_info->hpx_log_level_help = hpx_options_t_help[20] ;
+  args_info->hpx_log_level_help = hpx_options_t_help[27] ;
   args_info->hpx_log_level_min = 0;
   args_info->hpx_log_level_max = 0;
-  args_info->hpx_dbg_waitat_help = hpx_options_t_help[22] ;
+  args_info->hpx_dbg_waitat_help = hpx_options_t_help[29] ;
   args_info->hpx_dbg_waitat_min = 0;
   args_info->hpx_dbg_waitat_max = 0;
-  args_info->hpx_dbg_waitonabort_help = hpx_options_t_help[23] ;
-  args_info->hpx_dbg_waitonsig_help = hpx_options_t_help[24] ;
+  args_info->hpx_dbg_waitonabort_help = hpx_options_t_help[30] ;
+  args_info->hpx_dbg_waitonsig_help = hpx_options_t_help[31] ;
   args_info->hpx_dbg_waitonsig_min = 0;
   args_info->hpx_dbg_waitonsig_max = 0;
-  args_info->hpx_dbg_mprotectstacks_help = hpx_options_t_help[25] ;
-  args_info->hpx_dbg_syncfree_help = hpx_options_t_help[26] ;
-  args_info->hpx_inst_dir_help = hpx_options_t_help[28] ;
-  args_info->hpx_inst_at_help = hpx_options_t_help[29] ;
+  args_info->hpx_dbg_mprotectstacks_help = hpx_options_t_help[32] ;
+  args_info->hpx_dbg_syncfree_help = hpx_options_t_help[33] ;
+  args_info->hpx_inst_dir_help = hpx_options_t_help[35] ;
+  args_info->hpx_inst_at_help = hpx_options_t_help[36] ;
   args_info->hpx_inst_at_min = 0;
   args_info->hpx_inst_at_max = 0;
-  args_info->hpx_trace_classes_help = hpx_options_t_help[31] ;
+  args_info->hpx_trace_classes_help = hpx_options_t_help[38] ;
   args_info->hpx_trace_classes_min = 0;
   args_info->hpx_trace_classes_max = 0;
-  args_info->hpx_trace_filesize_help = hpx_options_t_help[32] ;
-  args_info->hpx_prof_counters_help = hpx_options_t_help[34] ;
+  args_info->hpx_trace_filesize_help = hpx_options_t_help[39] ;
+  args_info->hpx_trace_buffersize_help = hpx_options_t_help[40] ;
+  args_info->hpx_trace_backpressure_help = hpx_options_t_help[41] ;
+  args_info->hpx_prof_counters_help = hpx_options_t_help[43] ;
   args_info->hpx_prof_counters_min = 0;
   args_info->hpx_prof_counters_max = 0;
-  args_info->hpx_prof_detailed_help = hpx_options_t_help[35] ;
-  args_info->hpx_isir_testwindow_help = hpx_options_t_help[37] ;
-  args_info->hpx_isir_sendlimit_help = hpx_options_t_help[38] ;
-  args_info->hpx_isir_recvlimit_help = hpx_options_t_help[39] ;
-  args_info->hpx_pwc_parcelbuffersize_help = hpx_options_t_help[41] ;
-  args_info->hpx_pwc_parceleagerlimit_help = hpx_options_t_help[42] ;
-  args_info->hpx_coll_network_help = hpx_options_t_help[44] ;
-  args_info->hpx_photon_backend_help = hpx_options_t_help[46] ;
-  args_info->hpx_photon_ibdev_help = hpx_options_t_help[47] ;
-  args_info->hpx_photon_ethdev_help = hpx_options_t_help[48] ;
-  args_info->hpx_photon_ibport_help = hpx_options_t_help[49] ;
-  args_info->hpx_photon_usecma_help = hpx_options_t_help[50] ;
-  args_info->hpx_photon_ibsrq_help = hpx_options_t_help[51] ;
-  args_info->hpx_photon_btethresh_help = hpx_options_t_help[52] ;
-  args_info->hpx_photon_fiprov_help = hpx_options_t_help[53] ;
-  args_info->hpx_photon_fidev_help = hpx_options_t_help[54] ;
-  args_info->hpx_photon_ledgersize_help = hpx_options_t_help[55] ;
-  args_info->hpx_photon_pwcbufsize_help = hpx_options_t_help[56] ;
-  args_info->hpx_photon_eagerbufsize_help = hpx_options_t_help[57] ;
-  args_info->hpx_photon_smallpwcsize_help = hpx_options_t_help[58] ;
-  args_info->hpx_photon_maxrd_help = hpx_options_t_help[59] ;
-  args_info->hpx_photon_defaultrd_help = hpx_options_t_help[60] ;
-  args_info->hpx_photon_numcq_help = hpx_options_t_help[61] ;
-  args_info->hpx_photon_usercq_help = hpx_options_t_help[62] ;
-  args_info->hpx_opt_smp_help = hpx_options_t_help[64] ;
-  args_info->hpx_parcel_compression_help = hpx_options_t_help[65] ;
-  args_info->hpx_coalescing_buffersize_help = hpx_options_t_help[66] ;
+  args_info->hpx_prof_detailed_help = hpx_options_t_help[44] ;
+  args_info->hpx_isir_testwindow_help = hpx_options_t_help[46] ;
+  args_info->hpx_isir_sendlimit_help = hpx_options_t_help[47] ;
+  args_info->hpx_isir_recvlimit_help = hpx_options_t_help[48] ;
+  args_info->hpx_pwc_parcelbuffersize_help = hpx_options_t_help[50] ;
+  args_info->hpx_pwc_parcelbuffermax_help = hpx_options_t_help[51] ;
+  args_info->hpx_pwc_reloadinterval_help = hpx_options_t_help[52] ;
+  args_info->hpx_pwc_parceleagerlimit_help = hpx_options_t_help[53] ;
+  args_info->hpx_pwc_regcache_help = hpx_options_t_help[54] ;
+  args_info->hpx_coll_network_help = hpx_options_t_help[56] ;
+  args_info->hpx_coll_segment_help = hpx_options_t_help[57] ;
+  args_info->hpx_agas_tcache_help = hpx_options_t_help[59] ;
+  args_info->hpx_agas_rebalance_sample_help = hpx_options_t_help[60] ;
+  args_info->hpx_photon_backend_help = hpx_options_t_help[62] ;
+  args_info->hpx_photon_ibdev_help = hpx_options_t_help[63] ;
+  args_info->hpx_photon_ethdev_help = hpx_options_t_help[64] ;
+  args_info->hpx_photon_ibport_help = hpx_options_t_help[65] ;
+  args_info->hpx_photon_usecma_help = hpx_options_t_help[66] ;
+  args_info->hpx_photon_ibsrq_help = hpx_options_t_help[67] ;
+  args_info->hpx_photon_btethresh_help = hpx_options_t_help[68] ;
+  args_info->hpx_photon_fiprov_help = hpx_options_t_help[69] ;
+  args_info->hpx_photon_fidev_help = hpx_options_t_help[70] ;
+  args_info->hpx_photon_ledgersize_help = hpx_options_t_help[71] ;
+  args_info->hpx_photon_pwcbufsize_help = hpx_options_t_help[72] ;
+  args_info->hpx_photon_eagerbufsize_help = hpx_options_t_help[73] ;
+  args_info->hpx_photon_smallpwcsize_help = hpx_options_t_help[74] ;
+  args_info->hpx_photon_maxrd_help = hpx_options_t_help[75] ;
+  args_info->hpx_photon_defaultrd_help = hpx_options_t_help[76] ;
+  args_info->hpx_photon_numcq_help = hpx_options_t_help[77] ;
+  args_info->hpx_photon_usercq_help = hpx_options_t_help[78] ;
+  args_info->hpx_opt_smp_help = hpx_options_t_help[80] ;
+  args_info->hpx_parcel_compression_help = hpx_options_t_help[81] ;
+  args_info->hpx_parcel_compression_threshold_help = hpx_options_t_help[82] ;
+  args_info->hpx_parcel_compression_probe_help = hpx_options_t_help[83] ;
+  args_info->hpx_parcel_compression_bandwidth_help = hpx_options_t_help[84] ;
+  args_info->hpx_parcel_compression_largesize_help = hpx_options_t_help[85] ;
+  args_info->hpx_parcel_compression_accel_help = hpx_options_t_help[86] ;
+  args_info->hpx_coalescing_buffersize_help = hpx_options_t_help[87] ;
   
 }
 
@@ -505,10 +591,17 @@ hpx_option_parser_release (struct hpx_options_t *args_info)
 {
 
   free_string_field (&(args_info->hpx_heapsize_orig));
+  free_string_field (&(args_info->hpx_heap_segmentsize_orig));
+  free_string_field (&(args_info->hpx_hugepages_orig));
+  free_string_field (&(args_info->hpx_heap_numa_orig));
+  free_string_field (&(args_info->hpx_heap_chunkcache_orig));
   free_string_field (&(args_info->hpx_gas_orig));
   free_string_field (&(args_info->hpx_boot_orig));
   free_string_field (&(args_info->hpx_transport_orig));
   free_string_field (&(args_info->hpx_network_orig));
+  free_string_field (&(args_info->hpx_stats_file_arg));
+  free_string_field (&(args_info->hpx_stats_file_orig));
+  free_string_field (&(args_info->hpx_stats_interval_orig));
   free_string_field (&(args_info->hpx_configfile_arg));
   free_string_field (&(args_info->hpx_configfile_orig));
   free_string_field (&(args_info->hpx_threads_orig));
@@ -532,13 +625,20 @@ hpx_option_parser_release (struct hpx_options_t *args_info)
   free_multiple_field (args_info->hpx_trace_classes_given, (void *)(args_info->hpx_trace_classes_arg), &(args_info->hpx_trace_classes_orig));
   args_info->hpx_trace_classes_arg = 0;
   free_string_field (&(args_info->hpx_trace_filesize_orig));
+  free_string_field (&(args_info->hpx_trace_buffersize_orig));
   free_multiple_field (args_info->hpx_prof_counters_given, (void *)(args_info->hpx_prof_counters_arg), &(args_info->hpx_prof_counters_orig));
   args_info->hpx_prof_counters_arg = 0;
   free_string_field (&(args_info->hpx_isir_testwindow_orig));
   free_string_field (&(args_info->hpx_isir_sendlimit_orig));
   free_string_field (&(args_info->hpx_isir_recvlimit_orig));
   free_string_field (&(args_info->hpx_pwc_parcelbuffersize_orig));
+  free_string_field (&(args_info->hpx_pwc_parcelbuffermax_orig));
+  free_string_field (&(args_info->hpx_pwc_reloadinterval_orig));
   free_string_field (&(args_info->hpx_pwc_parceleagerlimit_orig));
+  free_string_field (&(args_info->hpx_pwc_regcache_orig));
+  free_string_field (&(args_info->hpx_coll_segment_orig));
+  free_string_field (&(args_info->hpx_agas_tcache_orig));
+  free_string_field (&(args_info->hpx_agas_rebalance_sample_orig));
   free_string_field (&(args_info->hpx_photon_backend_orig));
   free_string_field (&(args_info->hpx_photon_ibdev_arg));
   free_string_field (&(args_info->hpx_photon_ibdev_orig));
@@ -560,6 +660,11 @@ hpx_option_parser_release (struct hpx_options_t *args_info)
   free_string_field (&(args_info->hpx_photon_numcq_orig));
   free_string_field (&(args_info->hpx_photon_usercq_orig));
   free_string_field (&(args_info->hpx_opt_smp_orig));
+  free_string_field (&(args_info->hpx_parcel_compression_threshold_orig));
+  free_string_field (&(args_info->hpx_parcel_compression_probe_orig));
+  free_string_field (&(args_info->hpx_parcel_compression_bandwidth_orig));
+  free_string_field (&(args_info->hpx_parcel_compression_largesize_orig));
+  free_string_field (&(args_info->hpx_parcel_compression_accel_orig));
   free_string_field (&(args_info->hpx_coalescing_buffersize_orig));
   
   
@@ -646,6 +751,14 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-version", 0, 0 );
   if (args_info->hpx_heapsize_given)
     write_into_file(outfile, "hpx-heapsize", args_info->hpx_heapsize_orig, 0);
+  if (args_info->hpx_heap_segmentsize_given)
+    write_into_file(outfile, "hpx-heap-segmentsize", args_info->hpx_heap_segmentsize_orig, 0);
+  if (args_info->hpx_hugepages_given)
+    write_into_file(outfile, "hpx-hugepages", args_info->hpx_hugepages_orig, hpx_option_parser_hpx_hugepages_values);
+  if (args_info->hpx_heap_numa_given)
+    write_into_file(outfile, "hpx-heap-numa", args_info->hpx_heap_numa_orig, hpx_option_parser_hpx_heap_numa_values);
+  if (args_info->hpx_heap_chunkcache_given)
+    write_into_file(outfile, "hpx-heap-chunkcache", args_info->hpx_heap_chunkcache_orig, 0);
   if (args_info->hpx_gas_given)
     write_into_file(outfile, "hpx-gas", args_info->hpx_gas_orig, hpx_option_parser_hpx_gas_values);
   if (args_info->hpx_boot_given)
@@ -656,6 +769,12 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-network", args_info->hpx_network_orig, hpx_option_parser_hpx_network_values);
   if (args_info->hpx_statistics_given)
     write_into_file(outfile, "hpx-statistics", 0, 0 );
+  if (args_info->hpx_stats_file_given)
+    write_into_file(outfile, "hpx-stats-file", args_info->hpx_stats_file_orig, 0);
+  if (args_info->hpx_stats_interval_given)
+    write_into_file(outfile, "hpx-stats-interval", args_info->hpx_stats_interval_orig, 0);
+  if (args_info->hpx_stats_actions_given)
+    write_into_file(outfile, "hpx-stats-actions", 0, 0 );
   if (args_info->hpx_configfile_given)
     write_into_file(outfile, "hpx-configfile", args_info->hpx_configfile_orig, 0);
   if (args_info->hpx_threads_given)
@@ -686,6 +805,10 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
   write_multiple_into_file(outfile, args_info->hpx_trace_classes_given, "hpx-trace-classes", args_info->hpx_trace_classes_orig, hpx_option_parser_hpx_trace_classes_values);
   if (args_info->hpx_trace_filesize_given)
     write_into_file(outfile, "hpx-trace-filesize", args_info->hpx_trace_filesize_orig, 0);
+  if (args_info->hpx_trace_buffersize_given)
+    write_into_file(outfile, "hpx-trace-buffersize", args_info->hpx_trace_buffersize_orig, 0);
+  if (args_info->hpx_trace_backpressure_given)
+    write_into_file(outfile, "hpx-trace-backpressure", 0, 0 );
   write_multiple_into_file(outfile, args_info->hpx_prof_counters_given, "hpx-prof-counters", args_info->hpx_prof_counters_orig, hpx_option_parser_hpx_prof_counters_values);
   if (args_info->hpx_prof_detailed_given)
     write_into_file(outfile, "hpx-prof-detailed", 0, 0 );
@@ -697,10 +820,22 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-isir-recvlimit", args_info->hpx_isir_recvlimit_orig, 0);
   if (args_info->hpx_pwc_parcelbuffersize_given)
     write_into_file(outfile, "hpx-pwc-parcelbuffersize", args_info->hpx_pwc_parcelbuffersize_orig, 0);
+  if (args_info->hpx_pwc_parcelbuffermax_given)
+    write_into_file(outfile, "hpx-pwc-parcelbuffermax", args_info->hpx_pwc_parcelbuffermax_orig, 0);
+  if (args_info->hpx_pwc_reloadinterval_given)
+    write_into_file(outfile, "hpx-pwc-reloadinterval", args_info->hpx_pwc_reloadinterval_orig, 0);
   if (args_info->hpx_pwc_parceleagerlimit_given)
     write_into_file(outfile, "hpx-pwc-parceleagerlimit", args_info->hpx_pwc_parceleagerlimit_orig, 0);
+  if (args_info->hpx_pwc_regcache_given)
+    write_into_file(outfile, "hpx-pwc-regcache", args_info->hpx_pwc_regcache_orig, 0);
   if (args_info->hpx_coll_network_given)
     write_into_file(outfile, "hpx-coll-network", 0, 0 );
+  if (args_info->hpx_coll_segment_given)
+    write_into_file(outfile, "hpx-coll-segment", args_info->hpx_coll_segment_orig, 0);
+  if (args_info->hpx_agas_tcache_given)
+    write_into_file(outfile, "hpx-agas-tcache", args_info->hpx_agas_tcache_orig, 0);
+  if (args_info->hpx_agas_rebalance_sample_given)
+    write_into_file(outfile, "hpx-agas-rebalance-sample", args_info->hpx_agas_rebalance_sample_orig, 0);
   if (args_info->hpx_photon_backend_given)
     write_into_file(outfile, "hpx-photon-backend", args_info->hpx_photon_backend_orig, hpx_option_parser_hpx_photon_backend_values);
   if (args_info->hpx_photon_ibdev_given)
@@ -739,6 +874,16 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-opt-smp", args_info->hpx_opt_smp_orig, 0);
   if (args_info->hpx_parcel_compression_given)
     write_into_file(outfile, "hpx-parcel-compression", 0, 0 );
+  if (args_info->hpx_parcel_compression_threshold_given)
+    write_into_file(outfile, "hpx-parcel-compression-threshold", args_info->hpx_parcel_compression_threshold_orig, 0);
+  if (args_info->hpx_parcel_compression_probe_given)
+    write_into_file(outfile, "hpx-parcel-compression-probe", args_info->hpx_parcel_compression_probe_orig, 0);
+  if (args_info->hpx_parcel_compression_bandwidth_given)
+    write_into_file(outfile, "hpx-parcel-compression-bandwidth", args_info->hpx_parcel_compression_bandwidth_orig, 0);
+  if (args_info->hpx_parcel_compression_largesize_given)
+    write_into_file(outfile, "hpx-parcel-compression-largesize", args_info->hpx_parcel_compression_largesize_orig, 0);
+  if (args_info->hpx_parcel_compression_accel_given)
+    write_into_file(outfile, "hpx-parcel-compression-accel", args_info->hpx_parcel_compression_accel_orig, 0);
   if (args_info->hpx_coalescing_buffersize_given)
     write_into_file(outfile, "hpx-coalescing-buffersize", args_info->hpx_coalescing_buffersize_orig, 0);
   
@@ -1944,11 +2089,18 @@ hpx_option_parser_internal (
         { "hpx-help",	0, NULL, 0 },
         { "hpx-version",	0, NULL, 0 },
         { "hpx-heapsize",	1, NULL, 0 },
+        { "hpx-heap-segmentsize",	1, NULL, 0 },
+        { "hpx-hugepages",	1, NULL, 0 },
+        { "hpx-heap-numa",	1, NULL, 0 },
+        { "hpx-heap-chunkcache",	1, NULL, 0 },
         { "hpx-gas",	1, NULL, 0 },
         { "hpx-boot",	1, NULL, 0 },
         { "hpx-transport",	1, NULL, 0 },
         { "hpx-network",	1, NULL, 0 },
         { "hpx-statistics",	0, NULL, 0 },
+        { "hpx-stats-file",	1, NULL, 0 },
+        { "hpx-stats-interval",	1, NULL, 0 },
+        { "hpx-stats-actions",	0, NULL, 0 },
         { "hpx-configfile",	1, NULL, 0 },
         { "hpx-threads",	1, NULL, 0 },
         { "hpx-thread-affinity",	1, NULL, 0 },
@@ -1967,14 +2119,22 @@ hpx_option_parser_internal (
         { "hpx-inst-at",	1, NULL, 0 },
         { "hpx-trace-classes",	1, NULL, 0 },
         { "hpx-trace-filesize",	1, NULL, 0 },
+        { "hpx-trace-buffersize",	1, NULL, 0 },
+        { "hpx-trace-backpressure",	0, NULL, 0 },
         { "hpx-prof-counters",	1, NULL, 0 },
         { "hpx-prof-detailed",	0, NULL, 0 },
         { "hpx-isir-testwindow",	1, NULL, 0 },
         { "hpx-isir-sendlimit",	1, NULL, 0 },
         { "hpx-isir-recvlimit",	1, NULL, 0 },
         { "hpx-pwc-parcelbuffersize",	1, NULL, 0 },
+        { "hpx-pwc-parcelbuffermax",	1, NULL, 0 },
+        { "hpx-pwc-reloadinterval",	1, NULL, 0 },
         { "hpx-pwc-parceleagerlimit",	1, NULL, 0 },
+        { "hpx-pwc-regcache",	1, NULL, 0 },
         { "hpx-coll-network",	0, NULL, 0 },
+        { "hpx-coll-segment",	1, NULL, 0 },
+        { "hpx-agas-tcache",	1, NULL, 0 },
+        { "hpx-agas-rebalance-sample",	1, NULL, 0 },
         { "hpx-photon-backend",	1, NULL, 0 },
         { "hpx-photon-ibdev",	1, NULL, 0 },
         { "hpx-photon-ethdev",	1, NULL, 0 },
@@ -1994,6 +2154,11 @@ hpx_option_parser_internal (
         { "hpx-photon-usercq",	1, NULL, 0 },
         { "hpx-opt-smp",	2, NULL, 0 },
         { "hpx-parcel-compression",	0, NULL, 0 },
+        { "hpx-parcel-compression-threshold",	1, NULL, 0 },
+        { "hpx-parcel-compression-probe",	1, NULL, 0 },
+        { "hpx-parcel-compression-bandwidth",	1, NULL, 0 },
+        { "hpx-parcel-compression-largesize",	1, NULL, 0 },
+        { "hpx-parcel-compression-accel",	1, NULL, 0 },
         { "hpx-coalescing-buffersize",	1, NULL, 0 },
         { 0,  0, 0, 0 }
       };
@@ -2053,6 +2218,62 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* grow the global heap on demand in segments of this size (heapsize becomes the limit).  */
+          else if (strcmp (long_options[option_index].name, "hpx-heap-segmentsize") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_heap_segmentsize_arg), 
+                 &(args_info->hpx_heap_segmentsize_orig), &(args_info->hpx_heap_segmentsize_given),
+                &(local_args_info.hpx_heap_segmentsize_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-heap-segmentsize", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* page size used for the global heap and registered memory.  */
+          else if (strcmp (long_options[option_index].name, "hpx-hugepages") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_hugepages_arg), 
+                 &(args_info->hpx_hugepages_orig), &(args_info->hpx_hugepages_given),
+                &(local_args_info.hpx_hugepages_given), optarg, hpx_option_parser_hpx_hugepages_values, 0, ARG_ENUM,
+                check_ambiguity, override, 0, 0,
+                "hpx-hugepages", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* NUMA placement policy for the global heap and registered memory.  */
+          else if (strcmp (long_options[option_index].name, "hpx-heap-numa") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_heap_numa_arg), 
+                 &(args_info->hpx_heap_numa_orig), &(args_info->hpx_heap_numa_given),
+                &(local_args_info.hpx_heap_numa_given), optarg, hpx_option_parser_hpx_heap_numa_values, 0, ARG_ENUM,
+                check_ambiguity, override, 0, 0,
+                "hpx-heap-numa", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* chunks of the global heap cached by each worker (0 disables).  */
+          else if (strcmp (long_options[option_index].name, "hpx-heap-chunkcache") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_heap_chunkcache_arg), 
+                 &(args_info->hpx_heap_chunkcache_orig), &(args_info->hpx_heap_chunkcache_given),
+                &(local_args_info.hpx_heap_chunkcache_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-heap-chunkcache", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* type of Global Address Space (GAS).  */
           else if (strcmp (long_options[option_index].name, "hpx-gas") == 0)
@@ -2121,6 +2342,46 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* periodically export runtime statistics to this file.  */
+          else if (strcmp (long_options[option_index].name, "hpx-stats-file") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_stats_file_arg), 
+                 &(args_info->hpx_stats_file_orig), &(args_info->hpx_stats_file_given),
+                &(local_args_info.hpx_stats_file_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "hpx-stats-file", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* milliseconds between statistics exports.  */
+          else if (strcmp (long_options[option_index].name, "hpx-stats-interval") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_stats_interval_arg), 
+                 &(args_info->hpx_stats_interval_orig), &(args_info->hpx_stats_interval_given),
+                &(local_args_info.hpx_stats_interval_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-stats-interval", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* collect per-action count and latency histograms.  */
+          else if (strcmp (long_options[option_index].name, "hpx-stats-actions") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->hpx_stats_actions_flag), 0, &(args_info->hpx_stats_actions_given),
+                &(local_args_info.hpx_stats_actions_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "hpx-stats-actions", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* HPX runtime configuration file.  */
           else if (strcmp (long_options[option_index].name, "hpx-configfile") == 0)
@@ -2336,7 +2597,7 @@ hpx_option_parser_internal (
               goto failure;
           
           }
-          /* set the size of each trace file.  */
+          /* set the maximum size of each trace file (0 for unlimited).  */
           else if (strcmp (long_options[option_index].name, "hpx-trace-filesize") == 0)
           {
           
@@ -2349,6 +2610,32 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* set the number of events buffered per worker.  */
+          else if (strcmp (long_options[option_index].name, "hpx-trace-buffersize") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_trace_buffersize_arg), 
+                 &(args_info->hpx_trace_buffersize_orig), &(args_info->hpx_trace_buffersize_given),
+                &(local_args_info.hpx_trace_buffersize_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-trace-buffersize", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* block workers when their trace buffer is full instead of dropping events.  */
+          else if (strcmp (long_options[option_index].name, "hpx-trace-backpressure") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->hpx_trace_backpressure_flag), 0, &(args_info->hpx_trace_backpressure_given),
+                &(local_args_info.hpx_trace_backpressure_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "hpx-trace-backpressure", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* set which HW counters to use for profiling.  */
           else if (strcmp (long_options[option_index].name, "hpx-prof-counters") == 0)
@@ -2428,6 +2715,34 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* set the largest p2p recv buffer that a busy sender can grow to.  */
+          else if (strcmp (long_options[option_index].name, "hpx-pwc-parcelbuffermax") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_pwc_parcelbuffermax_arg), 
+                 &(args_info->hpx_pwc_parcelbuffermax_orig), &(args_info->hpx_pwc_parcelbuffermax_given),
+                &(local_args_info.hpx_pwc_parcelbuffermax_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-pwc-parcelbuffermax", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* grow a recv buffer that is reloaded sooner than this, shrink one that lasts 64 times longer.  */
+          else if (strcmp (long_options[option_index].name, "hpx-pwc-reloadinterval") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_pwc_reloadinterval_arg), 
+                 &(args_info->hpx_pwc_reloadinterval_orig), &(args_info->hpx_pwc_reloadinterval_given),
+                &(local_args_info.hpx_pwc_reloadinterval_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-pwc-reloadinterval", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* set the largest eager parcel size (header inclusive).  */
           else if (strcmp (long_options[option_index].name, "hpx-pwc-parceleagerlimit") == 0)
@@ -2442,6 +2757,20 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* keep this many user buffers registered for memget/memput (0 disables).  */
+          else if (strcmp (long_options[option_index].name, "hpx-pwc-regcache") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_pwc_regcache_arg), 
+                 &(args_info->hpx_pwc_regcache_orig), &(args_info->hpx_pwc_regcache_given),
+                &(local_args_info.hpx_pwc_regcache_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-pwc-regcache", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* set collective implementation to network based version (override parcel collectives).  */
           else if (strcmp (long_options[option_index].name, "hpx-coll-network") == 0)
@@ -2454,6 +2783,48 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* pipeline process allreduces larger than this many bytes in segments of this size (requires elementwise operations, 0 disables).  */
+          else if (strcmp (long_options[option_index].name, "hpx-coll-segment") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_coll_segment_arg), 
+                 &(args_info->hpx_coll_segment_orig), &(args_info->hpx_coll_segment_given),
+                &(local_args_info.hpx_coll_segment_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-coll-segment", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* entries in each worker's AGAS translation cache (0 disables).  */
+          else if (strcmp (long_options[option_index].name, "hpx-agas-tcache") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_agas_tcache_arg), 
+                 &(args_info->hpx_agas_tcache_orig), &(args_info->hpx_agas_tcache_given),
+                &(local_args_info.hpx_agas_tcache_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-agas-tcache", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* sample one in every N block accesses for the AGAS rebalancer.  */
+          else if (strcmp (long_options[option_index].name, "hpx-agas-rebalance-sample") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_agas_rebalance_sample_arg), 
+                 &(args_info->hpx_agas_rebalance_sample_orig), &(args_info->hpx_agas_rebalance_sample_given),
+                &(local_args_info.hpx_agas_rebalance_sample_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-agas-rebalance-sample", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* set the underlying network API to use.  */
           else if (strcmp (long_options[option_index].name, "hpx-photon-backend") == 0)
@@ -2716,6 +3087,76 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* compress only if the result is at most this percent of the original size.  */
+          else if (strcmp (long_options[option_index].name, "hpx-parcel-compression-threshold") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_parcel_compression_threshold_arg), 
+                 &(args_info->hpx_parcel_compression_threshold_orig), &(args_info->hpx_parcel_compression_threshold_given),
+                &(local_args_info.hpx_parcel_compression_threshold_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-parcel-compression-threshold", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* parcels sent uncompressed to a destination after compression stops paying off, before retrying.  */
+          else if (strcmp (long_options[option_index].name, "hpx-parcel-compression-probe") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_parcel_compression_probe_arg), 
+                 &(args_info->hpx_parcel_compression_probe_orig), &(args_info->hpx_parcel_compression_probe_given),
+                &(local_args_info.hpx_parcel_compression_probe_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-parcel-compression-probe", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* link bandwidth used to weigh compression time against transfer time (0 ignores time).  */
+          else if (strcmp (long_options[option_index].name, "hpx-parcel-compression-bandwidth") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_parcel_compression_bandwidth_arg), 
+                 &(args_info->hpx_parcel_compression_bandwidth_orig), &(args_info->hpx_parcel_compression_bandwidth_given),
+                &(local_args_info.hpx_parcel_compression_bandwidth_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-parcel-compression-bandwidth", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* parcels of at least this size use the faster compression level.  */
+          else if (strcmp (long_options[option_index].name, "hpx-parcel-compression-largesize") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_parcel_compression_largesize_arg), 
+                 &(args_info->hpx_parcel_compression_largesize_orig), &(args_info->hpx_parcel_compression_largesize_given),
+                &(local_args_info.hpx_parcel_compression_largesize_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-parcel-compression-largesize", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* LZ4 acceleration for large parcels (1 is the default level, higher is faster).  */
+          else if (strcmp (long_options[option_index].name, "hpx-parcel-compression-accel") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_parcel_compression_accel_arg), 
+                 &(args_info->hpx_parcel_compression_accel_orig), &(args_info->hpx_parcel_compression_accel_given),
+                &(local_args_info.hpx_parcel_compression_accel_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-parcel-compression-accel", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* set coalescing buffer size.  */
           else if (strcmp (long_options[option_index].name, "hpx-coalescing-buffersize") == 0)
@@ -38,6 +38,8 @@ extern "C" {
 #define HPX_OPTION_PARSER_VERSION VERSION
 #endif
 
+enum enum_hpx_hugepages { hpx_hugepages__NULL = -1, hpx_hugepages_arg_default = 0, hpx_hugepages_arg_none, hpx_hugepages_arg_thp, hpx_hugepages_arg_hugetlb };
+enum enum_hpx_heap_numa { hpx_heap_numa__NULL = -1, hpx_heap_numa_arg_default = 0, hpx_heap_numa_arg_interleave, hpx_heap_numa_arg_firsttouch, hpx_heap_numa_arg_partition };
 enum enum_hpx_gas { hpx_gas__NULL = -1, hpx_gas_arg_default = 0, hpx_gas_arg_smp, hpx_gas_arg_pgas, hpx_gas_arg_agas };
 enum enum_hpx_boot { hpx_boot__NULL = -1, hpx_boot_arg_default = 0, hpx_boot_arg_smp, hpx_boot_arg_mpi, hpx_boot_arg_pmi };
 enum enum_hpx_transport { hpx_transport__NULL = -1, hpx_transport_arg_default = 0, hpx_transport_arg_mpi, hpx_transport_arg_photon };
@@ -60,6 +62,18 @@ struct hpx_options_t
   long hpx_heapsize_arg;	/**< @brief set HPX per-PE global heap size.  */
   char * hpx_heapsize_orig;	/**< @brief set HPX per-PE global heap size original value given at command line.  */
   const char *hpx_heapsize_help; /**< @brief set HPX per-PE global heap size help description.  */
+  long hpx_heap_segmentsize_arg;	/**< @brief grow the global heap on demand in segments of this size (heapsize becomes the limit).  */
+  char * hpx_heap_segmentsize_orig;	/**< @brief grow the global heap on demand in segments of this size (heapsize becomes the limit) original value given at command line.  */
+  const char *hpx_heap_segmentsize_help; /**< @brief grow the global heap on demand in segments of this size (heapsize becomes the limit) help description.  */
+  enum enum_hpx_hugepages hpx_hugepages_arg;	/**< @brief page size used for the global heap and registered memory.  */
+  char * hpx_hugepages_orig;	/**< @brief page size used for the global heap and registered memory original value given at command line.  */
+  const char *hpx_hugepages_help; /**< @brief page size used for the global heap and registered memory help description.  */
+  enum enum_hpx_heap_numa hpx_heap_numa_arg;	/**< @brief NUMA placement policy for the global heap and registered memory.  */
+  char * hpx_heap_numa_orig;	/**< @brief NUMA placement policy for the global heap and registered memory original value given at command line.  */
+  const char *hpx_heap_numa_help; /**< @brief NUMA placement policy for the global heap and registered memory help description.  */
+  int hpx_heap_chunkcache_arg;	/**< @brief chunks of the global heap cached by each worker (0 disables).  */
+  char * hpx_heap_chunkcache_orig;	/**< @brief chunks of the global heap cached by each worker (0 disables) original value given at command line.  */
+  const char *hpx_heap_chunkcache_help; /**< @brief chunks of the global heap cached by each worker (0 disables) help description.  */
   enum enum_hpx_gas hpx_gas_arg;	/**< @brief type of Global Address Space (GAS).  */
   char * hpx_gas_orig;	/**< @brief type of Global Address Space (GAS) original value given at command line.  */
   const char *hpx_gas_help; /**< @brief type of Global Address Space (GAS) help description.  */
@@ -74,6 +88,14 @@ struct hpx_options_t
   const char *hpx_network_help; /**< @brief type of network to use help description.  */
   int hpx_statistics_flag;	/**< @brief print HPX runtime statistics (default=off).  */
   const char *hpx_statistics_help; /**< @brief print HPX runtime statistics help description.  */
+  char * hpx_stats_file_arg;	/**< @brief periodically export runtime statistics to this file.  */
+  char * hpx_stats_file_orig;	/**< @brief periodically export runtime statistics to this file original value given at command line.  */
+  const char *hpx_stats_file_help; /**< @brief periodically export runtime statistics to this file help description.  */
+  int hpx_stats_interval_arg;	/**< @brief milliseconds between statistics exports.  */
+  char * hpx_stats_interval_orig;	/**< @brief milliseconds between statistics exports original value given at command line.  */
+  const char *hpx_stats_interval_help; /**< @brief milliseconds between statistics exports help description.  */
+  int hpx_stats_actions_flag;	/**< @brief collect per-action count and latency histograms (default=off).  */
+  const char *hpx_stats_actions_help; /**< @brief collect per-action count and latency histograms help description.  */
   char * hpx_configfile_arg;	/**< @brief HPX runtime configuration file.  */
   char * hpx_configfile_orig;	/**< @brief HPX runtime configuration file original value given at command line.  */
   const char *hpx_configfile_help; /**< @brief HPX runtime configuration file help description.  */
@@ -134,9 +156,14 @@ struct hpx_options_t
   unsigned int hpx_trace_classes_min; /**< @brief set the event classes to trace's minimum occurreces */
   unsigned int hpx_trace_classes_max; /**< @brief set the event classes to trace's maximum occurreces */
   const char *hpx_trace_classes_help; /**< @brief set the event classes to trace help description.  */
-  long hpx_trace_filesize_arg;	/**< @brief set the size of each trace file.  */
-  char * hpx_trace_filesize_orig;	/**< @brief set the size of each trace file original value given at command line.  */
-  const char *hpx_trace_filesize_help; /**< @brief set the size of each trace file help description.  */
+  long hpx_trace_filesize_arg;	/**< @brief set the maximum size of each trace file (0 for unlimited).  */
+  char * hpx_trace_filesize_orig;	/**< @brief set the maximum size of each trace file (0 for unlimited) original value given at command line.  */
+  const char *hpx_trace_filesize_help; /**< @brief set the maximum size of each trace file (0 for unlimited) help description.  */
+  int hpx_trace_buffersize_arg;	/**< @brief set the number of events buffered per worker.  */
+  char * hpx_trace_buffersize_orig;	/**< @brief set the number of events buffered per worker original value given at command line.  */
+  const char *hpx_trace_buffersize_help; /**< @brief set the number of events buffered per worker help description.  */
+  int hpx_trace_backpressure_flag;	/**< @brief block workers when their trace buffer is full instead of dropping events (default=off).  */
+  const char *hpx_trace_backpressure_help; /**< @brief block workers when their trace buffer is full instead of dropping events help description.  */
   enum enum_hpx_prof_counters *hpx_prof_counters_arg;	/**< @brief set which HW counters to use for profiling.  */
   char ** hpx_prof_counters_orig;	/**< @brief set which HW counters to use for profiling original value given at command line.  */
   unsigned int hpx_prof_counters_min; /**< @brief set which HW counters to use for profiling's minimum occurreces */
@@ -156,11 +183,29 @@ struct hpx_options_t
   long hpx_pwc_parcelbuffersize_arg;	/**< @brief set the size of p2p recv buffers for parcel sends.  */
   char * hpx_pwc_parcelbuffersize_orig;	/**< @brief set the size of p2p recv buffers for parcel sends original value given at command line.  */
   const char *hpx_pwc_parcelbuffersize_help; /**< @brief set the size of p2p recv buffers for parcel sends help description.  */
+  long hpx_pwc_parcelbuffermax_arg;	/**< @brief set the largest p2p recv buffer that a busy sender can grow to.  */
+  char * hpx_pwc_parcelbuffermax_orig;	/**< @brief set the largest p2p recv buffer that a busy sender can grow to original value given at command line.  */
+  const char *hpx_pwc_parcelbuffermax_help; /**< @brief set the largest p2p recv buffer that a busy sender can grow to help description.  */
+  int hpx_pwc_reloadinterval_arg;	/**< @brief grow a recv buffer that is reloaded sooner than this, shrink one that lasts 64 times longer.  */
+  char * hpx_pwc_reloadinterval_orig;	/**< @brief grow a recv buffer that is reloaded sooner than this, shrink one that lasts 64 times longer original value given at command line.  */
+  const char *hpx_pwc_reloadinterval_help; /**< @brief grow a recv buffer that is reloaded sooner than this, shrink one that lasts 64 times longer help description.  */
   long hpx_pwc_parceleagerlimit_arg;	/**< @brief set the largest eager parcel size (header inclusive).  */
   char * hpx_pwc_parceleagerlimit_orig;	/**< @brief set the largest eager parcel size (header inclusive) original value given at command line.  */
   const char *hpx_pwc_parceleagerlimit_help; /**< @brief set the largest eager parcel size (header inclusive) help description.  */
+  int hpx_pwc_regcache_arg;	/**< @brief keep this many user buffers registered for memget/memput (0 disables).  */
+  char * hpx_pwc_regcache_orig;	/**< @brief keep this many user buffers registered for memget/memput (0 disables) original value given at command line.  */
+  const char *hpx_pwc_regcache_help; /**< @brief keep this many user buffers registered for memget/memput (0 disables) help description.  */
   int hpx_coll_network_flag;	/**< @brief set collective implementation to network based version (override parcel collectives) (default=off).  */
   const char *hpx_coll_network_help; /**< @brief set collective implementation to network based version (override parcel collectives) help description.  */
+  long hpx_coll_segment_arg;	/**< @brief pipeline process allreduces larger than this many bytes in segments of this size (requires elementwise operations, 0 disables).  */
+  char * hpx_coll_segment_orig;	/**< @brief pipeline process allreduces larger than this many bytes in segments of this size (requires elementwise operations, 0 disables) original value given at command line.  */
+  const char *hpx_coll_segment_help; /**< @brief pipeline process allreduces larger than this many bytes in segments of this size (requires elementwise operations, 0 disables) help description.  */
+  int hpx_agas_tcache_arg;	/**< @brief entries in each worker's AGAS translation cache (0 disables).  */
+  char * hpx_agas_tcache_orig;	/**< @brief entries in each worker's AGAS translation cache (0 disables) original value given at command line.  */
+  const char *hpx_agas_tcache_help; /**< @brief entries in each worker's AGAS translation cache (0 disables) help description.  */
+  int hpx_agas_rebalance_sample_arg;	/**< @brief sample one in every N block accesses for the AGAS rebalancer.  */
+  char * hpx_agas_rebalance_sample_orig;	/**< @brief sample one in every N block accesses for the AGAS rebalancer original value given at command line.  */
+  const char *hpx_agas_rebalance_sample_help; /**< @brief sample one in every N block accesses for the AGAS rebalancer help description.  */
   enum enum_hpx_photon_backend hpx_photon_backend_arg;	/**< @brief set the underlying network API to use.  */
   char * hpx_photon_backend_orig;	/**< @brief set the underlying network API to use original value given at command line.  */
   const char *hpx_photon_backend_help; /**< @brief set the underlying network API to use help description.  */
@@ -216,6 +261,21 @@ struct hpx_options_t
   const char *hpx_opt_smp_help; /**< @brief optimize for SMP execution help description.  */
   int hpx_parcel_compression_flag;	/**< @brief enable parcel compression (default=off).  */
   const char *hpx_parcel_compression_help; /**< @brief enable parcel compression help description.  */
+  int hpx_parcel_compression_threshold_arg;	/**< @brief compress only if the result is at most this percent of the original size.  */
+  char * hpx_parcel_compression_threshold_orig;	/**< @brief compress only if the result is at most this percent of the original size original value given at command line.  */
+  const char *hpx_parcel_compression_threshold_help; /**< @brief compress only if the result is at most this percent of the original size help description.  */
+  int hpx_parcel_compression_probe_arg;	/**< @brief parcels sent uncompressed to a destination after compression stops paying off, before retrying.  */
+  char * hpx_parcel_compression_probe_orig;	/**< @brief parcels sent uncompressed to a destination after compression stops paying off, before retrying original value given at command line.  */
+  const char *hpx_parcel_compression_probe_help; /**< @brief parcels sent uncompressed to a destination after compression stops paying off, before retrying help description.  */
+  int hpx_parcel_compression_bandwidth_arg;	/**< @brief link bandwidth used to weigh compression time against transfer time (0 ignores time).  */
+  char * hpx_parcel_compression_bandwidth_orig;	/**< @brief link bandwidth used to weigh compression time against transfer time (0 ignores time) original value given at command line.  */
+  const char *hpx_parcel_compression_bandwidth_help; /**< @brief link bandwidth used to weigh compression time against transfer time (0 ignores time) help description.  */
+  long hpx_parcel_compression_largesize_arg;	/**< @brief parcels of at least this size use the faster compression level.  */
+  char * hpx_parcel_compression_largesize_orig;	/**< @brief parcels of at least this size use the faster compression level original value given at command line.  */
+  const char *hpx_parcel_compression_largesize_help; /**< @brief parcels of at least this size use the faster compression level help description.  */
+  int hpx_parcel_compression_accel_arg;	/**< @brief LZ4 acceleration for large parcels (1 is the default level, higher is faster).  */
+  char * hpx_parcel_compression_accel_orig;	/**< @brief LZ4 acceleration for large parcels (1 is the default level, higher is faster) original value given at command line.  */
+  const char *hpx_parcel_compression_accel_help; /**< @brief LZ4 acceleration for large parcels (1 is the default level, higher is faster) help description.  */
   long hpx_coalescing_buffersize_arg;	/**< @brief set coalescing buffer size.  */
   char * hpx_coalescing_buffersize_orig;	/**< @brief set coalescing buffer size original value given at command line.  */
   const char *hpx_coalescing_buffersize_help; /**< @brief set coalescing buffer size help description.  */
@@ -223,11 +283,18 @@ struct hpx_options_t
   unsigned int hpx_help_given ;	/**< @brief Whether hpx-help was given.  */
   unsigned int hpx_version_given ;	/**< @brief Whether hpx-version was given.  */
   unsigned int hpx_heapsize_given ;	/**< @brief Whether hpx-heapsize was given.  */
+  unsigned int hpx_heap_segmentsize_given ;	/**< @brief Whether hpx-heap-segmentsize was given.  */
+  unsigned int hpx_hugepages_given ;	/**< @brief Whether hpx-hugepages was given.  */
+  unsigned int hpx_heap_numa_given ;	/**< @brief Whether hpx-heap-numa was given.  */
+  unsigned int hpx_heap_chunkcache_given ;	/**< @brief Whether hpx-heap-chunkcache was given.  */
   unsigned int hpx_gas_given ;	/**< @brief Whether hpx-gas was given.  */
   unsigned int hpx_boot_given ;	/**< @brief Whether hpx-boot was given.  */
   unsigned int hpx_transport_given ;	/**< @brief Whether hpx-transport was given.  */
   unsigned int hpx_network_given ;	/**< @brief Whether hpx-network was given.  */
   unsigned int hpx_statistics_given ;	/**< @brief Whether hpx-statistics was given.  */
+  unsigned int hpx_stats_file_given ;	/**< @brief Whether hpx-stats-file was given.  */
+  unsigned int hpx_stats_interval_given ;	/**< @brief Whether hpx-stats-interval was given.  */
+  unsigned int hpx_stats_actions_given ;	/**< @brief Whether hpx-stats-actions was given.  */
   unsigned int hpx_configfile_given ;	/**< @brief Whether hpx-configfile was given.  */
   unsigned int hpx_threads_given ;	/**< @brief Whether hpx-threads was given.  */
   unsigned int hpx_thread_affinity_given ;	/**< @brief Whether hpx-thread-affinity was given.  */
@@ -246,14 +313,22 @@ struct hpx_options_t
   unsigned int hpx_inst_at_given ;	/**< @brief Whether hpx-inst-at was given.  */
   unsigned int hpx_trace_classes_given ;	/**< @brief Whether hpx-trace-classes was given.  */
   unsigned int hpx_trace_filesize_given ;	/**< @brief Whether hpx-trace-filesize was given.  */
+  unsigned int hpx_trace_buffersize_given ;	/**< @brief Whether hpx-trace-buffersize was given.  */
+  unsigned int hpx_trace_backpressure_given ;	/**< @brief Whether hpx-trace-backpressure was given.  */
   unsigned int hpx_prof_counters_given ;	/**< @brief Whether hpx-prof-counters was given.  */
   unsigned int hpx_prof_detailed_given ;	/**< @brief Whether hpx-prof-detailed was given.  */
   unsigned int hpx_isir_testwindow_given ;	/**< @brief Whether hpx-isir-testwindow was given.  */
   unsigned int hpx_isir_sendlimit_given ;	/**< @brief Whether hpx-isir-sendlimit was given.  */
   unsigned int hpx_isir_recvlimit_given ;	/**< @brief Whether hpx-isir-recvlimit was given.  */
   unsigned int hpx_pwc_parcelbuffersize_given ;	/**< @brief Whether hpx-pwc-parcelbuffersize was given.  */
+  unsigned int hpx_pwc_parcelbuffermax_given ;	/**< @brief Whether hpx-pwc-parcelbuffermax was given.  */
+  unsigned int hpx_pwc_reloadinterval_given ;	/**< @brief Whether hpx-pwc-reloadinterval was given.  */
   unsigned int hpx_pwc_parceleagerlimit_given ;	/**< @brief Whether hpx-pwc-parceleagerlimit was given.  */
+  unsigned int hpx_pwc_regcache_given ;	/**< @brief Whether hpx-pwc-regcache was given.  */
   unsigned int hpx_coll_network_given ;	/**< @brief Whether hpx-coll-network was given.  */
+  unsigned int hpx_coll_segment_given ;	/**< @brief Whether hpx-coll-segment was given.  */
+  unsigned int hpx_agas_tcache_given ;	/**< @brief Whether hpx-agas-tcache was given.  */
+  unsigned int hpx_agas_rebalance_sample_given ;	/**< @brief Whether hpx-agas-rebalance-sample was given.  */
   unsigned int hpx_photon_backend_given ;	/**< @brief Whether hpx-photon-backend was given.  */
   unsigned int hpx_photon_ibdev_given ;	/**< @brief Whether hpx-photon-ibdev was given.  */
   unsigned int hpx_photon_ethdev_given ;	/**< @brief Whether hpx-photon-ethdev was given.  */
@@ -273,6 +348,11 @@ struct hpx_options_t
   unsigned int hpx_photon_usercq_given ;	/**< @brief Whether hpx-photon-usercq was given.  */
   unsigned int hpx_opt_smp_given ;	/**< @brief Whether hpx-opt-smp was given.  */
   unsigned int hpx_parcel_compression_given ;	/**< @brief Whether hpx-parcel-compression was given.  */
+  unsigned int hpx_parcel_compression_threshold_given ;	/**< @brief Whether hpx-parcel-compression-threshold was given.  */
+  unsigned int hpx_parcel_compression_probe_given ;	/**< @brief Whether hpx-parcel-compression-probe was given.  */
+  unsigned int hpx_parcel_compression_bandwidth_given ;	/**< @brief Whether hpx-parcel-compression-bandwidth was given.  */
+  unsigned int hpx_parcel_compression_largesize_given ;	/**< @brief Whether hpx-parcel-compression-largesize was given.  */
+  unsigned int hpx_parcel_compression_accel_given ;	/**< @brief Whether hpx-parcel-compression-accel was given.  */
   unsigned int hpx_coalescing_buffersize_given ;	/**< @brief Whether hpx-coalescing-buffersize was given.  */
 
 } ;
@@ -461,6 +541,8 @@ int hpx_option_parser_string_ext (const char *cmdline, struct hpx_options_t *arg
 int hpx_option_parser_required (struct hpx_options_t *args_info,
   const char *prog_name);
 
+extern const char *hpx_option_parser_hpx_hugepages_values[];  /**< @brief Possible values for hpx-hugepages. */
+extern const char *hpx_option_parser_hpx_heap_numa_values[];  /**< @brief Possible values for hpx-heap-numa. */
 extern const char *hpx_option_parser_hpx_gas_values[];  /**< @brief Possible values for hpx-gas. */
 extern const char *hpx_option_parser_hpx_boot_values[];  /**< @brief Possible values for hpx-boot. */
 extern const char *hpx_option_parser_hpx_transport_values[];  /**< @brief Possible values for hpx-transport. */
@@ -49,6 +49,19 @@ static int _my_typed_handler(int i, float f, char c) {
 }
 auto mth = hpx::make_action(_my_typed_handler);
 
+static int _my_mixed_handler(double d, std::size_t s, char c, int i) {
+  printf("Hi, I am a typed action with args: %f %zu %c %d!\n", d, s, c, i);
+  return (d == 2.5 && s == 42 && c == 'x' && i == -7) ? HPX_SUCCESS : HPX_ERROR;
+}
+auto mmh = hpx::make_action(_my_mixed_handler);
+
+static int _my_pinned_handler(int *local, int i) {
+  *local = i;
+  return HPX_SUCCESS;
+}
+auto mph = hpx::make_action<HPX_DEFAULT, HPX_PINNED,
+                            decltype(_my_pinned_handler)>(_my_pinned_handler);
+
 int hello(int a) {
   std::cout << "Rank#" << hpx_get_my_rank() << " received " << a << "." << std::endl;
   return HPX_SUCCESS;
@@ -70,6 +83,23 @@ int main_act(int arg) {
   int r, i = 1; float f = 3.0; char c = 'b';
   mth.call_sync(HPX_HERE, r, i, f, c);
 
+  double d = 2.5; std::size_t s = 42; char x = 'x'; int m = -7;
+  mmh.call_sync(HPX_HERE, r, d, s, x, m);
+
+  hpx_addr_t addr = hpx_gas_alloc_local(1, sizeof(int), 0);
+  hpx_addr_t done = hpx_lco_future_new(0);
+  int v = 42;
+  mph.call(addr, done, v);
+  hpx_lco_wait(done);
+  hpx_lco_delete(done, HPX_NULL);
+  int *local;
+  if (!hpx_gas_try_pin(addr, (void**)&local) || *local != v) {
+    std::cerr << "pinned typed action failed" << std::endl;
+    hpx::exit(HPX_ERROR);
+  }
+  hpx_gas_unpin(addr);
+  hpx_gas_free(addr, HPX_NULL);
+
   hpx::exit(HPX_SUCCESS);
 }
 auto ma = hpx::make_action(main_act);
@@ -83,8 +113,8 @@ int main(int argc, char* argv[]) {
   }
   int a = hpx_get_my_rank() + 1;
 
-  ma.run(a);
+  e = ma.run(a);
   
   hpx::finalize();
-  return 0;
+  return e;
 }
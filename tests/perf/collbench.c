@@ -25,6 +25,11 @@
 ///
 /// The included micro-benchmarks are:
 /// 1. allreduce
+/// 2. process allreduce
+///
+/// Each benchmark is run for a sweep of payload sizes, doubling from the
+/// minimum to the maximum size, and reports the average latency and the
+/// per-participant bandwidth.
 
 /// Allreduce "reduction" operations.
 static void _init_handler(unsigned char *id, const size_t size) {
@@ -45,8 +50,8 @@ static HPX_ACTION(HPX_FUNCTION, 0, _min, _min_handler);
 /// Use a set-get pair for the allreduce operation.
 static int
 _allreduce_set_get_handler(hpx_addr_t allreduce, int iters, size_t size) {
-  unsigned char sbuf[size];
-  unsigned char rbuf[size];
+  unsigned char *sbuf = malloc(size);
+  unsigned char *rbuf = malloc(size);
 
   for (int i = 0, e = size; i < e; ++i) {
     sbuf[i] = rand();
@@ -56,6 +61,8 @@ _allreduce_set_get_handler(hpx_addr_t allreduce, int iters, size_t size) {
     hpx_lco_set_lsync(allreduce, size, sbuf, HPX_NULL);
     hpx_lco_get(allreduce, size, rbuf);
   }
+  free(rbuf);
+  free(sbuf);
   return HPX_SUCCESS;
 }
 static HPX_ACTION(HPX_DEFAULT, 0, _allreduce_set_get,
@@ -64,8 +71,8 @@ static HPX_ACTION(HPX_DEFAULT, 0, _allreduce_set_get,
 /// Use a synchronous join for the allreduce operation.
 static int
 _allreduce_join_handler(hpx_addr_t allreduce, int iters, size_t size) {
-  unsigned char sbuf[size];
-  unsigned char rbuf[size];
+  unsigned char *sbuf = malloc(size);
+  unsigned char *rbuf = malloc(size);
 
   for (int i = 0, e = size; i < e; ++i) {
     sbuf[i] = rand();
@@ -78,6 +85,8 @@ _allreduce_join_handler(hpx_addr_t allreduce, int iters, size_t size) {
     hpx_lco_wait_reset(f);
   }
   hpx_lco_delete(f, HPX_NULL);
+  free(rbuf);
+  free(sbuf);
   return HPX_SUCCESS;
 }
 static HPX_ACTION(HPX_DEFAULT, 0, _allreduce_join, _allreduce_join_handler,
@@ -86,8 +95,8 @@ static HPX_ACTION(HPX_DEFAULT, 0, _allreduce_join, _allreduce_join_handler,
 /// Use join-sync for the allreduce operation.
 static int
 _allreduce_join_sync_handler(hpx_addr_t allreduce, int iters, size_t size) {
-  unsigned char sbuf[size];
-  unsigned char rbuf[size];
+  unsigned char *sbuf = malloc(size);
+  unsigned char *rbuf = malloc(size);
 
   for (int i = 0, e = size; i < e; ++i) {
     sbuf[i] = rand();
@@ -97,6 +106,8 @@ _allreduce_join_sync_handler(hpx_addr_t allreduce, int iters, size_t size) {
   for (int i = 0; i < iters; ++i) {
     hpx_lco_allreduce_join_sync(allreduce, id, size, sbuf, rbuf);
   }
+  free(rbuf);
+  free(sbuf);
   return HPX_SUCCESS;
 }
 static HPX_ACTION(HPX_DEFAULT, 0, _allreduce_join_sync,
@@ -113,6 +124,13 @@ _fill_node_handler(hpx_action_t op, hpx_addr_t done, hpx_addr_t allreduce, int i
 static HPX_ACTION(HPX_DEFAULT, 0, _fill_node, _fill_node_handler,
                   HPX_ACTION_T, HPX_ADDR, HPX_ADDR, HPX_INT, HPX_SIZE_T);
 
+static void _report(const char *name, size_t size, int iters, double elapsed) {
+  double latency = elapsed / iters;
+  double bandwidth = (latency > 0) ? (size / 1e6) / (latency / 1e3) : 0;
+  printf("%-24s %10zu %14.7f %12.2f\n", name, size, latency, bandwidth);
+  fflush(stdout);
+}
+
 /// A utility that tests a certain leaf function through I iterations.
 static int _benchmark(char *name, hpx_action_t op, int iters, size_t size) {
   int ranks = HPX_LOCALITIES * HPX_THREADS;
@@ -124,31 +142,95 @@ static int _benchmark(char *name, hpx_action_t op, int iters, size_t size) {
   double elapsed = hpx_time_elapsed_ms(start);
   hpx_lco_delete(allreduce, HPX_NULL);
   hpx_lco_delete(done, HPX_NULL);
-  printf("%s: %.7f\n", name, elapsed/iters);
+  _report(name, size, iters, elapsed);
   return HPX_SUCCESS;
 }
 #define _XSTR(s) _STR(s)
 #define _STR(l) #l
 #define _BENCHMARK(op, iters, size) _benchmark(_XSTR(op), op, iters, size)
 
+/// The process allreduce has one subscriber per locality.
+static hpx_addr_t _process_future;
+static int32_t _process_id;
+
+static int _process_subscribe_handler(hpx_addr_t allreduce, size_t size) {
+  _process_future = hpx_lco_future_new(size);
+  _process_id = hpx_process_collective_allreduce_subscribe(allreduce,
+                                                           hpx_lco_set_action,
+                                                           _process_future);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _process_subscribe,
+                  _process_subscribe_handler, HPX_ADDR, HPX_SIZE_T);
+
+static int _process_unsubscribe_handler(hpx_addr_t allreduce) {
+  hpx_process_collective_allreduce_unsubscribe(allreduce, _process_id);
+  hpx_lco_delete_sync(_process_future);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _process_unsubscribe,
+                  _process_unsubscribe_handler, HPX_ADDR);
+
+static int
+_process_allreduce_handler(hpx_addr_t allreduce, int iters, size_t size) {
+  unsigned char *sbuf = malloc(size);
+  unsigned char *rbuf = malloc(size);
+
+  for (int i = 0, e = size; i < e; ++i) {
+    sbuf[i] = rand();
+  }
+
+  for (int i = 0; i < iters; ++i) {
+    hpx_process_collective_allreduce_join(allreduce, _process_id, size, sbuf);
+    hpx_lco_get_reset(_process_future, size, rbuf);
+  }
+  free(rbuf);
+  free(sbuf);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _process_allreduce,
+                  _process_allreduce_handler, HPX_ADDR, HPX_INT, HPX_SIZE_T);
+
+static int _process_benchmark(int iters, size_t size) {
+  hpx_addr_t allreduce = hpx_process_collective_allreduce_new(size, _init,
+                                                              _min);
+  hpx_bcast_rsync(_process_subscribe, &allreduce, &size);
+  hpx_process_collective_allreduce_subscribe_finalize(allreduce);
+
+  hpx_time_t start = hpx_time_now();
+  hpx_bcast_rsync(_process_allreduce, &allreduce, &iters, &size);
+  double elapsed = hpx_time_elapsed_ms(start);
+
+  hpx_bcast_rsync(_process_unsubscribe, &allreduce);
+  hpx_process_collective_allreduce_delete(allreduce);
+  _report("_process_allreduce", size, iters, elapsed);
+  return HPX_SUCCESS;
+}
+
 static HPX_ACTION_DECL(_main);
-static int _main_action(int iters, size_t size) {
-  printf("collbench(iters=%d, size=%zu)\n", iters, size);
-  printf("time resolution: milliseconds\n");
+static int _main_action(int iters, size_t min, size_t max) {
+  printf("collbench(iters=%d, min=%zu, max=%zu)\n", iters, min, max);
+  printf("%-24s %10s %14s %12s\n", "# benchmark", "bytes", "latency (ms)",
+         "MB/s");
   fflush(stdout);
 
-  _BENCHMARK(_allreduce_set_get, iters, size);
-  _BENCHMARK(_allreduce_join, iters, size);
-  _BENCHMARK(_allreduce_join_sync, iters, size);
+  for (size_t size = min; size <= max; size *= 2) {
+    _BENCHMARK(_allreduce_set_get, iters, size);
+    _BENCHMARK(_allreduce_join, iters, size);
+    _BENCHMARK(_allreduce_join_sync, iters, size);
+    _process_benchmark(iters, size);
+  }
 
   hpx_exit(HPX_SUCCESS);
 }
-static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_action, HPX_INT, HPX_SIZE_T);
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_action, HPX_INT, HPX_SIZE_T,
+                  HPX_SIZE_T);
 
 static void _usage(FILE *f, int error) {
-  fprintf(f, "Usage: collbench -i iters -s size\n"
+  fprintf(f, "Usage: collbench -i iters -s size -m max\n"
              "\t -i iters: number of iterations\n"
-             "\t -s  size: size of the buffer to use for the collective\n"
+             "\t -s  size: smallest buffer size to use for the collective\n"
+             "\t -m   max: largest buffer size to use for the collective\n"
              "\t -h      : show help\n");
   hpx_print_help();
   fflush(f);
@@ -164,8 +246,9 @@ int main(int argc, char *argv[]) {
 
   int iters = 100;
   size_t size = 8;
+  size_t max = 0;
   int opt = 0;
-  while ((opt = getopt(argc, argv, "i:s:h?")) != -1) {
+  while ((opt = getopt(argc, argv, "i:s:m:h?")) != -1) {
     switch (opt) {
      case 'i':
        iters = atoi(optarg);
@@ -173,6 +256,9 @@ int main(int argc, char *argv[]) {
      case 's':
        size = atoi(optarg);
        break;
+     case 'm':
+       max = atoi(optarg);
+       break;
      case 'h':
        _usage(stdout, EXIT_SUCCESS);
      default:
@@ -183,7 +269,11 @@ int main(int argc, char *argv[]) {
   argc -= optind;
   argv += optind;
 
-  e = hpx_run(&_main, &iters, &size);
+  if (max < size) {
+    max = size;
+  }
+
+  e = hpx_run(&_main, &iters, &size, &max);
   assert(e == HPX_SUCCESS);
   hpx_finalize();
 }
@@ -19,7 +19,10 @@
 
 static void _usage(FILE *stream) {
   fprintf(stream, "Usage: time_gas_addr_trans [options]\n"
-          "\t-h, this help display\n");
+          "\t-h, this help display\n"
+          "\nUnder AGAS, run with --hpx-statistics to report the translation "
+          "cache hit\nrate, and with --hpx-agas-tcache=0 to measure the "
+          "uncached baseline.\n");
   hpx_print_help();
   fflush(stream);
 }
@@ -33,6 +36,7 @@ static hpx_action_t _main = 0;
 
 #define TEST_BUF_SIZE (1024*64) //64k
 #define FIELD_WIDTH 20
+#define HOT_BLOCKS 4
 
 static int num[] = {
   10000,
@@ -59,6 +63,21 @@ static int _address_translation_action(void* args, size_t size) {
   return hpx_thread_continue(NULL, 0);
 }
 
+typedef struct {
+  hpx_addr_t   base;
+  hpx_addr_t   done;
+  uint32_t   blocks;
+} _hot_args_t;
+
+// Send a translation request to one of a small set of hot blocks. This runs
+// in parallel so that every worker looks up the same few blocks repeatedly.
+static int _hot_call(int i, void *args) {
+  const _hot_args_t *hot = args;
+  hpx_addr_t block = hpx_addr_add(hot->base, (i % hot->blocks) * TEST_BUF_SIZE,
+                                  TEST_BUF_SIZE);
+  return hpx_call(block, _address_translation, hot->done, 0, 0);
+}
+
 static int _main_action(void *args, size_t n) {
   hpx_time_t now;
   double elapsed;
@@ -69,9 +88,9 @@ static int _main_action(void *args, size_t n) {
   fprintf(stdout, HEADER);
   fprintf(stdout, "localities: %d, ranks and blocks per rank = %d, %d\n",
                   size, ranks, blocks/ranks);
-  fprintf(stdout, "%s%*s%*s%*s\n", "# Num threads ", FIELD_WIDTH,
+  fprintf(stdout, "%s%*s%*s%*s%*s\n", "# Num threads ", FIELD_WIDTH,
           "GAS ALLOC", FIELD_WIDTH, "GLOBAL_ALLOC", FIELD_WIDTH,
-          "GLOBAL_CALLOC");
+          "GLOBAL_CALLOC", FIELD_WIDTH, "HOT_BLOCKS");
 
   for (int i = 0; i < sizeof(num)/sizeof(num[0]); i++) {
     fprintf(stdout, "%d", num[i]);
@@ -109,6 +128,19 @@ static int _main_action(void *args, size_t n) {
     hpx_lco_delete(and, HPX_NULL);
     hpx_gas_free(callocMem, HPX_NULL);
 
+    _hot_args_t hot = {
+      .base = hpx_gas_alloc_cyclic(HOT_BLOCKS * ranks, TEST_BUF_SIZE, 0),
+      .done = hpx_lco_and_new(num[i]),
+      .blocks = HOT_BLOCKS * ranks
+    };
+    now = hpx_time_now();
+    hpx_par_for_sync(_hot_call, 0, num[i], &hot);
+    elapsed = hpx_time_elapsed_ms(now)/1e3;
+    hpx_lco_wait(hot.done);
+    fprintf(stdout, "%*.7f", FIELD_WIDTH,  elapsed);
+    hpx_lco_delete(hot.done, HPX_NULL);
+    hpx_gas_free(hot.base, HPX_NULL);
+
     fprintf(stdout, "\n");
   }
   hpx_exit(HPX_SUCCESS);
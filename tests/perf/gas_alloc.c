@@ -39,6 +39,34 @@ static void usage(FILE *stream) {
 
 static hpx_action_t _main    = 0;
 
+/// Allocate and free local global memory in a loop. Each worker runs one of
+/// these concurrently to measure allocation throughput under contention.
+static int _alloc_loop(int i, void *args) {
+  size_t size = *(size_t*)args;
+  int n = (size < MAX_BYTES) ? loop : LOOP_LARGE;
+  for (int j = 0; j < n; ++j) {
+    hpx_addr_t local = hpx_gas_alloc_local(1, size, 0);
+    hpx_gas_free_sync(local);
+  }
+  return HPX_SUCCESS;
+}
+
+/// Report the concurrent allocation throughput, in allocations per second.
+static void _concurrent(void) {
+  int threads = HPX_THREADS;
+  fprintf(stdout, "# CONCURRENT LOCAL ALLOC/FREE THROUGHPUT (allocs/s), "
+          "%d workers\n", threads);
+  fprintf(stdout, "%s\t%*s\n", "# Size ", HEADER_FIELD_WIDTH, " ALLOCS/S ");
+  for (size_t size = 1; size <= 4 * MAX_BYTES; size *= 4) {
+    int n = (size < MAX_BYTES) ? loop : LOOP_LARGE;
+    hpx_time_t t = hpx_time_now();
+    hpx_par_for_sync(_alloc_loop, 0, threads, &size);
+    double s = hpx_time_elapsed_ms(t) / 1e3;
+    fprintf(stdout, "%-*zu%*.0f\n", 10, size, FIELD_WIDTH,
+            (double)threads * n / s);
+  }
+}
+
 static int _main_action(void *args, size_t n) {
   hpx_addr_t local, global, calloc_global;
   hpx_time_t t;
@@ -81,6 +109,8 @@ static int _main_action(void *args, size_t n) {
     fprintf(stdout, "%*g", FIELD_WIDTH, hpx_time_elapsed_ms(t));
     fprintf(stdout, "\n");
   }
+
+  _concurrent();
   hpx_exit(HPX_SUCCESS);
 }
 
@@ -45,6 +45,12 @@ static void _address_translation_action(int n) {
     prof_start_timing("deep_test", &tag);
     prof_stop_timing("deep_test", &tag);
   }
+
+  int id = prof_register_event("deep_test_id", SIMPLE);
+  for(int i = 0; i < num[0]; i++){
+    prof_start_timing_id(id, &tag);
+    prof_stop_timing_id(id, &tag);
+  }
 }
 
 static int _main_action(void *args, size_t n) {
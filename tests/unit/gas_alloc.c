@@ -16,9 +16,15 @@
 // 3. hpx_gas_try_pin() -- Performs address translation.
 // 4. hpx_gas_unpin() -- Allows an address to be remapped.
 
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <hpx/hpx.h>
+#include <libhpx/config.h>
+#include <libhpx/locality.h>
 #include "tests.h"
 
 static const int N = 10;
@@ -178,10 +184,80 @@ static int gas_calloc_at_handler(void) {
 }
 static HPX_ACTION(HPX_DEFAULT, 0, gas_calloc_at, gas_calloc_at_handler);
 
+// The blocks that the fill test allocates, as a fraction of the heap. Global
+// allocations may only be able to use half of the heap, so we fill 3/8 of it.
+static const size_t FILL_BLOCKS = 24;
+static const size_t HEAP_BLOCKS = 64;
+
+static int _fill_handler(int n, hpx_addr_t filled, hpx_addr_t release) {
+  size_t bytes = here->config->heapsize / HEAP_BLOCKS;
+  hpx_addr_t blocks[n];
+  for (int i = 0; i < n; ++i) {
+    blocks[i] = hpx_gas_alloc_local(1, bytes, 0);
+    if (!blocks[i]) {
+      fflush(stdout);
+      fprintf(stderr, "failed to allocate fill block %d\n", i);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // Hold the blocks until every worker has filled its share of the heap, so
+  // that the frees land in different workers' caches.
+  hpx_lco_set(filled, 0, NULL, HPX_NULL, HPX_NULL);
+  hpx_lco_wait(release);
+  for (int i = 0; i < n; ++i) {
+    hpx_gas_free(blocks[i], HPX_NULL);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _fill, _fill_handler, HPX_INT, HPX_ADDR,
+                  HPX_ADDR);
+
+static int gas_alloc_fill_handler(void) {
+  printf("Starting the GAS fill and large allocation test\n");
+  int threads = hpx_get_num_threads();
+  int n = (FILL_BLOCKS + threads - 1) / threads;
+  hpx_addr_t filled = hpx_lco_and_new(threads);
+  hpx_addr_t release = hpx_lco_future_new(0);
+  hpx_addr_t done = hpx_lco_and_new(threads);
+  for (int i = 0; i < threads; ++i) {
+    hpx_call(HPX_HERE, _fill, done, &n, &filled, &release);
+  }
+  hpx_lco_wait(filled);
+  hpx_lco_set(release, 0, NULL, HPX_NULL, HPX_NULL);
+  hpx_lco_wait(done);
+  hpx_lco_delete(filled, HPX_NULL);
+  hpx_lco_delete(release, HPX_NULL);
+  hpx_lco_delete(done, HPX_NULL);
+
+  // The freed chunks may all be sitting in the workers' caches, which must be
+  // flushed to satisfy a request as large as everything we just freed.
+  size_t bytes = FILL_BLOCKS * (here->config->heapsize / HEAP_BLOCKS);
+  hpx_addr_t large = hpx_gas_alloc_local(1, bytes, 0);
+  if (!large) {
+    fflush(stdout);
+    fprintf(stderr, "failed to allocate %zu bytes after a fill\n", bytes);
+    exit(EXIT_FAILURE);
+  }
+
+  char *buffer = NULL;
+  if (!hpx_gas_try_pin(large, (void**)&buffer)) {
+    fflush(stdout);
+    fprintf(stderr, "large allocation returned non-local memory\n");
+    exit(EXIT_FAILURE);
+  }
+  buffer[0] = buffer[bytes - 1] = 1;
+  hpx_gas_unpin(large);
+  hpx_gas_free(large, HPX_NULL);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, gas_alloc_fill, gas_alloc_fill_handler);
+
 TEST_MAIN({
     ADD_TEST(gas_alloc, 0);
     ADD_TEST(gas_alloc_at, 0);
     ADD_TEST(gas_calloc, 0);
     ADD_TEST(gas_calloc_at, 0);
     ADD_TEST(gas_memalign, 0);
+    ADD_TEST(gas_alloc_fill, 0);
   });
@@ -11,6 +11,7 @@
 //  Extreme Scale Technologies (CREST).
 // =============================================================================
 
+#include <libhpx/libhpx.h>
 #include <hpx/hpx.h>
 #include "tests.h"
 
@@ -23,7 +24,8 @@ typedef enum {
 
 typedef enum {
   _cyclic = 0,
-  _blocked
+  _blocked,
+  _user
 } _dist_type;
 
 static int _block_rank_handler(hpx_addr_t base) {
@@ -34,6 +36,11 @@ static int _block_rank_handler(hpx_addr_t base) {
 }
 HPX_ACTION(HPX_DEFAULT, 0, _block_rank, _block_rank_handler, HPX_ADDR);
 
+// A user-defined distribution that places 2 consecutive blocks per locality.
+static hpx_addr_t _user_dist(uint32_t i, size_t n, uint32_t bsize) {
+  return HPX_THERE(i / 2);
+}
+
 static void _init_handler(int *input, const size_t bytes) {
   *input = 0;
 }
@@ -54,18 +61,26 @@ static HPX_ACTION(HPX_FUNCTION, 0, _add, _add_handler);
 //
 // _blocked
 // rank  0 0 1 1 2 2 3 3 . . n-1  n-1
-// block 0 1 2 3 4 5 6 7 . .  2n 2n-1
+// block 0 1 2 3 4 5 6 7 . . 2n-2 2n-1
 //
-// sum(rank_i * block_i) = ???
-// not sure if there's a closed-form expr for this
+// sum(rank_i * block_i) = sum(i * (i/2)) for i in [0, 2n)
+//
+// _user
+// The same as _blocked under AGAS. Other global address spaces use a cyclic
+// layout for user-defined distributions.
 //
 static int _verify(_dist_type dist) {
   int n = HPX_LOCALITIES;
+  if (dist == _user) {
+    const libhpx_config_t *cfg = libhpx_get_config();
+    dist = (cfg->gas == HPX_GAS_AGAS) ? _blocked : _cyclic;
+  }
+
   if (dist == _cyclic) {
     return ((7*n*n*n) - (9*n*n) + (2*n))/6;
   } else if (dist == _blocked) {
     int expected = 0;
-    for (int i = 0; i < n; ++i) {
+    for (int i = 0; i < 2 * n; ++i) {
       expected += i * (i/2);
     }
     return expected;
@@ -83,15 +98,31 @@ static int _run_test(_alloc_type alloc, _dist_type dist) {
     alloc_fn = hpx_gas_alloc_blocked;
   } else if (dist == _blocked && alloc == _calloc) {
     alloc_fn = hpx_gas_calloc_blocked;
+  } else if (dist == _user) {
+    alloc_fn = NULL;
   } else {
     printf("unknown dist or alloc type.\n");
     return HPX_ERROR;
   }
 
+  // Blocked distributions are only implemented by AGAS.
+  const libhpx_config_t *cfg = libhpx_get_config();
+  if (dist == _blocked && cfg->gas != HPX_GAS_AGAS) {
+    printf("blocked allocation requires AGAS, skipping.\n");
+    return HPX_SUCCESS;
+  }
+
   int e = HPX_SUCCESS;
   int blocks = 2*HPX_LOCALITIES;
   hpx_addr_t sum_lco = hpx_lco_reduce_new(blocks, sizeof(int), _init, _add);
-  hpx_addr_t data = alloc_fn(blocks, blocksize, 0);
+  hpx_addr_t data;
+  if (dist == _user && alloc == _alloc) {
+    data = hpx_gas_alloc(blocks, blocksize, 0, _user_dist, HPX_GAS_ATTR_NONE);
+  } else if (dist == _user && alloc == _calloc) {
+    data = hpx_gas_calloc(blocks, blocksize, 0, _user_dist, HPX_GAS_ATTR_NONE);
+  } else {
+    data = alloc_fn(blocks, blocksize, 0);
+  }
   hpx_gas_bcast_with_continuation(_block_rank, data, blocks, 0, blocksize,
                                   hpx_lco_set_action, sum_lco, &data);
   int sum;
@@ -135,9 +166,23 @@ static int gas_calloc_blocked_handler(void) {
 static HPX_ACTION(HPX_DEFAULT, 0, gas_calloc_blocked,
                   gas_calloc_blocked_handler);
 
+static int gas_alloc_user_handler(void) {
+  return _run_test(_alloc, _user);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, gas_alloc_user,
+                  gas_alloc_user_handler);
+
+static int gas_calloc_user_handler(void) {
+  return _run_test(_calloc, _user);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, gas_calloc_user,
+                  gas_calloc_user_handler);
+
 TEST_MAIN({
     ADD_TEST(gas_alloc_cyclic, 0);
     ADD_TEST(gas_calloc_cyclic, 0);
-    // ADD_TEST(gas_alloc_blocked, 0);
-    // ADD_TEST(gas_calloc_blocked, 0);
+    ADD_TEST(gas_alloc_blocked, 0);
+    ADD_TEST(gas_calloc_blocked, 0);
+    ADD_TEST(gas_alloc_user, 0);
+    ADD_TEST(gas_calloc_user, 0);
 });
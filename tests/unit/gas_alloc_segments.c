@@ -0,0 +1,129 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+// Goal of this testcase is to test a global heap that grows on demand.
+// 1. Allocations that span many heap segments are backed by memory.
+// 2. Freed segments can be committed again by later allocations.
+// 3. A single allocation can span segments that were used and released.
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hpx/hpx.h>
+#include <libhpx/config.h>
+#include <libhpx/locality.h>
+#include "tests.h"
+
+// The segment size that we run with. Segments are rounded up to the allocator's
+// chunk size, so this is as small as they get.
+#define SEGMENT_SIZE "4194304"
+
+// The blocks that we allocate, as a fraction of the heap. Global allocations
+// may only be able to use half of the heap, so we use 1/8 of it.
+static const size_t BLOCKS = 8;
+static const size_t HEAP_BLOCKS = 64;
+
+/// Write to every byte of a block, which faults if its segments aren't
+/// committed, and then read the block back.
+static void _touch(hpx_addr_t block, size_t bytes, char c) {
+  char *buffer = NULL;
+  if (!hpx_gas_try_pin(block, (void**)&buffer)) {
+    fflush(stdout);
+    fprintf(stderr, "gas alloc returned non-local memory\n");
+    exit(EXIT_FAILURE);
+  }
+
+  memset(buffer, c, bytes);
+  for (size_t i = 0; i < bytes; i += HPX_PAGE_SIZE) {
+    if (buffer[i] != c) {
+      fflush(stdout);
+      fprintf(stderr, "heap memory at offset %zu was not written\n", i);
+      exit(EXIT_FAILURE);
+    }
+  }
+  hpx_gas_unpin(block);
+}
+
+static void _free_sync(hpx_addr_t block) {
+  hpx_addr_t done = hpx_lco_future_new(0);
+  hpx_gas_free(block, done);
+  hpx_lco_wait(done);
+  hpx_lco_delete(done, HPX_NULL);
+}
+
+static int gas_alloc_segments_handler(void) {
+  printf("Starting the GAS segmented heap test\n");
+  size_t bytes = here->config->heapsize / HEAP_BLOCKS;
+  hpx_addr_t blocks[BLOCKS];
+
+  // Grow the heap, free everything back, and then grow it again.
+  for (int round = 0; round < 2; ++round) {
+    for (size_t i = 0; i < BLOCKS; ++i) {
+      blocks[i] = hpx_gas_alloc_local(1, bytes, 0);
+      if (!blocks[i]) {
+        fflush(stdout);
+        fprintf(stderr, "failed to allocate block %zu in round %d\n", i, round);
+        exit(EXIT_FAILURE);
+      }
+      _touch(blocks[i], bytes, round + 1);
+    }
+
+    for (size_t i = 0; i < BLOCKS; ++i) {
+      _free_sync(blocks[i]);
+    }
+  }
+
+  size_t total = BLOCKS * bytes;
+  hpx_addr_t large = hpx_gas_alloc_local(1, total, 0);
+  if (!large) {
+    fflush(stdout);
+    fprintf(stderr, "failed to allocate %zu bytes after a release\n", total);
+    exit(EXIT_FAILURE);
+  }
+  _touch(large, total, 3);
+  _free_sync(large);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, gas_alloc_segments,
+                  gas_alloc_segments_handler);
+
+static int _main_handler(void) {
+  ADD_TEST(gas_alloc_segments, 0);
+  ADD_TEST(gas_alloc_segments, HPX_LOCALITIES - 1);
+  hpx_exit(HPX_SUCCESS);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler);
+
+int main(int argc, char *argv[]) {
+  // Run with a heap that grows in small segments, in addition to any options
+  // that we were given.
+  char *args[argc + 2];
+  memcpy(args, argv, argc * sizeof(argv[0]));
+  args[argc] = "--hpx-heap-segmentsize=" SEGMENT_SIZE;
+  args[argc + 1] = NULL;
+
+  int n = argc + 1;
+  char **v = args;
+  if (hpx_init(&n, &v)) {
+    fprintf(stderr, "failed to initialize HPX.\n");
+    return 1;
+  }
+
+  int e = hpx_run(&_main);
+  hpx_finalize();
+  return e;
+}
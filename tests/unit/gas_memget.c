@@ -127,6 +127,61 @@ void test_memget_sync(void *buffer, size_t n, hpx_addr_t block) {
   verify(buffer);
 }
 
+/// Test the gas_memget_vec and gas_memget_strided operations.
+///
+/// This gathers the block in reverse quarters, and then as separate strided
+/// even and odd elements.
+///
+/// @param       buffer The local buffer to get into.
+/// @param            n The number of bytes to get.
+/// @param        block The global address to get from.
+void test_memget_vec(void *buffer, size_t n, hpx_addr_t block) {
+  char *b = buffer;
+  size_t q = n / 4;
+  hpx_gas_iovec_t iov[4];
+  for (int i = 0; i < 4; ++i) {
+    iov[i].local = b + (3 - i) * q;
+    iov[i].global = hpx_addr_add(block, (3 - i) * q, n);
+    iov[i].size = q;
+  }
+
+  hpx_addr_t lsync = hpx_lco_future_new(0);
+  CHECK( hpx_gas_memget_vec(iov, 4, lsync) );
+  CHECK( hpx_lco_wait(lsync) );
+  hpx_lco_delete_sync(lsync);
+  verify(buffer);
+
+  CHECK( hpx_gas_memget_vec_sync(iov, 4) );
+  verify(buffer);
+
+  size_t m = sizeof(uint64_t);
+  hpx_addr_t odd = hpx_addr_add(block, m, n);
+  lsync = hpx_lco_and_new(2);
+  CHECK( hpx_gas_memget_strided(b, 2 * m, block, 2 * m, m, ELEMENTS / 2, n,
+                                lsync) );
+  CHECK( hpx_gas_memget_strided(b + m, 2 * m, odd, 2 * m, m, ELEMENTS / 2, n,
+                                lsync) );
+  CHECK( hpx_lco_wait(lsync) );
+  hpx_lco_delete_sync(lsync);
+  verify(buffer);
+}
+
+/// Test a gas_memget_vec that gathers from both the remote and local blocks.
+///
+/// @param       buffer The local buffer to get into.
+/// @param            n The number of bytes to get.
+void test_memget_vec_mixed(void *buffer, size_t n) {
+  char *b = buffer;
+  size_t h = n / 2;
+  hpx_gas_iovec_t iov[] = {
+    { b, remote, h },
+    { NULL, HPX_NULL, 0 },
+    { b + h, hpx_addr_add(local, h, n), h }
+  };
+  CHECK( hpx_gas_memget_vec_sync(iov, 3) );
+  verify(buffer);
+}
+
 /// Run all the tests for a particular buffer.
 ///
 /// This will run memget and memget_sync from a local and remote block.
@@ -142,6 +197,12 @@ void test_all(void *buffer, size_t n) {
   test_memget(buffer, n, local);
   printf("Testing gas_memget from a remote block\n");
   test_memget(buffer, n, remote);
+  printf("Testing gas_memget_vec from a local block\n");
+  test_memget_vec(buffer, n, local);
+  printf("Testing gas_memget_vec from a remote block\n");
+  test_memget_vec(buffer, n, remote);
+  printf("Testing gas_memget_vec from local and remote blocks\n");
+  test_memget_vec_mixed(buffer, n);
 }
 
 /// Test memget to a stack location.
@@ -172,6 +172,69 @@ void test_memput_rsync(const uint64_t *buffer, size_t n, hpx_addr_t block) {
   CHECK( hpx_call_sync(block, verify, NULL, 0, buffer, n) );
 }
 
+/// Instantiate a single hpx_gas_memput_vec test.
+///
+/// This will allocate lsync and rsync lcos at @p lat and @p rat, respectively,
+/// and put the buffer in reverse quarters.
+///
+/// @param       buffer The local buffer to put from.
+/// @param            n The number of bytes to put.
+/// @param        block The global address to put into.
+/// @param          lat The locality to allocate the lsync at.
+/// @param          rat The locality to allocate the rsync at.
+void test_vec(const uint64_t *buffer, size_t n, hpx_addr_t block,
+              hpx_addr_t lat, hpx_addr_t rat) {
+  const char *b = (const char*)buffer;
+  size_t q = n / 4;
+  hpx_gas_iovec_t iov[4];
+  for (int i = 0; i < 4; ++i) {
+    iov[i].local = (void*)(b + (3 - i) * q);
+    iov[i].global = hpx_addr_add(block, (3 - i) * q, n);
+    iov[i].size = q;
+  }
+
+  hpx_addr_t lsync = HPX_NULL;
+  hpx_addr_t rsync = HPX_NULL;
+  CHECK( hpx_call_sync(lat, future_at, &lsync, sizeof(lsync)) );
+  CHECK( hpx_call_sync(rat, future_at, &rsync, sizeof(rsync)) );
+  CHECK( hpx_gas_memput_vec(iov, 4, lsync, rsync) );
+  CHECK( hpx_lco_wait(lsync) );
+  CHECK( hpx_lco_wait(rsync) );
+  CHECK( hpx_call_sync(block, verify, NULL, 0, buffer, n) );
+  hpx_lco_delete_sync(lsync);
+  hpx_lco_delete_sync(rsync);
+
+  CHECK( hpx_gas_memput_vec_rsync(iov, 4) );
+  CHECK( hpx_call_sync(block, verify, NULL, 0, buffer, n) );
+}
+
+/// Test the gas_memput_vec and gas_memput_strided operations.
+///
+/// @param       buffer The local buffer to put from.
+/// @param            n The number of bytes to put.
+/// @param        block The global address to put into.
+void test_memput_vec(const uint64_t *buffer, size_t n, hpx_addr_t block) {
+  test_vec(buffer, n, block, HPX_HERE, HPX_HERE);
+  test_vec(buffer, n, block, block, block);
+
+  unsigned here = HPX_LOCALITY_ID;
+  unsigned up = (here + 1) % HPX_LOCALITIES;
+  unsigned down = (here - 1) % HPX_LOCALITIES;
+  test_vec(buffer, n, block, HPX_THERE(up), HPX_THERE(down));
+
+  // put the even and odd elements separately
+  size_t m = sizeof(*buffer);
+  hpx_addr_t odd = hpx_addr_add(block, m, n);
+  hpx_addr_t rsync = hpx_lco_and_new(2);
+  CHECK( hpx_gas_memput_strided(block, 2 * m, buffer, 2 * m, m, ELEMENTS / 2,
+                                n, HPX_NULL, rsync) );
+  CHECK( hpx_gas_memput_strided(odd, 2 * m, buffer + 1, 2 * m, m, ELEMENTS / 2,
+                                n, HPX_NULL, rsync) );
+  CHECK( hpx_lco_wait(rsync) );
+  hpx_lco_delete_sync(rsync);
+  CHECK( hpx_call_sync(block, verify, NULL, 0, buffer, n) );
+}
+
 /// Run all the tests for a particular buffer configuration.
 ///
 /// This will run memput, memput_lsync, and memput_rsync to a local and remote
@@ -192,6 +255,10 @@ void test_all(const uint64_t *buffer, size_t n) {
   test_memput(buffer, n, local);
   printf("Testing hpx_gas_memput to a remote block\n");
   test_memput(buffer, n, remote);
+  printf("Testing hpx_gas_memput_vec to a local block\n");
+  test_memput_vec(buffer, n, local);
+  printf("Testing hpx_gas_memput_vec to a remote block\n");
+  test_memput_vec(buffer, n, remote);
 }
 
 /// Set up the local block with a well-defined pattern so that we can verify
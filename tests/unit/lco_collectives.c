@@ -171,7 +171,124 @@ static int lco_alltoall_handler(void) {
 }
 static HPX_ACTION(HPX_DEFAULT, 0, lco_alltoall, lco_alltoall_handler);
 
+static int _new_gather_handler(int nDoms) {
+  hpx_addr_t gather = hpx_lco_gather_new(nDoms, 1, sizeof(int));
+  return HPX_THREAD_CONTINUE(gather);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _new_gather, _new_gather_handler, HPX_INT);
+
+// Set a gather in two ranges per epoch, and set the next epoch before
+// the current one has been read, which must queue rather than block. The
+// gather is allocated at the last locality so that the ranges are forwarded
+// when there is more than one.
+static int lco_gather_range_handler(void) {
+  int nDoms = 8;
+  hpx_addr_t newdt;
+  hpx_status_t e = hpx_call_sync(HPX_THERE(HPX_LOCALITIES - 1), _new_gather,
+                                 &newdt, sizeof(newdt), &nDoms);
+  test_assert(e == HPX_SUCCESS);
+
+  int values[2][nDoms];
+  for (int i = 0; i < nDoms; ++i) {
+    values[0][i] = i;
+    values[1][i] = i + nDoms;
+  }
+
+  // an empty range still signals both completions
+  hpx_addr_t lsync = hpx_lco_future_new(0);
+  hpx_addr_t rsync = hpx_lco_future_new(0);
+  e = hpx_lco_gather_setid_range(newdt, 0, 0, sizeof(int), values[0], lsync,
+                                 rsync);
+  test_assert(e == HPX_SUCCESS);
+  hpx_lco_wait(lsync);
+  hpx_lco_wait(rsync);
+  hpx_lco_reset_sync(rsync);
+
+  int half = nDoms / 2;
+  e = hpx_lco_gather_setid_range(newdt, 0, half, sizeof(int), values[0],
+                                 HPX_NULL, HPX_NULL);
+  test_assert(e == HPX_SUCCESS);
+  e = hpx_lco_gather_setid_range(newdt, half, nDoms - half, sizeof(int),
+                                 &values[0][half], HPX_NULL, HPX_NULL);
+  test_assert(e == HPX_SUCCESS);
+  // the next epoch is queued, and rsync is signaled once it is applied
+  e = hpx_lco_gather_setid_range(newdt, 0, nDoms, sizeof(int), values[1],
+                                 HPX_NULL, rsync);
+  test_assert(e == HPX_SUCCESS);
+
+  for (int epoch = 0; epoch < 2; ++epoch) {
+    int out[nDoms];
+    e = hpx_lco_get(newdt, sizeof(out), out);
+    test_assert(e == HPX_SUCCESS);
+    for (int i = 0; i < nDoms; ++i) {
+      test_assert(out[i] == values[epoch][i]);
+    }
+    if (epoch == 0) {
+      hpx_lco_wait(rsync);
+    }
+  }
+
+  hpx_lco_delete(lsync, HPX_NULL);
+  hpx_lco_delete(rsync, HPX_NULL);
+  hpx_lco_delete(newdt, HPX_NULL);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_gather_range, lco_gather_range_handler);
+
+static int _alltoall_check_handler(hpx_addr_t alltoall, int rank, int nDoms,
+                                   int epoch) {
+  int out[nDoms];
+  hpx_status_t e = hpx_lco_alltoall_getid(alltoall, rank, sizeof(out), out);
+  test_assert(e == HPX_SUCCESS);
+  for (int i = 0; i < nDoms; ++i) {
+    test_assert(out[i] == epoch * nDoms * nDoms + i * nDoms + rank);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _alltoall_check, _alltoall_check_handler,
+                  HPX_ADDR, HPX_INT, HPX_INT, HPX_INT);
+
+// Set every row of an alltoall with one range operation per epoch, setting
+// the second epoch while the first is still being read.
+static int lco_alltoall_range_handler(void) {
+  int nDoms = 4;
+  hpx_addr_t newdt = hpx_lco_alltoall_new(nDoms, nDoms * sizeof(int));
+
+  // an empty range still signals remote completion
+  hpx_addr_t rsync = hpx_lco_future_new(0);
+  hpx_status_t e = hpx_lco_alltoall_setid_range(newdt, 0, 0, sizeof(int), NULL,
+                                                HPX_NULL, rsync);
+  test_assert(e == HPX_SUCCESS);
+  hpx_lco_wait(rsync);
+  hpx_lco_delete(rsync, HPX_NULL);
+
+  int rows[2][nDoms * nDoms];
+  for (int epoch = 0; epoch < 2; ++epoch) {
+    for (int i = 0; i < nDoms * nDoms; ++i) {
+      rows[epoch][i] = epoch * nDoms * nDoms + i;
+    }
+    e = hpx_lco_alltoall_setid_range(newdt, 0, nDoms, nDoms * sizeof(int),
+                                     rows[epoch], HPX_NULL, HPX_NULL);
+    test_assert(e == HPX_SUCCESS);
+  }
+
+  for (int epoch = 0; epoch < 2; ++epoch) {
+    hpx_addr_t done = hpx_lco_and_new(nDoms);
+    for (int i = 0; i < nDoms; ++i) {
+      hpx_call(HPX_HERE, _alltoall_check, done, &newdt, &i, &nDoms, &epoch);
+    }
+    hpx_lco_wait(done);
+    hpx_lco_delete(done, HPX_NULL);
+  }
+
+  hpx_lco_delete(newdt, HPX_NULL);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_alltoall_range, lco_alltoall_range_handler);
+
 TEST_MAIN({
   ADD_TEST(lco_gather, 0);
   ADD_TEST(lco_alltoall, 0);
+  ADD_TEST(lco_gather_range, 0);
+  ADD_TEST(lco_alltoall_range, 0);
 });
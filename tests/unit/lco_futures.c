@@ -104,7 +104,111 @@ static int lco_future_array_handler(void) {
 }
 static HPX_ACTION(HPX_DEFAULT, 0, lco_future_array, lco_future_array_handler);
 
+// This tests draining a set of futures in completion order with the
+// hpx_lco_any_new() iterator, and the hpx_lco_wait_any() and hpx_lco_get_any()
+// wrappers. The futures are spread across the localities so that both the
+// local and remote watch paths are used.
+#define ANY_COUNT 16
+
+static int _new_future_handler(void) {
+  hpx_addr_t future = hpx_lco_future_new(sizeof(int));
+  return HPX_THREAD_CONTINUE(future);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _new_future, _new_future_handler);
+
+static int _set_index_handler(int i) {
+  return HPX_THREAD_CONTINUE(i);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _set_index, _set_index_handler, HPX_INT);
+
+static int lco_future_any_handler(void) {
+  printf("Starting the completion order LCO test\n");
+  hpx_time_t t1 = hpx_time_now();
+
+  hpx_addr_t futures[ANY_COUNT + 1];
+  for (int i = 0; i < ANY_COUNT; ++i) {
+    int e = hpx_call_sync(HPX_THERE(i % HPX_LOCALITIES), _new_future,
+                          &futures[i], sizeof(futures[i]));
+    assert(e == HPX_SUCCESS);
+  }
+  futures[ANY_COUNT] = HPX_NULL;
+
+  // one of the futures is already failed before we start watching
+  hpx_lco_error_sync(futures[0], HPX_ERROR);
+
+  hpx_lco_any_t *any = hpx_lco_any_new(ANY_COUNT + 1, futures);
+  for (int i = ANY_COUNT - 1; i > 0; --i) {
+    int e = hpx_call(HPX_THERE(i % HPX_LOCALITIES), _set_index, futures[i], &i);
+    assert(e == HPX_SUCCESS);
+  }
+
+  int seen[ANY_COUNT] = {0};
+  hpx_status_t status;
+  for (int n = 0; n < ANY_COUNT; ++n) {
+    int i = hpx_lco_any_next(any, &status);
+    assert(0 <= i && i < ANY_COUNT);
+    assert(!seen[i]);
+    seen[i] = 1;
+    if (i == 0) {
+      assert(status == HPX_ERROR);
+      continue;
+    }
+    assert(status == HPX_SUCCESS);
+    int value = -1;
+    hpx_lco_get(futures[i], sizeof(value), &value);
+    assert(value == i);
+  }
+  assert(hpx_lco_any_next(any, NULL) == -1);
+  hpx_lco_any_delete(any);
+
+  // wait_any and get_any return an LCO that was set
+  assert(hpx_lco_wait_any(ANY_COUNT, futures, &status) >= 0);
+  hpx_lco_delete_all(ANY_COUNT, futures, HPX_NULL);
+
+  // the LCOs that weren't returned can be deleted without ever being set, both
+  // after wait_any and after deleting a completion set that wasn't drained
+  for (int i = 0; i < ANY_COUNT; ++i) {
+    int e = hpx_call_sync(HPX_THERE(i % HPX_LOCALITIES), _new_future,
+                          &futures[i], sizeof(futures[i]));
+    assert(e == HPX_SUCCESS);
+  }
+  int last = ANY_COUNT - 1;
+  int e = hpx_call(HPX_THERE(last % HPX_LOCALITIES), _set_index, futures[last],
+                   &last);
+  assert(e == HPX_SUCCESS);
+  assert(hpx_lco_wait_any(ANY_COUNT, futures, &status) == last);
+  assert(status == HPX_SUCCESS);
+  any = hpx_lco_any_new(ANY_COUNT, futures);
+  assert(hpx_lco_any_next(any, NULL) == last);
+  hpx_lco_any_delete(any);
+  hpx_lco_delete_all(ANY_COUNT, futures, HPX_NULL);
+
+  hpx_addr_t pair[2] = { HPX_NULL, HPX_NULL };
+  assert(hpx_lco_wait_any(2, pair, NULL) == -1);
+
+  e = hpx_call_sync(HPX_THERE(HPX_LOCALITIES - 1), _new_future, &pair[1],
+                    sizeof(pair[1]));
+  assert(e == HPX_SUCCESS);
+  int seven = 7;
+  e = hpx_call(HPX_HERE, _set_index, pair[1], &seven);
+  assert(e == HPX_SUCCESS);
+
+  int value = 0;
+  size_t sizes[2] = { 0, sizeof(value) };
+  void *values[2] = { NULL, &value };
+  int i = hpx_lco_get_any(2, pair, sizes, values, &status);
+  assert(i == 1);
+  assert(status == HPX_SUCCESS);
+  assert(value == seven);
+  hpx_lco_delete(pair[1], HPX_NULL);
+
+  printf(" Elapsed: %g\n", hpx_time_elapsed_ms(t1));
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_future_any, lco_future_any_handler);
+
 TEST_MAIN({
  ADD_TEST(lco_future_new, 0);
  ADD_TEST(lco_future_array, 0);
+ ADD_TEST(lco_future_any, 0);
 });
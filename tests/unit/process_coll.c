@@ -0,0 +1,284 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2016, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+// Goal of this testcase is to test the process collectives other than the
+// allreduce.
+// 1. hpx_process_collective_allgather_new()
+// 2. hpx_process_collective_alltoall_new()
+// 3. hpx_process_collective_bcast_new()
+// 4. hpx_process_collective_reduce_scatter_new()
+//
+// When built with COLL_NETWORK this runs with --hpx-coll-network.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hpx/hpx.h>
+#include "tests.h"
+
+static const int I = 8;
+static const int N = 4;
+
+/// The number of ints in a block.
+#define B 4
+
+enum {
+  ALLGATHER = 0,
+  ALLTOALL,
+  BCAST,
+  REDUCE_SCATTER
+};
+
+/// Initialization operation for an elementwise summation.
+static void _init_handler(int *input, size_t bytes) {
+  memset(input, 0, bytes);
+}
+static HPX_ACTION(HPX_FUNCTION, 0, _init, _init_handler);
+
+/// Elementwise summation.
+static void _sum_handler(int *lhs, const int *rhs, size_t bytes) {
+  for (size_t i = 0, e = bytes / sizeof(int); i < e; ++i) {
+    lhs[i] += rhs[i];
+  }
+}
+static HPX_ACTION(HPX_FUNCTION, 0, _sum, _sum_handler);
+
+/// The value of element @p i of the block sent from @p src to @p dst in
+/// @p epoch.
+static int _f(int src, int dst, int i, int epoch) {
+  return src * 1000 + dst * 100 + epoch * 10 + i;
+}
+
+/// The value of an element once the inputs of the N subscribers at a locality
+/// are reduced, where subscriber k adds k to each element.
+static int _s(int src, int dst, int i, int epoch) {
+  return N * _f(src, dst, i, epoch) + N * (N - 1) / 2;
+}
+
+/// The number of blocks in the input and the result of a collective.
+static int _blocks(int type, int result) {
+  switch (type) {
+   case ALLGATHER: return result ? HPX_LOCALITIES : 1;
+   case ALLTOALL: return HPX_LOCALITIES;
+   case BCAST: return 1;
+   case REDUCE_SCATTER: return result ? 1 : HPX_LOCALITIES;
+  }
+  return 0;
+}
+
+static size_t _bytes(int type, int result) {
+  return _blocks(type, result) * B * sizeof(int);
+}
+
+static hpx_addr_t _new(int type) {
+  switch (type) {
+   case ALLGATHER:
+    return hpx_process_collective_allgather_new(B * sizeof(int), _init, _sum);
+   case ALLTOALL:
+    return hpx_process_collective_alltoall_new(B * sizeof(int), _init, _sum);
+   case BCAST:
+    return hpx_process_collective_bcast_new(B * sizeof(int),
+                                            HPX_LOCALITIES - 1, _init, _sum);
+   case REDUCE_SCATTER:
+    return hpx_process_collective_reduce_scatter_new(B * sizeof(int), _init,
+                                                     _sum);
+  }
+  return HPX_NULL;
+}
+
+/// Write the input of subscriber @p k at this locality.
+static void _input(int type, int k, int epoch, int *in) {
+  int me = HPX_LOCALITY_ID;
+  for (int j = 0, e = _blocks(type, 0); j < e; ++j) {
+    for (int i = 0; i < B; ++i) {
+      int dst = (type == ALLTOALL || type == REDUCE_SCATTER) ? j : 0;
+      in[j * B + i] = _f(me, dst, i, epoch) + k;
+    }
+  }
+}
+
+/// Check the result at this locality.
+static void _check(int type, int epoch, const int *out) {
+  int me = HPX_LOCALITY_ID;
+  for (int j = 0, e = _blocks(type, 1); j < e; ++j) {
+    for (int i = 0; i < B; ++i) {
+      int expected = 0;
+      switch (type) {
+       case ALLGATHER:
+        expected = _s(j, 0, i, epoch);
+        break;
+       case ALLTOALL:
+        expected = _s(j, me, i, epoch);
+        break;
+       case BCAST:
+        expected = _s(HPX_LOCALITIES - 1, 0, i, epoch);
+        break;
+       case REDUCE_SCATTER:
+        for (int src = 0; src < HPX_LOCALITIES; ++src) {
+          expected += _s(src, me, i, epoch);
+        }
+        break;
+      }
+      if (out[j * B + i] != expected) {
+        fprintf(stderr, "type %d epoch %d at %d: block %d element %d is %d, "
+                "expected %d\n", type, epoch, me, j, i, out[j * B + i],
+                expected);
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+}
+
+typedef struct {
+  hpx_addr_t f;
+  int32_t   id;
+} element_t;
+
+#define BSIZE (N * sizeof(element_t))
+
+static int _subscribe_handler(element_t *block, hpx_addr_t coll, int type) {
+  for (int i = 0; i < N; ++i) {
+    block[i].f = hpx_lco_future_new(_bytes(type, 1));
+    block[i].id = hpx_process_collective_allreduce_subscribe(coll,
+                                                             hpx_lco_set_action,
+                                                             block[i].f);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_PINNED, _subscribe, _subscribe_handler,
+                  HPX_POINTER, HPX_ADDR, HPX_INT);
+
+static int _unsubscribe_handler(element_t *block, hpx_addr_t coll) {
+  for (int i = 0; i < N; ++i) {
+    hpx_process_collective_allreduce_unsubscribe(coll, block[i].id);
+    hpx_lco_delete_sync(block[i].f);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_PINNED, _unsubscribe, _unsubscribe_handler,
+                  HPX_POINTER, HPX_ADDR);
+
+static int _join_handler(element_t *element, hpx_addr_t coll, int type, int k,
+                         int epoch) {
+  int in[_blocks(type, 0) * B];
+  int out[_blocks(type, 1) * B];
+  _input(type, k, epoch, in);
+  hpx_process_collective_allreduce_join(coll, element->id, sizeof(in), in);
+  hpx_lco_get_reset(element->f, sizeof(out), out);
+  _check(type, epoch, out);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_PINNED, _join, _join_handler,
+                  HPX_POINTER, HPX_ADDR, HPX_INT, HPX_INT, HPX_INT);
+
+static int _join_block_handler(hpx_addr_t coll, int type, int epoch) {
+  hpx_addr_t block = hpx_thread_current_target();
+  hpx_addr_t and = hpx_lco_and_new(N);
+  for (int k = 0; k < N; ++k) {
+    hpx_addr_t element = hpx_addr_add(block, k * sizeof(element_t), BSIZE);
+    hpx_call(element, _join, and, &coll, &type, &k, &epoch);
+  }
+  hpx_lco_wait(and);
+  hpx_lco_delete_sync(and);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _join_block, _join_block_handler,
+                  HPX_ADDR, HPX_INT, HPX_INT);
+
+static void _run(int type) {
+  hpx_addr_t base = hpx_gas_alloc_cyclic(HPX_LOCALITIES, BSIZE, 0);
+  hpx_addr_t coll = _new(type);
+  test_assert(coll);
+
+  hpx_addr_t and = hpx_lco_and_new(HPX_LOCALITIES);
+  for (int i = 0, e = HPX_LOCALITIES; i < e; ++i) {
+    hpx_addr_t block = hpx_addr_add(base, i * BSIZE, BSIZE);
+    hpx_call(block, _subscribe, and, &coll, &type);
+  }
+  hpx_lco_wait_reset(and);
+  CHECK(hpx_process_collective_allreduce_subscribe_finalize(coll));
+
+  for (int epoch = 0; epoch < I; ++epoch) {
+    for (int i = 0, e = HPX_LOCALITIES; i < e; ++i) {
+      hpx_addr_t block = hpx_addr_add(base, i * BSIZE, BSIZE);
+      hpx_call(block, _join_block, and, &coll, &type, &epoch);
+    }
+    hpx_lco_wait_reset(and);
+  }
+
+  for (int i = 0, e = HPX_LOCALITIES; i < e; ++i) {
+    hpx_addr_t block = hpx_addr_add(base, i * BSIZE, BSIZE);
+    hpx_call(block, _unsubscribe, and, &coll);
+  }
+  hpx_lco_wait(and);
+  hpx_lco_delete(and, HPX_NULL);
+  hpx_process_collective_allreduce_delete(coll);
+  hpx_gas_free(base, HPX_NULL);
+}
+
+static int allgather_handler(void) {
+  printf("Starting the process allgather test\n");
+  _run(ALLGATHER);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, allgather, allgather_handler);
+
+static int alltoall_handler(void) {
+  printf("Starting the process alltoall test\n");
+  _run(ALLTOALL);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, alltoall, alltoall_handler);
+
+static int bcast_handler(void) {
+  printf("Starting the process broadcast test\n");
+  _run(BCAST);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, bcast, bcast_handler);
+
+static int reduce_scatter_handler(void) {
+  printf("Starting the process reduce-scatter test\n");
+  _run(REDUCE_SCATTER);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, reduce_scatter, reduce_scatter_handler);
+
+static int _main_handler(void) {
+  ADD_TEST(allgather, 0);
+  ADD_TEST(alltoall, 0);
+  ADD_TEST(bcast, 0);
+  ADD_TEST(reduce_scatter, 0);
+  hpx_exit(HPX_SUCCESS);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler);
+
+int main(int argc, char *argv[]) {
+  char *args[argc + 2];
+  memcpy(args, argv, argc * sizeof(argv[0]));
+  int n = argc;
+#ifdef COLL_NETWORK
+  args[n++] = "--hpx-coll-network";
+#endif
+  args[n] = NULL;
+
+  char **v = args;
+  if (hpx_init(&n, &v)) {
+    fprintf(stderr, "failed to initialize HPX.\n");
+    return 1;
+  }
+
+  int e = hpx_run(&_main);
+  hpx_finalize();
+  return e;
+}